@@ -107,6 +107,13 @@ mfem::Array<int> MarkedElements(const Vector &e, double threshold)
 
 }  // namespace
 
+struct BaseSolver::AdaptSolutionData
+{
+  std::unique_ptr<mfem::FiniteElementCollection> fec;
+  std::unique_ptr<mfem::ParFiniteElementSpace> fespace;
+  std::vector<std::unique_ptr<mfem::ParGridFunction>> gf;
+};
+
 BaseSolver::BaseSolver(const IoData &iodata, bool root, int size, int num_thread,
                        const char *git_tag)
   : iodata(iodata), post_dir(GetPostDir(iodata.problem.output)), root(root), table(8, 9, 9)
@@ -117,8 +124,10 @@ BaseSolver::BaseSolver(const IoData &iodata, bool root, int size, int num_thread
     std::filesystem::create_directories(post_dir);
   }
 
-  // Initialize simulation metadata for this simulation.
-  if (root && post_dir.length() > 0)
+  // Initialize simulation metadata for this simulation. Metadata is only written by the
+  // root of the world communicator, which is not the only postprocessing root when the
+  // world communicator has been split into groups (parallel-in-frequency driven sweep).
+  if (root && Mpi::Root(Mpi::World()) && post_dir.length() > 0)
   {
     json meta;
     if (git_tag)
@@ -137,6 +146,8 @@ BaseSolver::BaseSolver(const IoData &iodata, bool root, int size, int num_thread
   }
 }
 
+BaseSolver::~BaseSolver() = default;
+
 void BaseSolver::SolveEstimateMarkRefine(std::vector<std::unique_ptr<Mesh>> &mesh) const
 {
   const auto &refinement = iodata.model.refinement;
@@ -192,10 +203,11 @@ void BaseSolver::SolveEstimateMarkRefine(std::vector<std::unique_ptr<Mesh>> &mes
                     ? ", max. size = " + std::to_string(refinement.max_size)
                     : ""));
 
-    // Optionally save off the previous solution.
+    // Optionally save off the previous solution. This synchronizes over the world
+    // communicator, since the mesh communicator may only cover a group of processes.
     if (refinement.save_adapt_iterations)
     {
-      SaveIteration(comm, post_dir, it,
+      SaveIteration(Mpi::World(), post_dir, it,
                     1 + static_cast<int>(std::log10(refinement.max_it)));
     }
 
@@ -225,9 +237,22 @@ void BaseSolver::SolveEstimateMarkRefine(std::vector<std::unique_ptr<Mesh>> &mes
                  final_elem_count - initial_elem_count, initial_elem_count,
                  final_elem_count);
     }
+    UpdateAdaptSolutions(*mesh.back());
 
-    // Optionally rebalance and write the adapted mesh to file.
+    // Optionally rebalance and write the adapted mesh to file. Rebalancing a conforming
+    // mesh constructs a new mesh, to which the stored solutions can not be transferred.
     {
+      if (adapt_data && !mesh.back()->Get().Nonconforming() && Mpi::Size(comm) > 1)
+      {
+        int min_elem, max_elem;
+        min_elem = max_elem = mesh.back()->GetNE();
+        Mpi::GlobalMin(1, &min_elem, comm);
+        Mpi::GlobalMax(1, &max_elem, comm);
+        if (double(max_elem) / min_elem > refinement.maximum_imbalance)
+        {
+          adapt_data.reset();
+        }
+      }
       const auto ratio_pre = mesh::RebalanceMesh(*mesh.back(), iodata);
       if (ratio_pre > refinement.maximum_imbalance)
       {
@@ -241,6 +266,7 @@ void BaseSolver::SolveEstimateMarkRefine(std::vector<std::unique_ptr<Mesh>> &mes
                    ratio_pre, refinement.maximum_imbalance, ratio_post);
       }
       mesh.back()->Update();
+      UpdateAdaptSolutions(*mesh.back());
     }
 
     // Solve + estimate.
@@ -248,6 +274,7 @@ void BaseSolver::SolveEstimateMarkRefine(std::vector<std::unique_ptr<Mesh>> &mes
     std::tie(indicators, ntdof) = Solve(mesh);
     err = indicators.Norml2(comm);
   }
+  adapt_data.reset();
   Mpi::Print("\nCompleted {:d} iteration{} of adaptive mesh refinement (AMR):\n"
              " Indicator norm = {:.3e}, global unknowns = {:d}\n"
              " Max. iterations = {:d}, tol. = {:.3e}{}\n",
@@ -257,6 +284,66 @@ void BaseSolver::SolveEstimateMarkRefine(std::vector<std::unique_ptr<Mesh>> &mes
                   : ""));
 }
 
+void BaseSolver::UpdateAdaptSolutions(const Mesh &mesh) const
+{
+  // Refinement prolongates the stored solutions to the refined mesh, and rebalancing of a
+  // nonconforming mesh redistributes them. The update is a no-op if the mesh has not
+  // changed.
+  if (!adapt_data)
+  {
+    return;
+  }
+  if (adapt_data->fespace->GetParMesh() != &mesh.Get())
+  {
+    adapt_data.reset();
+    return;
+  }
+  adapt_data->fespace->Update();
+  for (auto &gf : adapt_data->gf)
+  {
+    gf->Update();
+  }
+  adapt_data->fespace->UpdatesFinished();
+}
+
+void BaseSolver::SaveAdaptSolutions(FiniteElementSpace &fespace,
+                                    const std::vector<Vector> &X) const
+{
+  // The solutions are stored on a separate finite element space on the same mesh, which is
+  // updated along with the mesh during refinement.
+  if (iodata.model.refinement.max_it <= 0)
+  {
+    return;
+  }
+  adapt_data = std::make_unique<AdaptSolutionData>();
+  adapt_data->fec.reset(mfem::FiniteElementCollection::New(fespace.GetFEColl().Name()));
+  adapt_data->fespace = std::make_unique<mfem::ParFiniteElementSpace>(
+      &fespace.GetParMesh(), adapt_data->fec.get(), fespace.GetVDim(),
+      fespace.Get().GetOrdering());
+  for (const auto &x : X)
+  {
+    auto &gf = adapt_data->gf.emplace_back(
+        std::make_unique<mfem::ParGridFunction>(adapt_data->fespace.get()));
+    gf->SetFromTrueDofs(x);
+  }
+}
+
+bool BaseSolver::LoadAdaptSolution(const FiniteElementSpace &fespace, int i,
+                                   Vector &x) const
+{
+  if (!adapt_data || i >= static_cast<int>(adapt_data->gf.size()) ||
+      adapt_data->fespace->GetParMesh() != &fespace.GetParMesh() ||
+      std::string(adapt_data->fec->Name()) != fespace.GetFEColl().Name() ||
+      adapt_data->fespace->GetTrueVSize() != fespace.GetTrueVSize())
+  {
+    return false;
+  }
+  x.SetSize(fespace.GetTrueVSize());
+  x.UseDevice(true);
+  adapt_data->gf[i]->ParallelProject(x);
+  return true;
+}
+
 void BaseSolver::SaveMetadata(const FiniteElementSpaceHierarchy &fespaces) const
 {
   if (post_dir.length() == 0)
@@ -271,7 +358,7 @@ void BaseSolver::SaveMetadata(const FiniteElementSpaceHierarchy &fespaces) const
   {
     ndofs[l] = fespaces.GetFESpaceAtLevel(l).GlobalTrueVSize();
   }
-  if (root)
+  if (root && Mpi::Root(Mpi::World()))
   {
     json meta = LoadMetadata(post_dir);
     meta["Problem"]["MeshElements"] = ne;
@@ -288,11 +375,12 @@ void BaseSolver::SaveMetadata(const SolverType &ksp) const
   {
     return;
   }
-  if (root)
+  if (root && Mpi::Root(Mpi::World()))
   {
     json meta = LoadMetadata(post_dir);
     meta["LinearSolver"]["TotalSolves"] = ksp.NumTotalMult();
     meta["LinearSolver"]["TotalIts"] = ksp.NumTotalMultIterations();
+    meta["LinearSolver"]["TotalRHS"] = ksp.NumTotalMultRHS();
     WriteMetadata(post_dir, meta);
   }
 }
@@ -303,7 +391,7 @@ void BaseSolver::SaveMetadata(const Timer &timer) const
   {
     return;
   }
-  if (root)
+  if (root && Mpi::Root(Mpi::World()))
   {
     json meta = LoadMetadata(post_dir);
     for (int i = Timer::INIT; i < Timer::NUM_TIMINGS; i++)
@@ -592,6 +680,8 @@ void BaseSolver::PostprocessProbes(const PostOperator &post_op, const std::strin
     return;
   }
   const bool has_imaginary = post_op.HasImag();
+  std::vector<std::complex<double>> vE, vB;
+  post_op.ProbeFields(vE, vB);
   for (int f = 0; f < 2; f++)
   {
     // Probe data is ordered as [Fx1, Fy1, Fz1, Fx2, Fy2, Fz2, ...].
@@ -606,7 +696,7 @@ void BaseSolver::PostprocessProbes(const PostOperator &post_op, const std::strin
     const std::string F = (f == 0) ? "E" : "B";
     const std::string unit = (f == 0) ? "(V/m)" : "(Wb/m²)";
     const auto type = (f == 0) ? IoData::ValueType::FIELD_E : IoData::ValueType::FIELD_B;
-    const auto vF = (f == 0) ? post_op.ProbeEField() : post_op.ProbeBField();
+    const auto &vF = (f == 0) ? vE : vB;
     const int dim = vF.size() / post_op.GetProbes().size();
     std::vector<ProbeData> probe_data;
     probe_data.reserve(post_op.GetProbes().size());
@@ -757,7 +847,6 @@ void BaseSolver::PostprocessFields(const PostOperator &post_op, int step, double
     return;
   }
   post_op.WriteFields(step, time);
-  Mpi::Barrier(post_op.GetComm());
 }
 
 void BaseSolver::PostprocessErrorIndicator(const PostOperator &post_op,
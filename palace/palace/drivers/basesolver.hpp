@@ -8,11 +8,13 @@
 #include <string>
 #include <vector>
 #include <fmt/os.h>
+#include "linalg/vector.hpp"
 
 namespace palace
 {
 
 class ErrorIndicator;
+class FiniteElementSpace;
 class FiniteElementSpaceHierarchy;
 class Mesh;
 class IoData;
@@ -24,6 +26,15 @@ class Timer;
 //
 class BaseSolver
 {
+private:
+  // Solutions of the previous adaptive mesh refinement iteration, which are transferred to
+  // the refined mesh for use as initial guesses in the next solve.
+  struct AdaptSolutionData;
+  mutable std::unique_ptr<AdaptSolutionData> adapt_data;
+
+  // Transfer the stored solutions after the mesh has been refined or rebalanced.
+  void UpdateAdaptSolutions(const Mesh &mesh) const;
+
 protected:
   // Reference to configuration file data (not owned).
   const IoData &iodata;
@@ -72,6 +83,13 @@ protected:
   void PostprocessErrorIndicator(const PostOperator &post_op,
                                  const ErrorIndicator &indicator, bool fields) const;
 
+  // Store the given solutions (true dofs) on the finite element space when using adaptive
+  // mesh refinement, and retrieve the stored solution with the given index after it has
+  // been transferred to the refined mesh. LoadAdaptSolution returns false if there is no
+  // stored solution for the given space.
+  void SaveAdaptSolutions(FiniteElementSpace &fespace, const std::vector<Vector> &X) const;
+  bool LoadAdaptSolution(const FiniteElementSpace &fespace, int i, Vector &x) const;
+
   // Performs a solve using the mesh sequence, then reports error indicators and the number
   // of global true dofs.
   virtual std::pair<ErrorIndicator, long long int>
@@ -80,7 +98,7 @@ protected:
 public:
   BaseSolver(const IoData &iodata, bool root, int size = 0, int num_thread = 0,
              const char *git_tag = nullptr);
-  virtual ~BaseSolver() = default;
+  virtual ~BaseSolver();
 
   // Performs adaptive mesh refinement using the solve-estimate-mark-refine paradigm.
   // Dispatches to the Solve method for the driver specific calculations.
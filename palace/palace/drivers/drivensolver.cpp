@@ -3,6 +3,7 @@
 
 #include "drivensolver.hpp"
 
+#include <algorithm>
 #include <complex>
 #include <mfem.hpp>
 #include "fem/errorindicator.hpp"
@@ -27,6 +28,20 @@ namespace palace
 
 using namespace std::complex_literals;
 
+namespace
+{
+
+// Returns the number of frequency groups and the group index for this process. For a
+// parallel-in-frequency sweep, the world communicator is split into contiguous groups of
+// equal size which each own a copy of the mesh (see main.cpp).
+std::pair<int, int> GetFrequencyGroup(MPI_Comm comm)
+{
+  const int group_size = Mpi::Size(comm);
+  return {Mpi::Size(Mpi::World()) / group_size, Mpi::Rank(Mpi::World()) / group_size};
+}
+
+}  // namespace
+
 std::pair<ErrorIndicator, long long int>
 DrivenSolver::Solve(const std::vector<std::unique_ptr<Mesh>> &mesh) const
 {
@@ -48,8 +63,11 @@ DrivenSolver::Solve(const std::vector<std::unique_ptr<Mesh>> &mesh) const
   SaveMetadata(space_op.GetNDSpaces());
 
   // Frequencies will be sampled uniformly in the frequency domain. Index sets are for
-  // computing things like S-parameters in postprocessing.
-  PostOperator post_op(iodata, space_op, "driven");
+  // computing things like S-parameters in postprocessing. Each frequency group writes its
+  // own field visualization output.
+  const auto [n_group, group] = GetFrequencyGroup(space_op.GetComm());
+  PostOperator post_op(iodata, space_op,
+                       (n_group > 1) ? fmt::format("driven_group{:d}", group) : "driven");
   {
     Mpi::Print("\nComputing {}frequency response for:\n", adaptive ? "adaptive fast " : "");
     bool first = true;
@@ -98,6 +116,11 @@ DrivenSolver::Solve(const std::vector<std::unique_ptr<Mesh>> &mesh) const
   }
   Mpi::Print("\n");
 
+  // Wave port boundary modes are interpolated between anchors placed over the range of the
+  // sweep, when enabled.
+  space_op.GetWavePortOp().SetModeFrequencyRange(
+      omega0, omega0 + (n_step - step0 - 1) * delta_omega);
+
   // Main frequency sweep loop.
   return {adaptive ? SweepAdaptive(space_op, post_op, n_step, step0, omega0, delta_omega)
                    : SweepUniform(space_op, post_op, n_step, step0, omega0, delta_omega),
@@ -113,6 +136,19 @@ ErrorIndicator DrivenSolver::SweepUniform(SpaceOperator &space_op, PostOperator
   // Because the Dirichlet BC is always homogeneous, no special elimination is required on
   // the RHS. Assemble the linear system for the initial frequency (so we can call
   // KspSolver::SetOperators). Compute everything at the first frequency step.
+  // With multiple frequency groups, each group solves for every n_group-th frequency step,
+  // starting from its own offset into the sweep.
+  const auto [n_group, group] = GetFrequencyGroup(space_op.GetComm());
+  MFEM_VERIFY(n_step - step0 >= n_group,
+              "Number of frequency groups exceeds the number of frequency steps!");
+  if (n_group > 1)
+  {
+    Mpi::Print("\nDistributing frequency sweep over {:d} groups of {:d} processes (output "
+               "shown for the first group)\n",
+               n_group, Mpi::Size(space_op.GetComm()));
+  }
+  step0 += group;
+  omega0 += group * delta_omega;
   auto K = space_op.GetStiffnessMatrix<ComplexOperator>(Operator::DIAG_ONE);
   auto C = space_op.GetDampingMatrix<ComplexOperator>(Operator::DIAG_ZERO);
   auto M = space_op.GetMassMatrix<ComplexOperator>(Operator::DIAG_ZERO);
@@ -140,19 +176,133 @@ ErrorIndicator DrivenSolver::SweepUniform(SpaceOperator &space_op, PostOperator
   E = 0.0;
   B = 0.0;
 
+  // For computing the full scattering matrix, each excited port is solved for separately
+  // at each frequency, reusing the same system matrix and preconditioner.
+  std::vector<int> lumped_excitations, wave_excitations;
+  if (iodata.solver.driven.multi_excitation)
+  {
+    for (const auto &[idx, data] : space_op.GetLumpedPortOp())
+    {
+      if (data.excitation)
+      {
+        lumped_excitations.push_back(idx);
+      }
+    }
+    for (const auto &[idx, data] : space_op.GetWavePortOp())
+    {
+      if (data.excitation)
+      {
+        wave_excitations.push_back(idx);
+      }
+    }
+    MFEM_VERIFY(lumped_excitations.empty() || wave_excitations.empty(),
+                "Multiple excitation driven simulations do not support mixed lumped and "
+                "wave port excitations!");
+    MFEM_VERIFY(space_op.GetSurfaceCurrentOp().Size() == 0,
+                "Multiple excitation driven simulations do not support surface current "
+                "excitations!");
+  }
+  const bool multi_excitation = !lumped_excitations.empty() || !wave_excitations.empty();
+  const bool lumped = !lumped_excitations.empty();
+  const auto &excitations = lumped ? lumped_excitations : wave_excitations;
+
+  // Only CG has a block variant for solving the excitations simultaneously. The GMRES-type
+  // solvers solve the excitations one after another, sharing the system matrix and
+  // preconditioner.
+  const bool block_solve =
+      (iodata.solver.linear.ksp_type == config::LinearSolverData::KspType::CG);
+  std::vector<ComplexVector> RHSj(excitations.size()), Ej(excitations.size());
+  for (std::size_t j = 0; j < excitations.size(); j++)
+  {
+    RHSj[j].SetSize(Curl.Width());
+    Ej[j].SetSize(Curl.Width());
+    RHSj[j].UseDevice(true);
+    Ej[j].UseDevice(true);
+    Ej[j] = 0.0;
+  }
+  SMatrixData S;
+  auto SolveExcitations = [&](double omega)
+  {
+    for (std::size_t j = 0; j < excitations.size(); j++)
+    {
+      if (lumped)
+      {
+        space_op.GetLumpedPortExcitationVector(excitations[j], omega, RHSj[j]);
+      }
+      else
+      {
+        space_op.GetWavePortExcitationVector(excitations[j], omega, RHSj[j]);
+      }
+    }
+    Mpi::Print("\n Solving for {:d} {} port excitations{}\n", excitations.size(),
+               lumped ? "lumped" : "wave", block_solve ? " simultaneously" : "");
+    if (block_solve)
+    {
+      ksp.Mult(RHSj, Ej);
+    }
+    else
+    {
+      for (std::size_t j = 0; j < excitations.size(); j++)
+      {
+        ksp.Mult(RHSj[j], Ej[j]);
+      }
+    }
+
+    // Compute the column of the scattering matrix for each excitation.
+    BlockTimer bt0(Timer::POSTPRO);
+    for (std::size_t j = 0; j < excitations.size(); j++)
+    {
+      const int source_idx = excitations[j];
+      RHS += RHSj[j];
+      E += Ej[j];
+      Curl.Mult(Ej[j].Real(), B.Real());
+      Curl.Mult(Ej[j].Imag(), B.Imag());
+      B *= -1.0 / (1i * omega);
+      post_op.SetEGridFunction(Ej[j]);
+      post_op.SetBGridFunction(B);
+      auto &S_j = S[source_idx];
+      if (lumped)
+      {
+        post_op.UpdatePorts(space_op.GetLumpedPortOp(), omega);
+        for (const auto &[idx, data] : space_op.GetLumpedPortOp())
+        {
+          S_j[idx] = post_op.GetSParameter(space_op.GetLumpedPortOp(), idx, source_idx);
+        }
+      }
+      else
+      {
+        post_op.UpdatePorts(space_op.GetWavePortOp(), omega);
+        for (const auto &[idx, data] : space_op.GetWavePortOp())
+        {
+          S_j[idx] = post_op.GetSParameter(space_op.GetWavePortOp(), idx, source_idx);
+        }
+      }
+    }
+  };
+
   // Initialize structures for storing and reducing the results of error estimation.
   TimeDependentFluxErrorEstimator<ComplexVector> estimator(
       space_op.GetMaterialOp(), space_op.GetNDSpaces(), space_op.GetRTSpaces(),
       iodata.solver.linear.estimator_tol, iodata.solver.linear.estimator_max_it, 0,
-      iodata.solver.linear.estimator_mg);
+      iodata.solver.linear.estimator_mg, iodata.solver.linear.estimator_local);
   ErrorIndicator indicator;
 
   // Main frequency sweep loop.
   int step = step0;
   double omega = omega0;
   auto t0 = Timer::Now();
-  while (step < n_step)
+  while (step - group < n_step)
   {
+    if (step >= n_step)
+    {
+      // No frequency left for this group in the final round, but still participate in
+      // the ordered postprocessing of the other groups.
+      for (int g = 0; g < n_group; g++)
+      {
+        Mpi::Barrier(Mpi::World());
+      }
+      break;
+    }
     const double freq = iodata.DimensionalizeValue(IoData::ValueType::FREQUENCY, omega);
     Mpi::Print("\nIt {:d}/{:d}: ω/2π = {:.3e} GHz (elapsed time = {:.2e} s)\n", step + 1,
                n_step, freq, Timer::Duration(Timer::Now() - t0).count());
@@ -169,9 +319,21 @@ ErrorIndicator DrivenSolver::SweepUniform(SpaceOperator &space_op, PostOperator
                                                             omega);
       ksp.SetOperators(*A, *P);
     }
-    space_op.GetExcitationVector(omega, RHS);
-    Mpi::Print("\n");
-    ksp.Mult(RHS, E);
+    if (!multi_excitation)
+    {
+      space_op.GetExcitationVector(omega, RHS);
+      Mpi::Print("\n");
+      ksp.Mult(RHS, E);
+    }
+    else
+    {
+      // Solve for each excited port separately, computing the corresponding column of the
+      // scattering matrix. By superposition, the sum of the solutions is the solution for
+      // all ports excited simultaneously, which is used for the remaining postprocessing.
+      RHS = 0.0;
+      E = 0.0;
+      SolveExcitations(omega);
+    }
 
     // Compute B = -1/(iω) ∇ x E on the true dofs, and set the internal GridFunctions in
     // PostOperator for all postprocessing operations.
@@ -197,16 +359,41 @@ ErrorIndicator DrivenSolver::SweepUniform(SpaceOperator &space_op, PostOperator
     Mpi::Print(" Updating solution error estimates\n");
     estimator.AddErrorIndicator(E, B, E_elec + E_mag, indicator);
 
-    // Postprocess S-parameters and optionally write solution to disk.
-    Postprocess(post_op, space_op.GetLumpedPortOp(), space_op.GetWavePortOp(),
-                space_op.GetSurfaceCurrentOp(), step, omega, E_elec, E_mag,
-                (step == n_step - 1) ? &indicator : nullptr);
+    // Postprocess S-parameters and optionally write solution to disk. Frequency groups
+    // take turns so that the output files are written in order of frequency.
+    for (int g = 0; g < n_group; g++)
+    {
+      if (g == group)
+      {
+        Postprocess(post_op, space_op.GetLumpedPortOp(), space_op.GetWavePortOp(),
+                    space_op.GetSurfaceCurrentOp(), multi_excitation ? &S : nullptr, step,
+                    omega, E_elec, E_mag,
+                    (n_group == 1 && step == n_step - 1) ? &indicator : nullptr);
+      }
+      if (n_group > 1)
+      {
+        Mpi::Barrier(Mpi::World());
+      }
+    }
 
     // Increment frequency.
-    step++;
-    omega += delta_omega;
+    step += n_group;
+    omega += n_group * delta_omega;
   }
   BlockTimer bt0(Timer::POSTPRO);
+  if (n_group > 1)
+  {
+    // Combine the error indicators from all frequency groups, communicating between the
+    // processes with the same rank in each group (which hold the same mesh elements).
+    MPI_Comm inter_comm;
+    MPI_Comm_split(Mpi::World(), Mpi::Rank(space_op.GetComm()), group, &inter_comm);
+    indicator.AddIndicators(inter_comm);
+    MPI_Comm_free(&inter_comm);
+    if (group == 0)
+    {
+      PostprocessErrorIndicator(post_op, indicator, iodata.solver.driven.delta_post > 0);
+    }
+  }
   SaveMetadata(ksp);
   return indicator;
 }
@@ -226,6 +413,11 @@ ErrorIndicator DrivenSolver::SweepAdaptive(SpaceOperator &space_op, PostOperator
   }
   max_size = std::min(max_size, n_step - step0);  // Maximum size dictated by sweep
   int convergence_memory = iodata.solver.driven.adaptive_memory;
+  if (iodata.solver.driven.multi_excitation)
+  {
+    Mpi::Warning("Multiple excitation driven simulations are not supported for adaptive "
+                 "frequency sweep!\nAll ports are excited simultaneously!\n");
+  }
 
   // Allocate negative curl matrix for postprocessing the B-field and vectors for the
   // high-dimensional field solution.
@@ -242,7 +434,7 @@ ErrorIndicator DrivenSolver::SweepAdaptive(SpaceOperator &space_op, PostOperator
   TimeDependentFluxErrorEstimator<ComplexVector> estimator(
       space_op.GetMaterialOp(), space_op.GetNDSpaces(), space_op.GetRTSpaces(),
       iodata.solver.linear.estimator_tol, iodata.solver.linear.estimator_max_it, 0,
-      iodata.solver.linear.estimator_mg);
+      iodata.solver.linear.estimator_mg, iodata.solver.linear.estimator_local);
   ErrorIndicator indicator;
 
   // Configure the PROM operator which performs the parameter space sampling and basis
@@ -262,76 +454,160 @@ ErrorIndicator DrivenSolver::SweepAdaptive(SpaceOperator &space_op, PostOperator
   // range of interest. Each call for an HDM solution adds the frequency sample to P_S and
   // removes it from P \ P_S. Timing for the HDM construction and solve is handled inside
   // of the RomOperator.
-  auto UpdatePROM = [&](double omega)
+  auto UpdatePROM = [&](const std::vector<double> &omega,
+                        const std::vector<const ComplexVector *> &u)
   {
-    // Add the HDM solution to the PROM reduced basis.
-    prom_op.UpdatePROM(omega, E);
+    // Add the HDM solution(s) to the PROM reduced basis.
+    prom_op.UpdatePROM(omega, u);
 
     // Compute B = -1/(iω) ∇ x E on the true dofs, and set the internal GridFunctions in
     // PostOperator for energy postprocessing and error estimation.
     BlockTimer bt0(Timer::POSTPRO);
-    Curl.Mult(E.Real(), B.Real());
-    Curl.Mult(E.Imag(), B.Imag());
-    B *= -1.0 / (1i * omega);
-    post_op.SetEGridFunction(E, false);
-    post_op.SetBGridFunction(B, false);
-    const double E_elec = post_op.GetEFieldEnergy();
-    const double E_mag = post_op.GetHFieldEnergy();
-    estimator.AddErrorIndicator(E, B, E_elec + E_mag, indicator);
+    for (std::size_t k = 0; k < u.size(); k++)
+    {
+      Curl.Mult(u[k]->Real(), B.Real());
+      Curl.Mult(u[k]->Imag(), B.Imag());
+      B *= -1.0 / (1i * omega[k]);
+      post_op.SetEGridFunction(*u[k], false);
+      post_op.SetBGridFunction(B, false);
+      const double E_elec = post_op.GetEFieldEnergy();
+      const double E_mag = post_op.GetHFieldEnergy();
+      estimator.AddErrorIndicator(*u[k], B, E_elec + E_mag, indicator);
+    }
   };
-  prom_op.SolveHDM(omega0, E);
-  UpdatePROM(omega0);
-  prom_op.SolveHDM(omega0 + (n_step - step0 - 1) * delta_omega, E);
-  UpdatePROM(omega0 + (n_step - step0 - 1) * delta_omega);
+  // Initialize the PROM from a previously saved checkpoint if one exists for this problem,
+  // in which case only the sweep endpoints outside of the previously sampled frequency
+  // range need to be sampled.
+  const auto &checkpoint = iodata.solver.driven.adaptive_checkpoint;
+  const bool loaded = !checkpoint.empty() && prom_op.LoadCheckpoint(checkpoint, indicator);
+  const bool online_only = loaded && iodata.solver.driven.adaptive_online_only;
+  if (loaded)
+  {
+    Mpi::Print(" Loaded PROM checkpoint with {:d} frequency samples (n = {:d}) from {}\n",
+               prom_op.GetSamplePoints().size(), prom_op.GetReducedDimension(),
+               checkpoint);
+  }
+  else if (!checkpoint.empty())
+  {
+    Mpi::Print(" No matching PROM checkpoint found in {}\n", checkpoint);
+  }
+  for (double omega : {omega0, omega0 + (n_step - step0 - 1) * delta_omega})
+  {
+    const auto &z = prom_op.GetSamplePoints();
+    if (!z.empty() && omega >= *std::min_element(z.begin(), z.end()) &&
+        omega <= *std::max_element(z.begin(), z.end()))
+    {
+      continue;
+    }
+    if (online_only)
+    {
+      Mpi::Warning("Frequency sweep range extends outside of the range sampled by the "
+                   "loaded PROM checkpoint!\n");
+      break;
+    }
+    prom_op.SolveHDM(omega, E);
+    UpdatePROM({omega}, {&E});
+  }
 
   // Greedy procedure for basis construction (offline phase). Basis is initialized with
-  // solutions at frequency sweep endpoints.
-  int it = 2, it0 = it, memory = 0;
-  std::vector<double> max_errors = {0.0, 0.0};
-  while (true)
-  {
-    // Compute the location of the maximum error in parameter domain (bounded by the
-    // previous samples).
-    double omega_star = prom_op.FindMaxError()[0];
-
-    // Compute the actual solution error at the given parameter point.
-    prom_op.SolveHDM(omega_star, E);
-    prom_op.SolvePROM(omega_star, Eh);
-    linalg::AXPY(-1.0, E, Eh);
-    max_errors.push_back(linalg::Norml2(space_op.GetComm(), Eh) /
-                         linalg::Norml2(space_op.GetComm(), E));
-    if (max_errors.back() < offline_tol)
-    {
-      if (++memory == convergence_memory)
+  // solutions at frequency sweep endpoints. Each iteration samples a batch of up to
+  // adaptive_batch_size points at distinct local maxima of the error estimate, which are
+  // added to the basis together. The HDM solves for a batch stop once the error estimate
+  // has converged.
+  const int batch_size = std::max(iodata.solver.driven.adaptive_batch_size, 1);
+  std::vector<ComplexVector> Eb;
+  int it = static_cast<int>(prom_op.GetSamplePoints().size()), it0 = it, memory = 0;
+  std::vector<double> max_errors(it, 0.0);
+  while (!online_only && it <= max_size)
+  {
+    // Compute the location(s) of the maximum error in parameter domain (bounded by the
+    // previous samples). A loaded PROM may already have the maximum number of samples, and
+    // no candidate points terminates the sampling.
+    const auto omega_star = prom_op.FindMaxError(std::min(batch_size, max_size - it + 1));
+    if (omega_star.empty())
+    {
+      break;
+    }
+
+    // Compute the actual solution errors at the given parameter points.
+    if (Eb.size() < omega_star.size())
+    {
+      Eb.resize(omega_star.size());
+      for (auto &Ek : Eb)
+      {
+        Ek.SetSize(Curl.Width());
+        Ek.UseDevice(true);
+        Ek = 0.0;
+      }
+    }
+    std::vector<double> omega_add;
+    std::vector<const ComplexVector *> E_add;
+    bool converged = false;
+    for (std::size_t k = 0; k < omega_star.size(); k++)
+    {
+      prom_op.SolveHDM(omega_star[k], Eb[k]);
+      prom_op.SolvePROM(omega_star[k], Eh);
+      linalg::AXPY(-1.0, Eb[k], Eh);
+      max_errors.push_back(linalg::Norml2(space_op.GetComm(), Eh) /
+                           linalg::Norml2(space_op.GetComm(), Eb[k]));
+      if (max_errors.back() < offline_tol)
+      {
+        if (++memory == convergence_memory)
+        {
+          converged = true;
+          break;
+        }
+      }
+      else
+      {
+        memory = 0;
+      }
+      if (it + static_cast<int>(omega_add.size()) >= max_size)
       {
         break;
       }
+
+      // Sample HDM and add solution to basis.
+      Mpi::Print("\nGreedy iteration {:d} (n = {:d}): ω* = {:.3e} GHz ({:.3e}), error = "
+                 "{:.3e}{}\n",
+                 it - it0 + static_cast<int>(omega_add.size()) + 1,
+                 prom_op.GetReducedDimension(),
+                 omega_star[k] * f0, omega_star[k], max_errors.back(),
+                 (memory == 0)
+                     ? ""
+                     : fmt::format(", memory = {:d}/{:d}", memory, convergence_memory));
+      omega_add.push_back(omega_star[k]);
+      E_add.push_back(&Eb[k]);
     }
-    else
+    if (!omega_add.empty())
     {
-      memory = 0;
+      UpdatePROM(omega_add, E_add);
+      it += static_cast<int>(omega_add.size());
     }
-    if (it == max_size)
+    if (converged || omega_add.size() < omega_star.size())
     {
       break;
     }
-
-    // Sample HDM and add solution to basis.
-    Mpi::Print("\nGreedy iteration {:d} (n = {:d}): ω* = {:.3e} GHz ({:.3e}), error = "
-               "{:.3e}{}\n",
-               it - it0 + 1, prom_op.GetReducedDimension(), omega_star * f0, omega_star,
-               max_errors.back(),
-               (memory == 0)
-                   ? ""
-                   : fmt::format(", memory = {:d}/{:d}", memory, convergence_memory));
-    UpdatePROM(omega_star);
-    it++;
   }
-  Mpi::Print("\nAdaptive sampling{} {:d} frequency samples:\n"
-             " n = {:d}, error = {:.3e}, tol = {:.3e}, memory = {:d}/{:d}\n",
-             (it == max_size) ? " reached maximum" : " converged with", it,
-             prom_op.GetReducedDimension(), max_errors.back(), offline_tol, memory,
-             convergence_memory);
+  if (online_only)
+  {
+    Mpi::Print("\nSkipping adaptive sampling for loaded PROM with {:d} frequency samples:\n"
+               " n = {:d}\n",
+               it, prom_op.GetReducedDimension());
+  }
+  else
+  {
+    Mpi::Print("\nAdaptive sampling{} {:d} frequency samples:\n"
+               " n = {:d}, error = {:.3e}, tol = {:.3e}, memory = {:d}/{:d}\n",
+               (it >= max_size) ? " reached maximum" : " converged with", it,
+               prom_op.GetReducedDimension(), max_errors.back(), offline_tol, memory,
+               convergence_memory);
+    if (!checkpoint.empty())
+    {
+      prom_op.SaveCheckpoint(checkpoint, indicator);
+      Mpi::Print(" Saved PROM checkpoint to {}\n", checkpoint);
+    }
+  }
   utils::PrettyPrint(prom_op.GetSamplePoints(), f0, " Sampled frequencies (GHz):");
   utils::PrettyPrint(max_errors, 1.0, " Sample errors:");
   Mpi::Print(" Total offline phase elapsed time: {:.2e} s\n",
@@ -340,6 +616,12 @@ ErrorIndicator DrivenSolver::SweepAdaptive(SpaceOperator &space_op, PostOperator
   // XX TODO: Add output of eigenvalue estimates from the PROM system (and nonlinear EVP in
   //          the general case with wave ports, etc.?)
 
+  // Project the postprocessing quantities onto the reduced-order basis, so that the online
+  // phase only expands the PROM solution into the high-dimensional space for steps which
+  // write fields to disk (or when some postprocessing quantity requires the full fields).
+  const bool reduced_post = prom_op.InitializePostOperator(post_op);
+  Eigen::VectorXcd y;
+
   // Main fast frequency sweep loop (online phase).
   Mpi::Print("\nBeginning fast frequency sweep online phase\n");
   space_op.GetWavePortOp().SetSuppressOutput(false);  // Disable output suppression
@@ -352,21 +634,41 @@ ErrorIndicator DrivenSolver::SweepAdaptive(SpaceOperator &space_op, PostOperator
                n_step, freq, Timer::Duration(Timer::Now() - t0).count());
 
     // Assemble and solve the PROM linear system.
-    prom_op.SolvePROM(omega, E);
+    const bool expand =
+        !reduced_post || (iodata.solver.driven.delta_post > 0 &&
+                          step % iodata.solver.driven.delta_post == 0);
+    if (expand)
+    {
+      prom_op.SolvePROM(omega, E);
+    }
+    else
+    {
+      prom_op.SolvePROM(omega, y);
+    }
     Mpi::Print("\n");
 
     // Compute B = -1/(iω) ∇ x E on the true dofs, and set the internal GridFunctions in
-    // PostOperator for all postprocessing operations.
+    // PostOperator for all postprocessing operations. Otherwise, the postprocessing is
+    // evaluated from the PROM solution coefficients (the basis is orthonormal, so ||E|| =
+    // ||y||).
     BlockTimer bt0(Timer::POSTPRO);
-    Curl.Mult(E.Real(), B.Real());
-    Curl.Mult(E.Imag(), B.Imag());
-    B *= -1.0 / (1i * omega);
-    post_op.SetEGridFunction(E);
-    post_op.SetBGridFunction(B);
+    if (expand)
+    {
+      Curl.Mult(E.Real(), B.Real());
+      Curl.Mult(E.Imag(), B.Imag());
+      B *= -1.0 / (1i * omega);
+      post_op.SetEGridFunction(E);
+      post_op.SetBGridFunction(B);
+    }
+    else
+    {
+      post_op.SetReducedSolution(y, omega);
+    }
     post_op.UpdatePorts(space_op.GetLumpedPortOp(), space_op.GetWavePortOp(), omega);
     const double E_elec = post_op.GetEFieldEnergy();
     const double E_mag = post_op.GetHFieldEnergy();
-    Mpi::Print(" Sol. ||E|| = {:.6e}\n", linalg::Norml2(space_op.GetComm(), E));
+    Mpi::Print(" Sol. ||E|| = {:.6e}\n",
+               expand ? linalg::Norml2(space_op.GetComm(), E) : y.norm());
     {
       const double J = iodata.DimensionalizeValue(IoData::ValueType::ENERGY, 1.0);
       Mpi::Print(" Field energy E ({:.3e} J) + H ({:.3e} J) = {:.3e} J\n", E_elec * J,
@@ -375,7 +677,7 @@ ErrorIndicator DrivenSolver::SweepAdaptive(SpaceOperator &space_op, PostOperator
 
     // Postprocess S-parameters and optionally write solution to disk.
     Postprocess(post_op, space_op.GetLumpedPortOp(), space_op.GetWavePortOp(),
-                space_op.GetSurfaceCurrentOp(), step, omega, E_elec, E_mag,
+                space_op.GetSurfaceCurrentOp(), nullptr, step, omega, E_elec, E_mag,
                 (step == n_step - 1) ? &indicator : nullptr);
 
     // Increment frequency.
@@ -405,8 +707,9 @@ int DrivenSolver::GetNumSteps(double start, double end, double delta) const
 void DrivenSolver::Postprocess(const PostOperator &post_op,
                                const LumpedPortOperator &lumped_port_op,
                                const WavePortOperator &wave_port_op,
-                               const SurfaceCurrentOperator &surf_j_op, int step,
-                               double omega, double E_elec, double E_mag,
+                               const SurfaceCurrentOperator &surf_j_op,
+                               const SMatrixData *S, int step, double omega,
+                               double E_elec, double E_mag,
                                const ErrorIndicator *indicator) const
 {
   // The internal GridFunctions for PostOperator have already been set from the E and B
@@ -418,7 +721,7 @@ void DrivenSolver::Postprocess(const PostOperator &post_op,
   PostprocessPorts(post_op, lumped_port_op, step, omega);
   if (surf_j_op.Size() == 0)
   {
-    PostprocessSParameters(post_op, lumped_port_op, wave_port_op, step, omega);
+    PostprocessSParameters(post_op, lumped_port_op, wave_port_op, S, step, omega);
   }
   PostprocessDomains(post_op, "f (GHz)", step, freq, E_elec, E_mag, E_cap, E_ind);
   PostprocessSurfaces(post_op, "f (GHz)", step, freq, E_elec + E_cap, E_mag + E_ind);
@@ -455,6 +758,7 @@ struct PortVIData
 struct PortSData
 {
   const int idx;                    // Port index
+  const int src_idx;                // Excited port index
   const std::complex<double> S_ij;  // Scattering parameter
 };
 
@@ -650,72 +954,91 @@ void DrivenSolver::PostprocessPorts(const PostOperator &post_op,
 
 void DrivenSolver::PostprocessSParameters(const PostOperator &post_op,
                                           const LumpedPortOperator &lumped_port_op,
-                                          const WavePortOperator &wave_port_op, int step,
+                                          const WavePortOperator &wave_port_op,
+                                          const SMatrixData *S, int step,
                                           double omega) const
 {
   // Postprocess S-parameters. This computes a column of the S matrix corresponding to the
   // excited port index specified in the configuration file, storing |S_ij| and arg
   // (S_ij) in dB and degrees, respectively. S-parameter output is only available for a
-  // single lumped or wave port excitation.
-  bool src_lumped_port = false;
-  bool src_wave_port = false;
-  int source_idx = -1;
-  for (const auto &[idx, data] : lumped_port_op)
+  // single lumped or wave port excitation, unless the columns for multiple excitations
+  // have been computed from separate solves.
+  std::vector<PortSData> port_data;
+  if (S)
   {
-    if (data.excitation)
+    for (const auto &[source_idx, S_j] : *S)
     {
-      if (src_lumped_port || src_wave_port)
+      for (const auto &[idx, S_ij] : S_j)
       {
-        return;
+        port_data.push_back({idx, source_idx, S_ij});
       }
-      src_lumped_port = true;
-      source_idx = idx;
     }
   }
-  for (const auto &[idx, data] : wave_port_op)
+  else
   {
-    if (data.excitation)
+    bool src_lumped_port = false;
+    bool src_wave_port = false;
+    int source_idx = -1;
+    for (const auto &[idx, data] : lumped_port_op)
     {
-      if (src_lumped_port || src_wave_port)
+      if (data.excitation)
       {
-        return;
+        if (src_lumped_port || src_wave_port)
+        {
+          return;
+        }
+        src_lumped_port = true;
+        source_idx = idx;
       }
-      src_wave_port = true;
-      source_idx = idx;
     }
-  }
-  if (!src_lumped_port && !src_wave_port)
-  {
-    return;
-  }
-  std::vector<PortSData> port_data;
-  port_data.reserve(src_lumped_port ? lumped_port_op.Size() : wave_port_op.Size());
-  if (src_lumped_port)
-  {
-    // Compute lumped port S-parameters.
-    for (const auto &[idx, data] : lumped_port_op)
+    for (const auto &[idx, data] : wave_port_op)
     {
-      const std::complex<double> S_ij =
-          post_op.GetSParameter(lumped_port_op, idx, source_idx);
-      port_data.push_back({idx, S_ij});
+      if (data.excitation)
+      {
+        if (src_lumped_port || src_wave_port)
+        {
+          return;
+        }
+        src_wave_port = true;
+        source_idx = idx;
+      }
     }
-  }
-  else  // src_wave_port
-  {
-    // Compute wave port S-parameters.
-    for (const auto &[idx, data] : wave_port_op)
+    if (!src_lumped_port && !src_wave_port)
+    {
+      return;
+    }
+    port_data.reserve(src_lumped_port ? lumped_port_op.Size() : wave_port_op.Size());
+    if (src_lumped_port)
     {
-      const std::complex<double> S_ij =
-          post_op.GetSParameter(wave_port_op, idx, source_idx);
-      port_data.push_back({idx, S_ij});
+      // Compute lumped port S-parameters.
+      for (const auto &[idx, data] : lumped_port_op)
+      {
+        const std::complex<double> S_ij =
+            post_op.GetSParameter(lumped_port_op, idx, source_idx);
+        port_data.push_back({idx, source_idx, S_ij});
+      }
+    }
+    else  // src_wave_port
+    {
+      // Compute wave port S-parameters.
+      for (const auto &[idx, data] : wave_port_op)
+      {
+        const std::complex<double> S_ij =
+            post_op.GetSParameter(wave_port_op, idx, source_idx);
+        port_data.push_back({idx, source_idx, S_ij});
+      }
     }
   }
+  if (port_data.empty())
+  {
+    return;
+  }
 
   // Print table to stdout.
   for (const auto &data : port_data)
   {
     std::string str =
-        "S[" + std::to_string(data.idx) + "][" + std::to_string(source_idx) + "]";
+        "S[" + std::to_string(data.idx) + "][" + std::to_string(data.src_idx) + "]";
     // clang-format off
     Mpi::Print(" {} = {:+.3e}{:+.3e}i, |{}| = {:+.3e}, arg({}) = {:+.3e}\n",
                str, data.S_ij.real(), data.S_ij.imag(),
@@ -735,12 +1058,12 @@ void DrivenSolver::PostprocessSParameters(const PostOperator &post_op,
       for (const auto &data : port_data)
       {
         std::string str =
-            "S[" + std::to_string(data.idx) + "][" + std::to_string(source_idx) + "]";
+            "S[" + std::to_string(data.idx) + "][" + std::to_string(data.src_idx) + "]";
         // clang-format off
         output.print("{:>{}s},{:>{}s}{}",
                      "|" + str + "| (dB)", table.w,
                      "arg(" + str + ") (deg.)", table.w,
-                     (data.idx == port_data.back().idx) ? "" : ",");
+                     (&data == &port_data.back()) ? "" : ",");
         // clang-format on
       }
       output.print("\n");
@@ -755,7 +1078,7 @@ void DrivenSolver::PostprocessSParameters(const PostOperator &post_op,
       output.print("{:>+{}.{}e},{:>+{}.{}e}{}",
                    20.0 * std::log10(std::abs(data.S_ij)), table.w, table.p,
                    std::arg(data.S_ij) * 180.0 / M_PI, table.w, table.p,
-                   (data.idx == port_data.back().idx) ? "" : ",");
+                   (&data == &port_data.back()) ? "" : ",");
       // clang-format on
     }
     output.print("\n");
@@ -4,6 +4,8 @@
 #ifndef PALACE_DRIVERS_DRIVEN_SOLVER_HPP
 #define PALACE_DRIVERS_DRIVEN_SOLVER_HPP
 
+#include <complex>
+#include <map>
 #include <memory>
 #include <vector>
 #include "drivers/basesolver.hpp"
@@ -25,6 +27,10 @@ class WavePortOperator;
 class DrivenSolver : public BaseSolver
 {
 private:
+  // Scattering parameters S_ij for each excited port j (outer key) and port i (inner key),
+  // when computed from separate solves for each port excitation.
+  using SMatrixData = std::map<int, std::map<int, std::complex<double>>>;
+
   int GetNumSteps(double start, double end, double delta) const;
 
   ErrorIndicator SweepUniform(SpaceOperator &space_op, PostOperator &post_op, int n_step,
@@ -35,8 +41,9 @@ private:
 
   void Postprocess(const PostOperator &post_op, const LumpedPortOperator &lumped_port_op,
                    const WavePortOperator &wave_port_op,
-                   const SurfaceCurrentOperator &surf_j_op, int step, double omega,
-                   double E_elec, double E_mag, const ErrorIndicator *indicator) const;
+                   const SurfaceCurrentOperator &surf_j_op, const SMatrixData *S,
+                   int step, double omega, double E_elec, double E_mag,
+                   const ErrorIndicator *indicator) const;
 
   void PostprocessCurrents(const PostOperator &post_op,
                            const SurfaceCurrentOperator &surf_j_op, int step,
@@ -48,8 +55,8 @@ private:
 
   void PostprocessSParameters(const PostOperator &post_op,
                               const LumpedPortOperator &lumped_port_op,
-                              const WavePortOperator &wave_port_op, int step,
-                              double omega) const;
+                              const WavePortOperator &wave_port_op,
+                              const SMatrixData *S, int step, double omega) const;
 
   std::pair<ErrorIndicator, long long int>
   Solve(const std::vector<std::unique_ptr<Mesh>> &mesh) const override;
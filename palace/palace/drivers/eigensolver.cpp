@@ -3,6 +3,7 @@
 
 #include "eigensolver.hpp"
 
+#include <algorithm>
 #include <mfem.hpp>
 #include "fem/errorindicator.hpp"
 #include "fem/mesh.hpp"
@@ -48,7 +49,6 @@ EigenSolver::Solve(const std::vector<std::unique_ptr<Mesh>> &mesh) const
   // Define and configure the eigensolver to solve the eigenvalue problem:
   //         (K + λ C + λ² M) u = 0    or    K u = -λ² M u
   // with λ = iω. In general, the system matrices are complex and symmetric.
-  std::unique_ptr<EigenvalueSolver> eigen;
   config::EigenSolverData::Type type = iodata.solver.eigenmode.type;
 #if defined(PALACE_WITH_ARPACK) && defined(PALACE_WITH_SLEPC)
   if (type == config::EigenSolverData::Type::DEFAULT)
@@ -70,237 +70,390 @@ EigenSolver::Solve(const std::vector<std::unique_ptr<Mesh>> &mesh) const
 #else
 #error "Eigenmode solver requires building with ARPACK or SLEPc!"
 #endif
-  if (type == config::EigenSolverData::Type::ARPACK)
+  auto ConfigureEigenSolver = [&](int n_modes)
   {
-#if defined(PALACE_WITH_ARPACK)
-    Mpi::Print("\nConfiguring ARPACK eigenvalue solver:\n");
-    if (C)
+    std::unique_ptr<EigenvalueSolver> eigen;
+    if (type == config::EigenSolverData::Type::ARPACK)
     {
-      eigen = std::make_unique<arpack::ArpackPEPSolver>(space_op.GetComm(),
-                                                        iodata.problem.verbose);
+#if defined(PALACE_WITH_ARPACK)
+      Mpi::Print("\nConfiguring ARPACK eigenvalue solver:\n");
+      if (C)
+      {
+        eigen = std::make_unique<arpack::ArpackPEPSolver>(space_op.GetComm(),
+                                                          iodata.problem.verbose);
+      }
+      else
+      {
+        eigen = std::make_unique<arpack::ArpackEPSSolver>(space_op.GetComm(),
+                                                          iodata.problem.verbose);
+      }
+#endif
     }
-    else
+    else  // config::EigenSolverData::Type::SLEPC
     {
-      eigen = std::make_unique<arpack::ArpackEPSSolver>(space_op.GetComm(),
-                                                        iodata.problem.verbose);
-    }
-#endif
-  }
-  else  // config::EigenSolverData::Type::SLEPC
-  {
 #if defined(PALACE_WITH_SLEPC)
-    Mpi::Print("\nConfiguring SLEPc eigenvalue solver:\n");
-    std::unique_ptr<slepc::SlepcEigenvalueSolver> slepc;
-    if (C)
-    {
-      if (!iodata.solver.eigenmode.pep_linear)
+      Mpi::Print("\nConfiguring SLEPc eigenvalue solver:\n");
+      std::unique_ptr<slepc::SlepcEigenvalueSolver> slepc;
+      if (C)
       {
-        slepc = std::make_unique<slepc::SlepcPEPSolver>(space_op.GetComm(),
-                                                        iodata.problem.verbose);
-        slepc->SetType(slepc::SlepcEigenvalueSolver::Type::TOAR);
+        if (!iodata.solver.eigenmode.pep_linear)
+        {
+          slepc = std::make_unique<slepc::SlepcPEPSolver>(space_op.GetComm(),
+                                                          iodata.problem.verbose);
+          slepc->SetType(slepc::SlepcEigenvalueSolver::Type::TOAR);
+        }
+        else
+        {
+          slepc = std::make_unique<slepc::SlepcPEPLinearSolver>(space_op.GetComm(),
+                                                                iodata.problem.verbose);
+          slepc->SetType(slepc::SlepcEigenvalueSolver::Type::KRYLOVSCHUR);
+        }
       }
       else
       {
-        slepc = std::make_unique<slepc::SlepcPEPLinearSolver>(space_op.GetComm(),
-                                                              iodata.problem.verbose);
+        slepc = std::make_unique<slepc::SlepcEPSSolver>(space_op.GetComm(),
+                                                        iodata.problem.verbose);
         slepc->SetType(slepc::SlepcEigenvalueSolver::Type::KRYLOVSCHUR);
       }
+      slepc->SetProblemType(slepc::SlepcEigenvalueSolver::ProblemType::GEN_NON_HERMITIAN);
+      slepc->SetOrthogonalization(
+          iodata.solver.linear.gs_orthog_type == config::LinearSolverData::OrthogType::MGS,
+          iodata.solver.linear.gs_orthog_type ==
+                  config::LinearSolverData::OrthogType::CGS2 ||
+              iodata.solver.linear.gs_orthog_type ==
+                  config::LinearSolverData::OrthogType::DCGS2);
+      eigen = std::move(slepc);
+#endif
+    }
+    EigenvalueSolver::ScaleType scale = iodata.solver.eigenmode.scale
+                                            ? EigenvalueSolver::ScaleType::NORM_2
+                                            : EigenvalueSolver::ScaleType::NONE;
+    if (C)
+    {
+      eigen->SetOperators(*K, *C, *M, scale);
     }
     else
     {
-      slepc = std::make_unique<slepc::SlepcEPSSolver>(space_op.GetComm(),
-                                                      iodata.problem.verbose);
-      slepc->SetType(slepc::SlepcEigenvalueSolver::Type::KRYLOVSCHUR);
+      eigen->SetOperators(*K, *M, scale);
     }
-    slepc->SetProblemType(slepc::SlepcEigenvalueSolver::ProblemType::GEN_NON_HERMITIAN);
-    slepc->SetOrthogonalization(
-        iodata.solver.linear.gs_orthog_type == config::LinearSolverData::OrthogType::MGS,
-        iodata.solver.linear.gs_orthog_type == config::LinearSolverData::OrthogType::CGS2);
-    eigen = std::move(slepc);
-#endif
-  }
-  EigenvalueSolver::ScaleType scale = iodata.solver.eigenmode.scale
-                                          ? EigenvalueSolver::ScaleType::NORM_2
-                                          : EigenvalueSolver::ScaleType::NONE;
-  if (C)
-  {
-    eigen->SetOperators(*K, *C, *M, scale);
-  }
-  else
+    eigen->SetNumModes(n_modes, iodata.solver.eigenmode.max_size);
+    eigen->SetTol(iodata.solver.eigenmode.tol);
+    eigen->SetMaxIter(iodata.solver.eigenmode.max_it);
+    Mpi::Print(" Scaling γ = {:.3e}, δ = {:.3e}\n", eigen->GetScalingGamma(),
+               eigen->GetScalingDelta());
+    return eigen;
+  };
+
+  // With spectrum slicing, the frequency band [target, target_upper] is split into
+  // intervals of equal width, each solved for separately. Only the converged modes with
+  // frequencies inside the interval of each slice are kept, and modes found by more than
+  // one slice are removed, so each slice requires a much smaller subspace than a single
+  // solve for all modes in the band. ARPACK selects the eigenvalues above the shift, so the
+  // shift is placed at the lower end of each interval, while SLEPc selects the eigenvalues
+  // closest to the shift on either side, so the shift is placed at the center. Without
+  // slicing, all converged modes closest to the target are kept.
+  const int n_slice = iodata.solver.eigenmode.n_slice;
+  const double target = iodata.solver.eigenmode.target;
+  const double slice_width =
+      (n_slice > 1) ? (iodata.solver.eigenmode.target_upper - target) / n_slice : 0.0;
+  const int n_slice_modes =
+      (n_slice > 1) ? (iodata.solver.eigenmode.n + n_slice - 1) / n_slice
+                    : iodata.solver.eigenmode.n;
+  const double dedup_tol = std::max(1.0e2 * iodata.solver.eigenmode.tol, 1.0e-10);
+
+  // Storage for the converged modes of all slices, and objects shared by all slices. The
+  // eigenvectors are only copied with slicing, otherwise they are accessed from the
+  // eigenvalue solver for the single slice. The M-inner product matrix just references the
+  // real SPD part of the mass matrix (no copy is performed) and is used for
+  // orthogonalization of the eigenvalue subspace if desired, as well as for normalizing the
+  // computed modes.
+  struct ModeData
   {
-    eigen->SetOperators(*K, *M, scale);
-  }
-  eigen->SetNumModes(iodata.solver.eigenmode.n, iodata.solver.eigenmode.max_size);
-  eigen->SetTol(iodata.solver.eigenmode.tol);
-  eigen->SetMaxIter(iodata.solver.eigenmode.max_it);
-  Mpi::Print(" Scaling γ = {:.3e}, δ = {:.3e}\n", eigen->GetScalingGamma(),
-             eigen->GetScalingDelta());
-
-  // If desired, use an M-inner product for orthogonalizing the eigenvalue subspace. The
-  // constructed matrix just references the real SPD part of the mass matrix (no copy is
-  // performed). Boundary conditions don't need to be eliminated here.
+    std::complex<double> omega;
+    double error_bkwd, error_abs;
+    int idx;
+    ComplexVector E;
+  };
+  std::vector<ModeData> modes;
+  std::unique_ptr<EigenvalueSolver> eigen;
   std::unique_ptr<Operator> KM;
-  if (iodata.solver.eigenmode.mass_orthog)
+  std::unique_ptr<DivFreeSolver<ComplexVector>> divfree;
+  std::unique_ptr<ComplexKspSolver> ksp;
+  ComplexVector v0, ME;
+  for (int slice = 0; slice < n_slice; slice++)
   {
-    Mpi::Print(" Basis uses M-inner product\n");
-    KM = space_op.GetInnerProductMatrix(0.0, 1.0, nullptr, M.get());
-    eigen->SetBMat(*KM);
+    const double omega_min = target + slice * slice_width,
+                 omega_max = target + (slice + 1) * slice_width;
+    const double sigma = (n_slice > 1 && type != config::EigenSolverData::Type::ARPACK)
+                             ? 0.5 * (omega_min + omega_max)
+                             : omega_min;
+    if (n_slice > 1)
+    {
+      Mpi::Print("\nSpectrum slice {:d}/{:d}: {:.3e} GHz to {:.3e} GHz\n", slice + 1,
+                 n_slice,
+                 iodata.DimensionalizeValue(IoData::ValueType::FREQUENCY, omega_min),
+                 iodata.DimensionalizeValue(IoData::ValueType::FREQUENCY, omega_max));
+    }
+    eigen = ConfigureEigenSolver(n_slice_modes);
+    if (!KM)
+    {
+      KM = space_op.GetInnerProductMatrix(0.0, 1.0, nullptr, M.get());
+    }
 
-    // Mpi::Print(" Basis uses (K + M)-inner product\n");
-    // KM = space_op.GetInnerProductMatrix(1.0, 1.0, K.get(), M.get());
-    // eigen->SetBMat(*KM);
-  }
+    // If desired, use an M-inner product for orthogonalizing the eigenvalue subspace.
+    if (iodata.solver.eigenmode.mass_orthog)
+    {
+      Mpi::Print(" Basis uses M-inner product\n");
+      eigen->SetBMat(*KM);
+    }
 
-  // Construct a divergence-free projector so the eigenvalue solve is performed in the space
-  // orthogonal to the zero eigenvalues of the stiffness matrix.
-  std::unique_ptr<DivFreeSolver<ComplexVector>> divfree;
-  if (iodata.solver.linear.divfree_max_it > 0)
-  {
-    Mpi::Print(" Configuring divergence-free projection\n");
-    constexpr int divfree_verbose = 0;
-    divfree = std::make_unique<DivFreeSolver<ComplexVector>>(
-        space_op.GetMaterialOp(), space_op.GetNDSpace(), space_op.GetH1Spaces(),
-        space_op.GetAuxBdrTDofLists(), iodata.solver.linear.divfree_tol,
-        iodata.solver.linear.divfree_max_it, divfree_verbose);
-    eigen->SetDivFreeProjector(*divfree);
-  }
+    // Construct a divergence-free projector so the eigenvalue solve is performed in the
+    // space orthogonal to the zero eigenvalues of the stiffness matrix.
+    if (iodata.solver.linear.divfree_max_it > 0)
+    {
+      if (!divfree)
+      {
+        Mpi::Print(" Configuring divergence-free projection\n");
+        constexpr int divfree_verbose = 0;
+        divfree = std::make_unique<DivFreeSolver<ComplexVector>>(
+            space_op.GetMaterialOp(), space_op.GetNDSpace(), space_op.GetH1Spaces(),
+            space_op.GetAuxBdrTDofLists(), iodata.solver.linear.divfree_tol,
+            iodata.solver.linear.divfree_max_it, divfree_verbose);
+      }
+      eigen->SetDivFreeProjector(*divfree);
+    }
 
-  // Set up the initial space for the eigenvalue solve. Satisfies boundary conditions and is
-  // projected appropriately.
-  if (iodata.solver.eigenmode.init_v0)
-  {
-    ComplexVector v0;
-    if (iodata.solver.eigenmode.init_v0_const)
+    // Set up the initial space for the eigenvalue solve. Satisfies boundary conditions and
+    // is projected appropriately.
+    if (iodata.solver.eigenmode.init_v0)
     {
-      Mpi::Print(" Using constant starting vector\n");
-      space_op.GetConstantInitialVector(v0);
+      if (slice == 0)
+      {
+        Vector vr, vi;
+        if (LoadAdaptSolution(space_op.GetNDSpace(), 0, vr) &&
+            LoadAdaptSolution(space_op.GetNDSpace(), 1, vi))
+        {
+          // With adaptive mesh refinement, start from the first mode of the previous
+          // iteration.
+          Mpi::Print(" Using starting vector from previous adaptation iteration\n");
+          v0.SetSize(vr.Size());
+          v0.UseDevice(true);
+          v0.Set(vr, vi);
+          linalg::SetSubVector(v0, space_op.GetNDDbcTDofLists().back(), 0.0);
+        }
+        else if (iodata.solver.eigenmode.init_v0_const)
+        {
+          Mpi::Print(" Using constant starting vector\n");
+          space_op.GetConstantInitialVector(v0);
+        }
+        else
+        {
+          Mpi::Print(" Using random starting vector\n");
+          space_op.GetRandomInitialVector(v0);
+        }
+        if (divfree)
+        {
+          divfree->Mult(v0);
+        }
+      }
+      eigen->SetInitialSpace(v0);  // Copies the vector
+    }
+
+    // Configure the shift-and-invert strategy is employed to solve for the eigenvalues
+    // closest to the specified target, σ.
+    {
+      const double f_sigma =
+          iodata.DimensionalizeValue(IoData::ValueType::FREQUENCY, sigma);
+      Mpi::Print(" Shift-and-invert σ = {:.3e} GHz ({:.3e})\n", f_sigma, sigma);
+    }
+    if (C)
+    {
+      // Search for eigenvalues closest to λ = iσ.
+      eigen->SetShiftInvert(1i * sigma);
+      if (type == config::EigenSolverData::Type::ARPACK)
+      {
+        // ARPACK searches based on eigenvalues of the transformed problem. The eigenvalue
+        // 1 / (λ - σ) will be a large-magnitude negative imaginary number for an
+        // eigenvalue λ with frequency close to but not below the target σ.
+        eigen->SetWhichEigenpairs(EigenvalueSolver::WhichType::SMALLEST_IMAGINARY);
+      }
+      else
+      {
+        eigen->SetWhichEigenpairs(EigenvalueSolver::WhichType::TARGET_IMAGINARY);
+      }
     }
     else
     {
-      Mpi::Print(" Using random starting vector\n");
-      space_op.GetRandomInitialVector(v0);
+      // Linear EVP has eigenvalues μ = -λ² = ω². Search for eigenvalues closest to μ = σ².
+      eigen->SetShiftInvert(sigma * sigma);
+      if (type == config::EigenSolverData::Type::ARPACK)
+      {
+        // ARPACK searches based on eigenvalues of the transformed problem. 1 / (μ - σ²)
+        // will be a large-magnitude positive real number for an eigenvalue μ with
+        // frequency close to but below the target σ².
+        eigen->SetWhichEigenpairs(EigenvalueSolver::WhichType::LARGEST_REAL);
+      }
+      else
+      {
+        eigen->SetWhichEigenpairs(EigenvalueSolver::WhichType::TARGET_REAL);
+      }
     }
-    if (divfree)
+
+    // Set up the linear solver required for solving systems involving the shifted operator
+    // (K - σ² M) or P(iσ) = (K + iσ C - σ² M) during the eigenvalue solve. The
+    // preconditioner for complex linear systems is constructed from a real approximation
+    // to the complex system matrix. The same linear solver is used for all slices, with
+    // the operators and preconditioner updated for each shift.
+    auto A = space_op.GetSystemMatrix(std::complex<double>(1.0, 0.0), 1i * sigma,
+                                      std::complex<double>(-sigma * sigma, 0.0), K.get(),
+                                      C.get(), M.get());
+    auto P = space_op.GetPreconditionerMatrix<ComplexOperator>(1.0, sigma, -sigma * sigma,
+                                                               sigma);
+    if (!ksp)
     {
-      divfree->Mult(v0);
+      ksp = std::make_unique<ComplexKspSolver>(iodata, space_op.GetNDSpaces(),
+                                               &space_op.GetH1Spaces());
     }
-    eigen->SetInitialSpace(v0);  // Copies the vector
-
-    // Debug
-    // const auto &Grad = space_op.GetGradMatrix();
-    // ComplexVector r0(Grad->Width());
-    // r0.UseDevice(true);
-    // Grad.MultTranspose(v0.Real(), r0.Real());
-    // Grad.MultTranspose(v0.Imag(), r0.Imag());
-    // r0.Print();
-  }
+    ksp->SetOperators(*A, *P);
+    eigen->SetLinearSolver(*ksp);
 
-  // Configure the shift-and-invert strategy is employed to solve for the eigenvalues
-  // closest to the specified target, σ.
-  const double target = iodata.solver.eigenmode.target;
-  {
-    const double f_target =
-        iodata.DimensionalizeValue(IoData::ValueType::FREQUENCY, target);
-    Mpi::Print(" Shift-and-invert σ = {:.3e} GHz ({:.3e})\n", f_target, target);
-  }
-  if (C)
-  {
-    // Search for eigenvalues closest to λ = iσ.
-    eigen->SetShiftInvert(1i * target);
-    if (type == config::EigenSolverData::Type::ARPACK)
+    // Eigenvalue problem solve.
+    BlockTimer bt1(Timer::EPS);
+    Mpi::Print("\n");
+    int num_conv = eigen->Solve();
     {
-      // ARPACK searches based on eigenvalues of the transformed problem. The eigenvalue
-      // 1 / (λ - σ) will be a large-magnitude negative imaginary number for an eigenvalue
-      // λ with frequency close to but not below the target σ.
-      eigen->SetWhichEigenpairs(EigenvalueSolver::WhichType::SMALLEST_IMAGINARY);
+      std::complex<double> lambda = (num_conv > 0) ? eigen->GetEigenvalue(0) : 0.0;
+      Mpi::Print(" Found {:d} converged eigenvalue{}{}\n", num_conv,
+                 (num_conv > 1) ? "s" : "",
+                 (num_conv > 0) ? fmt::format(" (first = {:.3e}{:+.3e}i)", lambda.real(),
+                                              lambda.imag())
+                                : "");
     }
-    else
+
+    // Normalize the finalized eigenvectors with respect to mass matrix (unit electric field
+    // energy) even if they are not computed to be orthogonal with respect to it, and store
+    // the modes for postprocessing.
+    BlockTimer bt2(Timer::POSTPRO);
+    if (!iodata.solver.eigenmode.mass_orthog)
+    {
+      eigen->SetBMat(*KM);
+      eigen->RescaleEigenvectors(num_conv);
+    }
+    int num_slice = 0, num_outside = 0, num_duplicate = 0;
+    for (int i = 0; i < num_conv; i++)
+    {
+      // Get the eigenvalue and relative error.
+      std::complex<double> omega = eigen->GetEigenvalue(i);
+      if (!C)
+      {
+        // Linear EVP has eigenvalue μ = -λ² = ω².
+        omega = std::sqrt(omega);
+      }
+      else
+      {
+        // Quadratic EVP solves for eigenvalue λ = iω.
+        omega /= 1i;
+      }
+      if (n_slice > 1 &&
+          (omega.real() < omega_min || omega.real() > omega_max ||
+           (omega.real() == omega_max && slice < n_slice - 1)))
+      {
+        num_outside++;
+        continue;
+      }
+      auto &mode = modes.emplace_back(
+          ModeData{omega, eigen->GetError(i, EigenvalueSolver::ErrorType::BACKWARD),
+                   eigen->GetError(i, EigenvalueSolver::ErrorType::ABSOLUTE), i, {}});
+      if (n_slice == 1)
+      {
+        num_slice++;
+        continue;
+      }
+      mode.E.SetSize(Curl.Width());
+      mode.E.UseDevice(true);
+      eigen->GetEigenvector(i, mode.E);
+
+      // A mode near the boundary of two slices can be found by both. It is a duplicate if
+      // it lies (mostly) in the span of the already computed modes with the same frequency,
+      // which also handles degenerate modes computed as a different basis for the same
+      // eigenspace.
+      ME.SetSize(mode.E.Size());
+      ME.UseDevice(true);
+      KM->Mult(mode.E.Real(), ME.Real());
+      KM->Mult(mode.E.Imag(), ME.Imag());
+      double overlap = 0.0;
+      for (std::size_t j = 0; j + 1 < modes.size(); j++)
+      {
+        if (std::abs(modes[j].omega - omega) <= dedup_tol * std::abs(omega))
+        {
+          overlap += std::norm(linalg::Dot(space_op.GetComm(), ME, modes[j].E));
+        }
+      }
+      if (overlap > 0.5)
+      {
+        modes.pop_back();
+        num_duplicate++;
+        continue;
+      }
+      num_slice++;
+    }
+    if (n_slice > 1)
     {
-      eigen->SetWhichEigenpairs(EigenvalueSolver::WhichType::TARGET_IMAGINARY);
+      Mpi::Print(" Kept {:d} mode{} in slice ({:d} outside, {:d} duplicate{})\n", num_slice,
+                 (num_slice == 1) ? "" : "s", num_outside, num_duplicate,
+                 (num_duplicate == 1) ? "" : "s");
+      if (num_conv >= n_slice_modes && num_outside == 0)
+      {
+        Mpi::Warning("All converged modes lie inside spectrum slice {:d}, which may "
+                     "contain more modes than computed!\nConsider increasing the number of "
+                     "modes or slices.\n",
+                     slice + 1);
+      }
     }
   }
-  else
+  SaveMetadata(*ksp);
+  if (n_slice > 1)
   {
-    // Linear EVP has eigenvalues μ = -λ² = ω². Search for eigenvalues closest to μ = σ².
-    eigen->SetShiftInvert(target * target);
-    if (type == config::EigenSolverData::Type::ARPACK)
+    // Merge the modes from all slices in order of increasing frequency.
+    std::stable_sort(modes.begin(), modes.end(), [](const ModeData &a, const ModeData &b)
+                     { return a.omega.real() < b.omega.real(); });
+    Mpi::Print("\nFound {:d} mode{} in {:d} spectrum slices\n", modes.size(),
+               (modes.size() == 1) ? "" : "s", n_slice);
+  }
+  auto GetMode = [&](int i, ComplexVector &v)
+  {
+    if (n_slice > 1)
     {
-      // ARPACK searches based on eigenvalues of the transformed problem. 1 / (μ - σ²)
-      // will be a large-magnitude positive real number for an eigenvalue μ with frequency
-      // close to but below the target σ².
-      eigen->SetWhichEigenpairs(EigenvalueSolver::WhichType::LARGEST_REAL);
+      v = modes[i].E;
     }
     else
     {
-      eigen->SetWhichEigenpairs(EigenvalueSolver::WhichType::TARGET_REAL);
+      eigen->GetEigenvector(modes[i].idx, v);
     }
-  }
-
-  // Set up the linear solver required for solving systems involving the shifted operator
-  // (K - σ² M) or P(iσ) = (K + iσ C - σ² M) during the eigenvalue solve. The
-  // preconditioner for complex linear systems is constructed from a real approximation
-  // to the complex system matrix.
-  auto A = space_op.GetSystemMatrix(std::complex<double>(1.0, 0.0), 1i * target,
-                                    std::complex<double>(-target * target, 0.0), K.get(),
-                                    C.get(), M.get());
-  auto P = space_op.GetPreconditionerMatrix<ComplexOperator>(1.0, target, -target * target,
-                                                             target);
-  auto ksp = std::make_unique<ComplexKspSolver>(iodata, space_op.GetNDSpaces(),
-                                                &space_op.GetH1Spaces());
-  ksp->SetOperators(*A, *P);
-  eigen->SetLinearSolver(*ksp);
-
-  // Eigenvalue problem solve.
-  BlockTimer bt1(Timer::EPS);
-  Mpi::Print("\n");
-  int num_conv = eigen->Solve();
+  };
+  if (!modes.empty())
   {
-    std::complex<double> lambda = (num_conv > 0) ? eigen->GetEigenvalue(0) : 0.0;
-    Mpi::Print(" Found {:d} converged eigenvalue{}{}\n", num_conv,
-               (num_conv > 1) ? "s" : "",
-               (num_conv > 0)
-                   ? fmt::format(" (first = {:.3e}{:+.3e}i)", lambda.real(), lambda.imag())
-                   : "");
+    GetMode(0, E);
+    SaveAdaptSolutions(space_op.GetNDSpace(), {E.Real(), E.Imag()});
   }
-  BlockTimer bt2(Timer::POSTPRO);
-  SaveMetadata(*ksp);
 
   // Calculate and record the error indicators, and postprocess the results.
+  BlockTimer bt2(Timer::POSTPRO);
   Mpi::Print("\nComputing solution error estimates and performing postprocessing\n");
   TimeDependentFluxErrorEstimator<ComplexVector> estimator(
       space_op.GetMaterialOp(), space_op.GetNDSpaces(), space_op.GetRTSpaces(),
       iodata.solver.linear.estimator_tol, iodata.solver.linear.estimator_max_it, 0,
-      iodata.solver.linear.estimator_mg);
+      iodata.solver.linear.estimator_mg, iodata.solver.linear.estimator_local);
   ErrorIndicator indicator;
-  if (!KM)
-  {
-    // Normalize the finalized eigenvectors with respect to mass matrix (unit electric field
-    // energy) even if they are not computed to be orthogonal with respect to it.
-    KM = space_op.GetInnerProductMatrix(0.0, 1.0, nullptr, M.get());
-    eigen->SetBMat(*KM);
-    eigen->RescaleEigenvectors(num_conv);
-  }
   Mpi::Print("\n");
+  const int num_conv = static_cast<int>(modes.size());
+  const int num_indicator = std::min(num_conv, iodata.solver.eigenmode.n);
   for (int i = 0; i < num_conv; i++)
   {
-    // Get the eigenvalue and relative error.
-    std::complex<double> omega = eigen->GetEigenvalue(i);
-    double error_bkwd = eigen->GetError(i, EigenvalueSolver::ErrorType::BACKWARD);
-    double error_abs = eigen->GetError(i, EigenvalueSolver::ErrorType::ABSOLUTE);
-    if (!C)
-    {
-      // Linear EVP has eigenvalue μ = -λ² = ω².
-      omega = std::sqrt(omega);
-    }
-    else
-    {
-      // Quadratic EVP solves for eigenvalue λ = iω.
-      omega /= 1i;
-    }
-
     // Compute B = -1/(iω) ∇ x E on the true dofs, and set the internal GridFunctions in
     // PostOperator for all postprocessing operations.
-    eigen->GetEigenvector(i, E);
+    const std::complex<double> omega = modes[i].omega;
+    GetMode(i, E);
     Curl.Mult(E.Real(), B.Real());
     Curl.Mult(E.Imag(), B.Imag());
     B *= -1.0 / (1i * omega);
@@ -311,15 +464,15 @@ EigenSolver::Solve(const std::vector<std::unique_ptr<Mesh>> &mesh) const
     const double E_mag = post_op.GetHFieldEnergy();
 
     // Calculate and record the error indicators.
-    if (i < iodata.solver.eigenmode.n)
+    if (i < num_indicator)
     {
       estimator.AddErrorIndicator(E, B, E_elec + E_mag, indicator);
     }
 
     // Postprocess the mode.
-    Postprocess(post_op, space_op.GetLumpedPortOp(), i, omega, error_bkwd, error_abs,
-                num_conv, E_elec, E_mag,
-                (i == iodata.solver.eigenmode.n - 1) ? &indicator : nullptr);
+    Postprocess(post_op, space_op.GetLumpedPortOp(), i, omega, modes[i].error_bkwd,
+                modes[i].error_abs, num_conv, E_elec, E_mag,
+                (i == num_indicator - 1) ? &indicator : nullptr);
   }
   return {indicator, space_op.GlobalTrueVSize()};
 }
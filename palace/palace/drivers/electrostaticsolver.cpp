@@ -42,32 +42,40 @@ ElectrostaticSolver::Solve(const std::vector<std::unique_ptr<Mesh>> &mesh) const
   MFEM_VERIFY(n_step > 0, "No terminal boundaries specified for electrostatic simulation!");
 
   // Right-hand side term and solution vector storage.
-  Vector RHS(Grad.Width()), E(Grad.Height());
-  std::vector<Vector> V(n_step);
+  Vector E(Grad.Height());
+  std::vector<Vector> RHS(n_step), V(n_step);
 
   // Initialize structures for storing and reducing the results of error estimation.
   GradFluxErrorEstimator estimator(
       laplace_op.GetMaterialOp(), laplace_op.GetNDSpace(), laplace_op.GetRTSpaces(),
       iodata.solver.linear.estimator_tol, iodata.solver.linear.estimator_max_it, 0,
-      iodata.solver.linear.estimator_mg);
+      iodata.solver.linear.estimator_mg, iodata.solver.linear.estimator_local);
   ErrorIndicator indicator;
 
-  // Main loop over terminal boundaries.
+  // Form and solve the linear systems for a prescribed nonzero voltage on each terminal.
+  // The systems for all terminals share the same operator and are solved together.
   Mpi::Print("\nComputing electrostatic fields for {:d} terminal boundar{}\n", n_step,
              (n_step > 1) ? "ies" : "y");
   int step = 0;
   auto t0 = Timer::Now();
   for (const auto &[idx, data] : laplace_op.GetSources())
+  {
+    // With adaptive mesh refinement, the solution from the previous iteration is used as
+    // the initial guess.
+    laplace_op.GetExcitationVector(idx, *K, V[step], RHS[step]);
+    LoadAdaptSolution(laplace_op.GetH1Space(), step, V[step]);
+    step++;
+  }
+  Mpi::Print("\n");
+  ksp.Mult(RHS, V);
+
+  // Main loop over terminal boundaries for postprocessing.
+  step = 0;
+  for (const auto &[idx, data] : laplace_op.GetSources())
   {
     Mpi::Print("\nIt {:d}/{:d}: Index = {:d} (elapsed time = {:.2e} s)\n", step + 1, n_step,
                idx, Timer::Duration(Timer::Now() - t0).count());
 
-    // Form and solve the linear system for a prescribed nonzero voltage on the specified
-    // terminal.
-    Mpi::Print("\n");
-    laplace_op.GetExcitationVector(idx, *K, V[step], RHS);
-    ksp.Mult(RHS, V[step]);
-
     // Compute E = -∇V on the true dofs, and set the internal GridFunctions in PostOperator
     // for all postprocessing operations.
     BlockTimer bt2(Timer::POSTPRO);
@@ -78,7 +86,7 @@ ElectrostaticSolver::Solve(const std::vector<std::unique_ptr<Mesh>> &mesh) const
     const double E_elec = post_op.GetEFieldEnergy();
     Mpi::Print(" Sol. ||V|| = {:.6e} (||RHS|| = {:.6e})\n",
                linalg::Norml2(laplace_op.GetComm(), V[step]),
-               linalg::Norml2(laplace_op.GetComm(), RHS));
+               linalg::Norml2(laplace_op.GetComm(), RHS[step]));
     {
       const double J = iodata.DimensionalizeValue(IoData::ValueType::ENERGY, 1.0);
       Mpi::Print(" Field energy E = {:.3e} J\n", E_elec * J);
@@ -98,6 +106,7 @@ ElectrostaticSolver::Solve(const std::vector<std::unique_ptr<Mesh>> &mesh) const
   // Postprocess the capacitance matrix from the computed field solutions.
   BlockTimer bt1(Timer::POSTPRO);
   SaveMetadata(ksp);
+  SaveAdaptSolutions(laplace_op.GetH1Space(), V);
   PostprocessTerminals(post_op, laplace_op.GetSources(), V);
   return {indicator, laplace_op.GlobalTrueVSize()};
 }
@@ -131,32 +140,50 @@ void ElectrostaticSolver::PostprocessTerminals(
   // charges from the prescribed voltage to get C directly as:
   //         Q_i = ∫ ρ dV = ∫ ∇ ⋅ (ε E) dV = ∫ (ε E) ⋅ n dS
   // and C_ij = Q_i/V_j. The energy formulation avoids having to locally integrate E = -∇V.
-  mfem::DenseMatrix C(V.size()), Cm(V.size());
-  for (int i = 0; i < C.Height(); i++)
+  //
+  // Diagonal: Cᵢᵢ = 2 Uₑ(Vᵢ) / Vᵢ² = (Vᵢᵀ K Vᵢ) / Vᵢ² (with ∀i, Vᵢ = 1)
+  // Off-diagonals: Cᵢⱼ = Uₑ(Vᵢ + Vⱼ) / (Vᵢ Vⱼ) - 1/2 (Vᵢ/Vⱼ Cᵢᵢ + Vⱼ/Vᵢ Cⱼⱼ)
+  //                    = (Vⱼᵀ K Vᵢ) / (Vᵢ Vⱼ)
+  // The upper triangle of the blocked product Vᵀ K V is computed locally and reduced across
+  // processes with a single global sum.
+  const int n = static_cast<int>(V.size());
+  auto &V_gf = post_op.GetVGridFunction().Real();
+  auto &D_gf = post_op.GetDomainPostOp().D;
+  std::vector<Vector> V_l(n), D_l(n);
+  for (int i = 0; i < n; i++)
   {
-    // Diagonal: Cᵢᵢ = 2 Uₑ(Vᵢ) / Vᵢ² = (Vᵢᵀ K Vᵢ) / Vᵢ² (with ∀i, Vᵢ = 1)
-    auto &V_gf = post_op.GetVGridFunction().Real();
-    auto &D_gf = post_op.GetDomainPostOp().D;
     V_gf.SetFromTrueDofs(V[i]);
     post_op.GetDomainPostOp().M_elec->Mult(V_gf, D_gf);
-    C(i, i) = Cm(i, i) = linalg::Dot<Vector>(post_op.GetComm(), V_gf, D_gf);
-
-    // Off-diagonals: Cᵢⱼ = Uₑ(Vᵢ + Vⱼ) / (Vᵢ Vⱼ) - 1/2 (Vᵢ/Vⱼ Cᵢᵢ + Vⱼ/Vᵢ Cⱼⱼ)
-    //                    = (Vⱼᵀ K Vᵢ) / (Vᵢ Vⱼ)
-    for (int j = i + 1; j < C.Width(); j++)
+    V_l[i] = V_gf;
+    D_l[i] = D_gf;
+  }
+  std::vector<double> VtKV;
+  VtKV.reserve(n * (n + 1) / 2);
+  for (int i = 0; i < n; i++)
+  {
+    for (int j = i; j < n; j++)
     {
-      V_gf.SetFromTrueDofs(V[j]);
-      C(i, j) = linalg::Dot<Vector>(post_op.GetComm(), V_gf, D_gf);
-      Cm(i, j) = -C(i, j);
-      Cm(i, i) -= Cm(i, j);
+      VtKV.push_back(linalg::LocalDot(V_l[j], D_l[i]));
     }
+  }
+  Mpi::GlobalSum(static_cast<int>(VtKV.size()), VtKV.data(), post_op.GetComm());
 
-    // Copy lower triangle from already computed upper triangle.
-    for (int j = 0; j < i; j++)
+  mfem::DenseMatrix C(n), Cm(n);
+  for (int i = 0, k = 0; i < n; i++)
+  {
+    for (int j = i; j < n; j++, k++)
+    {
+      C(i, j) = C(j, i) = VtKV[k];
+      Cm(i, j) = Cm(j, i) = -VtKV[k];
+    }
+  }
+  for (int i = 0; i < n; i++)
+  {
+    // Diagonal of the mutual capacitance matrix is the row sum of C.
+    Cm(i, i) = 0.0;
+    for (int j = 0; j < n; j++)
     {
-      C(i, j) = C(j, i);
-      Cm(i, j) = Cm(j, i);
-      Cm(i, i) -= Cm(i, j);
+      Cm(i, i) += C(i, j);
     }
   }
   mfem::DenseMatrix Cinv(C);
@@ -42,34 +42,44 @@ MagnetostaticSolver::Solve(const std::vector<std::unique_ptr<Mesh>> &mesh) const
               "No surface current boundaries specified for magnetostatic simulation!");
 
   // Source term and solution vector storage.
-  Vector RHS(Curl.Width()), B(Curl.Height());
-  std::vector<Vector> A(n_step);
+  Vector B(Curl.Height());
+  std::vector<Vector> RHS(n_step), A(n_step);
   std::vector<double> I_inc(n_step);
 
   // Initialize structures for storing and reducing the results of error estimation.
   CurlFluxErrorEstimator estimator(
       curlcurl_op.GetMaterialOp(), curlcurl_op.GetRTSpace(), curlcurl_op.GetNDSpaces(),
       iodata.solver.linear.estimator_tol, iodata.solver.linear.estimator_max_it, 0,
-      iodata.solver.linear.estimator_mg);
+      iodata.solver.linear.estimator_mg, iodata.solver.linear.estimator_local);
   ErrorIndicator indicator;
 
-  // Main loop over current source boundaries.
+  // Form and solve the linear systems for a prescribed current on each source. The systems
+  // for all sources share the same operator and are solved together.
   Mpi::Print("\nComputing magnetostatic fields for {:d} source boundar{}\n", n_step,
              (n_step > 1) ? "ies" : "y");
   int step = 0;
   auto t0 = Timer::Now();
   for (const auto &[idx, data] : curlcurl_op.GetSurfaceCurrentOp())
   {
-    Mpi::Print("\nIt {:d}/{:d}: Index = {:d} (elapsed time = {:.2e} s)\n", step + 1, n_step,
-               idx, Timer::Duration(Timer::Now() - t0).count());
-
-    // Form and solve the linear system for a prescribed current on the specified source.
-    Mpi::Print("\n");
-    A[step].SetSize(RHS.Size());
+    A[step].SetSize(Curl.Width());
     A[step].UseDevice(true);
     A[step] = 0.0;
-    curlcurl_op.GetExcitationVector(idx, RHS);
-    ksp.Mult(RHS, A[step]);
+    curlcurl_op.GetExcitationVector(idx, RHS[step]);
+
+    // With adaptive mesh refinement, the solution from the previous iteration is used as
+    // the initial guess.
+    LoadAdaptSolution(curlcurl_op.GetNDSpace(), step, A[step]);
+    step++;
+  }
+  Mpi::Print("\n");
+  ksp.Mult(RHS, A);
+
+  // Main loop over current source boundaries for postprocessing.
+  step = 0;
+  for (const auto &[idx, data] : curlcurl_op.GetSurfaceCurrentOp())
+  {
+    Mpi::Print("\nIt {:d}/{:d}: Index = {:d} (elapsed time = {:.2e} s)\n", step + 1, n_step,
+               idx, Timer::Duration(Timer::Now() - t0).count());
 
     // Compute B = ∇ x A on the true dofs, and set the internal GridFunctions in
     // PostOperator for all postprocessing operations.
@@ -80,7 +90,7 @@ MagnetostaticSolver::Solve(const std::vector<std::unique_ptr<Mesh>> &mesh) const
     const double E_mag = post_op.GetHFieldEnergy();
     Mpi::Print(" Sol. ||A|| = {:.6e} (||RHS|| = {:.6e})\n",
                linalg::Norml2(curlcurl_op.GetComm(), A[step]),
-               linalg::Norml2(curlcurl_op.GetComm(), RHS));
+               linalg::Norml2(curlcurl_op.GetComm(), RHS[step]));
     {
       const double J = iodata.DimensionalizeValue(IoData::ValueType::ENERGY, 1.0);
       Mpi::Print(" Field energy H = {:.3e} J\n", E_mag * J);
@@ -102,6 +112,7 @@ MagnetostaticSolver::Solve(const std::vector<std::unique_ptr<Mesh>> &mesh) const
   // Postprocess the inductance matrix from the computed field solutions.
   BlockTimer bt1(Timer::POSTPRO);
   SaveMetadata(ksp);
+  SaveAdaptSolutions(curlcurl_op.GetNDSpace(), A);
   PostprocessTerminals(post_op, curlcurl_op.GetSurfaceCurrentOp(), A, I_inc);
   return {indicator, curlcurl_op.GlobalTrueVSize()};
 }
@@ -138,33 +149,50 @@ void MagnetostaticSolver::PostprocessTerminals(PostOperator &post_op,
   //                         Φ_i = ∫ B ⋅ n_j dS
   // and M_ij = Φ_i/I_j. The energy formulation avoids having to locally integrate B =
   // ∇ x A.
-  mfem::DenseMatrix M(A.size()), Mm(A.size());
-  for (int i = 0; i < M.Height(); i++)
+  //
+  // Diagonal: Mᵢᵢ = 2 Uₘ(Aᵢ) / Iᵢ² = (Aᵢᵀ K Aᵢ) / Iᵢ²
+  // Off-diagonals: Mᵢⱼ = Uₘ(Aᵢ + Aⱼ) / (Iᵢ Iⱼ) - 1/2 (Iᵢ/Iⱼ Mᵢᵢ + Iⱼ/Iᵢ Mⱼⱼ)
+  //                    = (Aⱼᵀ K Aᵢ) / (Iᵢ Iⱼ)
+  // The upper triangle of the blocked product Aᵀ K A is computed locally and reduced across
+  // processes with a single global sum.
+  const int n = static_cast<int>(A.size());
+  auto &A_gf = post_op.GetAGridFunction().Real();
+  auto &H_gf = post_op.GetDomainPostOp().H;
+  std::vector<Vector> A_l(n), H_l(n);
+  for (int i = 0; i < n; i++)
   {
-    // Diagonal: Mᵢᵢ = 2 Uₘ(Aᵢ) / Iᵢ² = (Aᵢᵀ K Aᵢ) / Iᵢ²
-    auto &A_gf = post_op.GetAGridFunction().Real();
-    auto &H_gf = post_op.GetDomainPostOp().H;
     A_gf.SetFromTrueDofs(A[i]);
     post_op.GetDomainPostOp().M_mag->Mult(A_gf, H_gf);
-    M(i, i) = Mm(i, i) =
-        linalg::Dot<Vector>(post_op.GetComm(), A_gf, H_gf) / (I_inc[i] * I_inc[i]);
-
-    // Off-diagonals: Mᵢⱼ = Uₘ(Aᵢ + Aⱼ) / (Iᵢ Iⱼ) - 1/2 (Iᵢ/Iⱼ Mᵢᵢ + Iⱼ/Iᵢ Mⱼⱼ)
-    //                    = (Aⱼᵀ K Aᵢ) / (Iᵢ Iⱼ)
-    for (int j = i + 1; j < M.Width(); j++)
+    A_l[i] = A_gf;
+    H_l[i] = H_gf;
+  }
+  std::vector<double> AtKA;
+  AtKA.reserve(n * (n + 1) / 2);
+  for (int i = 0; i < n; i++)
+  {
+    for (int j = i; j < n; j++)
     {
-      A_gf.SetFromTrueDofs(A[j]);
-      M(i, j) = linalg::Dot<Vector>(post_op.GetComm(), A_gf, H_gf) / (I_inc[i] * I_inc[j]);
-      Mm(i, j) = -M(i, j);
-      Mm(i, i) -= Mm(i, j);
+      AtKA.push_back(linalg::LocalDot(A_l[j], H_l[i]));
     }
+  }
+  Mpi::GlobalSum(static_cast<int>(AtKA.size()), AtKA.data(), post_op.GetComm());
 
-    // Copy lower triangle from already computed upper triangle.
-    for (int j = 0; j < i; j++)
+  mfem::DenseMatrix M(n), Mm(n);
+  for (int i = 0, k = 0; i < n; i++)
+  {
+    for (int j = i; j < n; j++, k++)
+    {
+      M(i, j) = M(j, i) = AtKA[k] / (I_inc[i] * I_inc[j]);
+      Mm(i, j) = Mm(j, i) = -M(i, j);
+    }
+  }
+  for (int i = 0; i < n; i++)
+  {
+    // Diagonal of the mutual inductance matrix is the row sum of M.
+    Mm(i, i) = 0.0;
+    for (int j = 0; j < n; j++)
     {
-      M(i, j) = M(j, i);
-      Mm(i, j) = Mm(j, i);
-      Mm(i, i) -= Mm(i, j);
+      Mm(i, i) += M(i, j);
     }
   }
   mfem::DenseMatrix Minv(M);
@@ -15,12 +15,52 @@
 #include "models/timeoperator.hpp"
 #include "utils/communication.hpp"
 #include "utils/excitations.hpp"
+#include "utils/filesystem.hpp"
 #include "utils/iodata.hpp"
 #include "utils/timer.hpp"
 
 namespace palace
 {
 
+namespace
+{
+
+std::map<std::string, std::int64_t> GetOutputSizes(const std::string &post_dir, bool root)
+{
+  // Sizes of the postprocessing output files (only on the root process), for truncating
+  // them to the state at the time of a checkpoint when restarting.
+  std::map<std::string, std::int64_t> sizes;
+  if (root && post_dir.length() > 0)
+  {
+    for (const auto &entry : std::filesystem::directory_iterator(post_dir))
+    {
+      if (entry.is_regular_file() && entry.path().extension() == ".csv")
+      {
+        sizes[entry.path().filename().string()] =
+            static_cast<std::int64_t>(entry.file_size());
+      }
+    }
+  }
+  return sizes;
+}
+
+void TruncateOutputs(const std::string &post_dir,
+                     const std::map<std::string, std::int64_t> &sizes)
+{
+  // Remove any rows written to the postprocessing output files after the checkpoint.
+  for (const auto &[name, size] : sizes)
+  {
+    const auto path = std::filesystem::path(post_dir) / name;
+    if (std::filesystem::exists(path) &&
+        std::filesystem::file_size(path) > static_cast<std::uintmax_t>(size))
+    {
+      std::filesystem::resize_file(path, size);
+    }
+  }
+}
+
+}  // namespace
+
 std::pair<ErrorIndicator, long long int>
 TransientSolver::Solve(const std::vector<std::unique_ptr<Mesh>> &mesh) const
 {
@@ -31,19 +71,59 @@ TransientSolver::Solve(const std::vector<std::unique_ptr<Mesh>> &mesh) const
   SpaceOperator space_op(iodata, mesh);
   TimeOperator time_op(iodata, space_op, dJdt_coef);
   double delta_t = iodata.solver.transient.delta_t;
-  if (time_op.isExplicit())
+
+  // Restart from a checkpoint if requested and one is available for this problem. This
+  // also includes the error indicators accumulated up to the checkpoint.
+  const auto &checkpoint = iodata.solver.transient.checkpoint;
+  const int delta_checkpoint = iodata.solver.transient.delta_checkpoint;
+  ErrorIndicator indicator;
+  int step = 0;
+  double t = -delta_t;
+  bool restart = false;
+  if (iodata.solver.transient.restart)
+  {
+    MFEM_VERIFY(!checkpoint.empty(),
+                "Transient restart requires config[\"Solver\"][\"Transient\"]"
+                "[\"Checkpoint\"] to be specified!");
+    std::map<std::string, std::int64_t> outputs;
+    restart = time_op.LoadCheckpoint(checkpoint, step, t, delta_t, indicator, outputs);
+    if (restart)
+    {
+      const double ts = iodata.DimensionalizeValue(IoData::ValueType::TIME, t);
+      Mpi::Print(" Restarting from checkpoint at step {:d} (t = {:e} ns) from {}\n", step,
+                 ts, checkpoint);
+      TruncateOutputs(post_dir, outputs);
+      step++;
+    }
+    else
+    {
+      Mpi::Warning("No valid checkpoint found in {} for restart, starting from t = 0!\n",
+                   checkpoint);
+    }
+  }
+  if (time_op.isExplicit() && !restart)
   {
     // Stability limited time step.
     const double dt_max = time_op.GetMaxTimeStep();
     const double dts_max = iodata.DimensionalizeValue(IoData::ValueType::TIME, dt_max);
     Mpi::Print(" Maximum stable time step: {:.6e} ns\n", dts_max);
+    const double dts_cfl =
+        iodata.DimensionalizeValue(IoData::ValueType::TIME, time_op.GetCFLTimeStep());
+    Mpi::Print(" CFL time step estimate: {:.6e} ns\n", dts_cfl);
     delta_t = std::min(delta_t, 0.95 * dt_max);
+    t = -delta_t;
   }
-  int n_step = GetNumSteps(0.0, iodata.solver.transient.max_t, delta_t);
+  // With adaptive time step control, the number of steps is not known in advance and time
+  // stepping continues until the final time is reached.
+  const bool adaptive = time_op.IsAdaptive();
+  const double max_t = iodata.solver.transient.max_t;
+  const double t_end = max_t - 1.0e-6 * iodata.solver.transient.delta_t;
+  int n_step = adaptive ? 0 : GetNumSteps(0.0, max_t, delta_t);
   SaveMetadata(space_op.GetNDSpaces());
 
-  // Time stepping is uniform in the time domain. Index sets are for computing things like
-  // port voltages and currents in postprocessing.
+  // Time stepping is uniform in the time domain unless adaptive time step control is
+  // enabled. Index sets are for computing things like port voltages and currents in
+  // postprocessing.
   PostOperator post_op(iodata, space_op, "transient");
   {
     Mpi::Print("\nComputing transient response for:\n");
@@ -82,18 +162,24 @@ TransientSolver::Solve(const std::vector<std::unique_ptr<Mesh>> &mesh) const
   TimeDependentFluxErrorEstimator<Vector> estimator(
       space_op.GetMaterialOp(), space_op.GetNDSpaces(), space_op.GetRTSpaces(),
       iodata.solver.linear.estimator_tol, iodata.solver.linear.estimator_max_it, 0,
-      iodata.solver.linear.estimator_mg);
-  ErrorIndicator indicator;
+      iodata.solver.linear.estimator_mg, iodata.solver.linear.estimator_local);
 
   // Main time integration loop.
-  int step = 0;
-  double t = -delta_t;
   auto t0 = Timer::Now();
-  while (step < n_step)
+  while (adaptive ? (step == 0 || t < t_end) : step < n_step)
   {
-    const double ts = iodata.DimensionalizeValue(IoData::ValueType::TIME, t + delta_t);
-    Mpi::Print("\nIt {:d}/{:d}: t = {:e} ns (elapsed time = {:.2e} s)\n", step, n_step - 1,
-               ts, Timer::Duration(Timer::Now() - t0).count());
+    const double ts = iodata.DimensionalizeValue(
+        IoData::ValueType::TIME, adaptive ? std::min(t + delta_t, max_t) : t + delta_t);
+    if (adaptive)
+    {
+      Mpi::Print("\nIt {:d}: t = {:e} ns (elapsed time = {:.2e} s)\n", step, ts,
+                 Timer::Duration(Timer::Now() - t0).count());
+    }
+    else
+    {
+      Mpi::Print("\nIt {:d}/{:d}: t = {:e} ns (elapsed time = {:.2e} s)\n", step,
+                 n_step - 1, ts, Timer::Duration(Timer::Now() - t0).count());
+    }
 
     // Single time step t -> t + dt.
     BlockTimer bt1(Timer::TS);
@@ -106,7 +192,14 @@ TransientSolver::Solve(const std::vector<std::unique_ptr<Mesh>> &mesh) const
     else
     {
       time_op.Step(t, delta_t);  // Advances t internally
+      if (adaptive)
+      {
+        Mpi::Print(" Accepted time step to t = {:e} ns, next Δt = {:.3e} ns\n",
+                   iodata.DimensionalizeValue(IoData::ValueType::TIME, t),
+                   iodata.DimensionalizeValue(IoData::ValueType::TIME, delta_t));
+      }
     }
+    const bool last = adaptive ? (step > 0 && t >= t_end) : (step == n_step - 1);
 
     // Postprocess for the time step.
     BlockTimer bt2(Timer::POSTPRO);
@@ -132,13 +225,25 @@ TransientSolver::Solve(const std::vector<std::unique_ptr<Mesh>> &mesh) const
 
     // Postprocess port voltages/currents and optionally write solution to disk.
     Postprocess(post_op, space_op.GetLumpedPortOp(), space_op.GetSurfaceCurrentOp(), step,
-                t, J_coef(t), E_elec, E_mag, (step == n_step - 1) ? &indicator : nullptr);
+                t, J_coef(t), E_elec, E_mag, last ? &indicator : nullptr);
+
+    // Save a checkpoint for restart, including at the final step so that the simulation can
+    // be continued to a later time.
+    if (!checkpoint.empty() && delta_checkpoint > 0 &&
+        ((step + 1) % delta_checkpoint == 0 || last))
+    {
+      time_op.SaveCheckpoint(checkpoint, step, t, delta_t, indicator,
+                             GetOutputSizes(post_dir, root));
+    }
 
     // Increment time step.
     step++;
   }
   BlockTimer bt1(Timer::POSTPRO);
-  SaveMetadata(time_op.GetLinearSolver());
+  if (const auto *ksp = time_op.GetLinearSolver())
+  {
+    SaveMetadata(*ksp);
+  }
   return {indicator, space_op.GlobalTrueVSize()};
 }
 
@@ -47,4 +47,26 @@ void ErrorIndicator::AddIndicator(const Vector &indicator)
   n += 1;
 }
 
+void ErrorIndicator::AddIndicators(MPI_Comm comm)
+{
+  // Combine the running averages with the same weighting as for AddIndicator:
+  //                            eₖ = √(∑ₘ nₘ eₖₘ² / ∑ₘ nₘ)
+  int N = n;
+  Mpi::GlobalSum(1, &N, comm);
+  MFEM_VERIFY(n > 0 && N > 0,
+              "ErrorIndicator::AddIndicators requires a nonempty indicator on each "
+              "process!");
+  auto *L = local.HostReadWrite();
+  for (int i = 0; i < local.Size(); i++)
+  {
+    L[i] = L[i] * L[i] * n;
+  }
+  Mpi::GlobalSum(local.Size(), L, comm);
+  for (int i = 0; i < local.Size(); i++)
+  {
+    L[i] = std::sqrt(L[i] / N);
+  }
+  n = N;
+}
+
 }  // namespace palace
@@ -32,13 +32,25 @@ public:
     this->local.UseDevice(true);
   }
   ErrorIndicator() : n(0) { local.UseDevice(true); }
+  ErrorIndicator(Vector &&local, int n) : local(std::move(local)), n(n)
+  {
+    this->local.UseDevice(true);
+  }
 
   // Add an indicator to the running total.
   void AddIndicator(const Vector &indicator);
 
+  // Combine the running averages of the indicators over the processes of the given
+  // communicator. Each process must hold an indicator for the same local elements, for
+  // example for copies of an identically partitioned mesh on different process groups.
+  void AddIndicators(MPI_Comm comm);
+
   // Return the local error indicator.
   const auto &Local() const { return local; }
 
+  // Return the number of samples combined in the running average.
+  int Samples() const { return n; }
+
   // Return the global error indicator.
   auto Norml2(MPI_Comm comm) const { return linalg::Norml2(comm, local); }
 
@@ -31,9 +31,21 @@ private:
   mutable ceed::CeedObjectMap<CeedBasis> basis;
   mutable ceed::CeedObjectMap<CeedElemRestriction> restr, interp_restr, interp_range_restr;
 
-  // Temporary storage for operator applications.
+  // Temporary storage for operator applications. The real and imaginary parts of each
+  // vector are stored contiguously in a single block, so that real-valued operators can be
+  // applied to both parts at once.
+  mutable Vector tx_data, lx_data, ly_data;
   mutable ComplexVector tx, lx, ly;
 
+  static void SetBlockSize(Vector &data, ComplexVector &v, int size)
+  {
+    if (data.Size() != 2 * size)
+    {
+      data.SetSize(2 * size);
+      v.MakeRef(data, 0, size);
+    }
+  }
+
   // Members for discrete interpolators from an auxiliary space to a primal space.
   mutable const FiniteElementSpace *aux_fespace;
   mutable std::unique_ptr<Operator> G;
@@ -69,9 +81,9 @@ public:
     : fespace(&mesh.Get(), std::forward<T>(args)...), mesh(mesh), aux_fespace(nullptr)
   {
     ResetCeedObjects();
-    tx.UseDevice(true);
-    lx.UseDevice(true);
-    ly.UseDevice(true);
+    tx_data.UseDevice(true);
+    lx_data.UseDevice(true);
+    ly_data.UseDevice(true);
   }
   virtual ~FiniteElementSpace() { ResetCeedObjects(); }
 
@@ -150,7 +162,7 @@ public:
   template <typename VecType>
   auto &GetTVector() const
   {
-    tx.SetSize(GetTrueVSize());
+    SetBlockSize(tx_data, tx, GetTrueVSize());
     if constexpr (std::is_same<VecType, ComplexVector>::value)
     {
       return tx;
@@ -164,7 +176,7 @@ public:
   template <typename VecType>
   auto &GetLVector() const
   {
-    lx.SetSize(GetVSize());
+    SetBlockSize(lx_data, lx, GetVSize());
     if constexpr (std::is_same<VecType, ComplexVector>::value)
     {
       return lx;
@@ -178,7 +190,7 @@ public:
   template <typename VecType>
   auto &GetLVector2() const
   {
-    ly.SetSize(GetVSize());
+    SetBlockSize(ly_data, ly, GetVSize());
     if constexpr (std::is_same<VecType, ComplexVector>::value)
     {
       return ly;
@@ -71,53 +71,147 @@ InterpolationOperator::InterpolationOperator(const IoData &iodata, mfem::ParMesh
 #endif
 }
 
-std::vector<double> InterpolationOperator::ProbeField(const mfem::ParGridFunction &U)
+const mfem::SparseMatrix &
+InterpolationOperator::GetProbeMatrix(const mfem::ParGridFunction &U)
 {
+  const auto &fespace = *U.ParFESpace();
+  auto it = probe_mats.find(&fespace);
+  if (it != probe_mats.end() && it->second->Width() == fespace.GetVSize())
+  {
+    return *it->second;
+  }
 #if defined(MFEM_USE_GSLIB)
-  // Interpolated vector values are returned from GSLIB interpolator with the same ordering
-  // as the source grid function, which we transform to byVDIM for output.
-  const int npts = op.GetCode().Size();
+  // Each process evaluates the basis functions at the reference coordinates of the probe
+  // points in its own elements, as located by GSLIB. The element degree of freedom
+  // transformation and orientation are applied so that the rows act directly on the local
+  // degrees of freedom of the grid function.
+  auto &mesh = *fespace.GetParMesh();
+  const int rank = Mpi::Rank(mesh.GetComm());
+  const int dim = mesh.Dimension();
+  const int npts = static_cast<int>(op_idx.size());
   const int vdim = U.VectorDim();
-  std::vector<double> vals(npts * vdim);
-  if (U.FESpace()->GetOrdering() == mfem::Ordering::byVDIM)
+  const auto &code = op.GetCode();
+  const auto &proc = op.GetProc();
+  const auto &elem = op.GetElem();
+  const auto &ref = op.GetReferencePosition();
+  auto P = std::make_unique<mfem::SparseMatrix>(npts * vdim, fespace.GetVSize());
+  mfem::DenseMatrix vshape;
+  mfem::Vector shape, col;
+  mfem::Array<int> vdofs;
+  auto AddEntry = [&P](int i, int vdof, double a)
   {
-    mfem::Vector v(vals.data(), npts * vdim);
-    op.Interpolate(U, v);
-  }
-  else
+    if (vdof >= 0)
+    {
+      P->Add(i, vdof, a);
+    }
+    else
+    {
+      P->Add(i, -1 - vdof, -a);
+    }
+  };
+  for (int i = 0; i < npts; i++)
   {
-    mfem::Vector v(npts * vdim);
-    op.Interpolate(U, v);
-    for (int d = 0; d < vdim; d++)
+    if (code[i] == 2 || static_cast<int>(proc[i]) != rank)
+    {
+      continue;
+    }
+    const int e = static_cast<int>(elem[i]);
+    mfem::IntegrationPoint ip;
+    ip.Set(ref.GetData() + i * dim, dim);
+    mfem::ElementTransformation &T = *mesh.GetElementTransformation(e);
+    T.SetIntPoint(&ip);
+    const mfem::FiniteElement &fe = *fespace.GetFE(e);
+    const mfem::DofTransformation *dof_trans = fespace.GetElementVDofs(e, vdofs);
+    const int ndof = fe.GetDof();
+    if (fe.GetRangeType() == mfem::FiniteElement::VECTOR)
+    {
+      vshape.SetSize(ndof, vdim);
+      fe.CalcVShape(T, vshape);
+      for (int d = 0; d < vdim; d++)
+      {
+        vshape.GetColumnReference(d, col);
+        if (dof_trans)
+        {
+          dof_trans->TransformDual(col);
+        }
+        for (int j = 0; j < ndof; j++)
+        {
+          AddEntry(i * vdim + d, vdofs[j], col(j));
+        }
+      }
+    }
+    else
     {
-      for (int i = 0; i < npts; i++)
+      shape.SetSize(ndof);
+      fe.CalcPhysShape(T, shape);
+      for (int d = 0; d < vdim; d++)
       {
-        vals[i * vdim + d] = v(d * npts + i);
+        for (int j = 0; j < ndof; j++)
+        {
+          AddEntry(i * vdim + d, vdofs[d * ndof + j], shape(j));
+        }
       }
     }
   }
-  return vals;
+  P->Finalize();
+  return *(probe_mats[&fespace] = std::move(P));
 #else
   MFEM_ABORT("InterpolationOperator class requires MFEM_USE_GSLIB!");
-  return {};
+  static const mfem::SparseMatrix empty;
+  return empty;  // Silence compiler warning
 #endif
 }
 
-std::vector<std::complex<double>> InterpolationOperator::ProbeField(const GridFunction &U)
+void InterpolationOperator::AddProbeFieldLocal(const mfem::ParGridFunction &U, double *vals)
 {
-  std::vector<double> vr = ProbeField(U.Real());
-  if (U.HasImag())
+  const auto &P = GetProbeMatrix(U);
+  mfem::Vector v(vals, P.Height());
+  v.UseDevice(false);
+  P.AddMult(U, v);
+  v.HostRead();  // Copy back if the product was computed on device
+}
+
+std::vector<std::vector<std::complex<double>>>
+InterpolationOperator::ProbeFields(const std::vector<const GridFunction *> &U)
+{
+  // Evaluate the real and imaginary parts of all fields locally, followed by a single
+  // reduction.
+  std::vector<std::size_t> offsets(U.size() + 1, 0);
+  for (std::size_t k = 0; k < U.size(); k++)
   {
-    std::vector<double> vi = ProbeField(U.Imag());
-    std::vector<std::complex<double>> vals(vr.size());
-    std::transform(vr.begin(), vr.end(), vi.begin(), vals.begin(),
-                   [](double xr, double xi) { return std::complex<double>(xr, xi); });
-    return vals;
+    offsets[k + 1] = offsets[k] + 2 * op_idx.size() * U[k]->VectorDim();
   }
-  else
+  std::vector<double> buff(offsets.back(), 0.0);
+  for (std::size_t k = 0; k < U.size(); k++)
+  {
+    const std::size_t n = offsets[k + 1] - offsets[k];
+    AddProbeFieldLocal(U[k]->Real(), buff.data() + offsets[k]);
+    if (U[k]->HasImag())
+    {
+      AddProbeFieldLocal(U[k]->Imag(), buff.data() + offsets[k] + n / 2);
+    }
+  }
+  if (!U.empty())
+  {
+    Mpi::GlobalSum(static_cast<int>(buff.size()), buff.data(), U[0]->GetComm());
+  }
+  std::vector<std::vector<std::complex<double>>> vals(U.size());
+  for (std::size_t k = 0; k < U.size(); k++)
   {
-    return std::vector<std::complex<double>>(vr.begin(), vr.end());
+    const std::size_t n = (offsets[k + 1] - offsets[k]) / 2;
+    const double *vr = buff.data() + offsets[k], *vi = vr + n;
+    vals[k].resize(n);
+    for (std::size_t i = 0; i < n; i++)
+    {
+      vals[k][i] = {vr[i], vi[i]};
+    }
   }
+  return vals;
+}
+
+std::vector<std::complex<double>> InterpolationOperator::ProbeField(const GridFunction &U)
+{
+  return ProbeFields({&U})[0];
 }
 
 namespace fem
@@ -5,6 +5,8 @@
 #define PALACE_FEM_INTERPOLATOR_HPP
 
 #include <complex>
+#include <map>
+#include <memory>
 #include <vector>
 #include <mfem.hpp>
 
@@ -25,14 +27,31 @@ private:
 #endif
   std::vector<int> op_idx;
 
-  std::vector<double> ProbeField(const mfem::ParGridFunction &U);
+  // Sparse matrices mapping the local degrees of freedom of a grid function on the given
+  // finite element space to its values at the probe points owned by this process (rows
+  // ordered byVDIM). These are constructed once on first use, since the probe points never
+  // move, and replace the GSLIB interpolation.
+  std::map<const mfem::ParFiniteElementSpace *, std::unique_ptr<mfem::SparseMatrix>>
+      probe_mats;
+
+  const mfem::SparseMatrix &GetProbeMatrix(const mfem::ParGridFunction &U);
 
 public:
   InterpolationOperator(const IoData &iodata, mfem::ParMesh &mesh);
 
   const auto &GetProbes() const { return op_idx; }
 
+  // Evaluate the field(s) at the probe points. The values for all fields and components
+  // are computed with a single global reduction.
   std::vector<std::complex<double>> ProbeField(const GridFunction &U);
+  std::vector<std::vector<std::complex<double>>>
+  ProbeFields(const std::vector<const GridFunction *> &U);
+
+  // Evaluate the field at only the probe points owned by this process, adding the values
+  // to the provided array of size GetProbes().size() * U.VectorDim(). The result must then
+  // be summed over all processes, which allows the reductions for several fields (for
+  // example the columns of a reduced-order basis) to be batched.
+  void AddProbeFieldLocal(const mfem::ParGridFunction &U, double *vals);
 };
 
 namespace fem
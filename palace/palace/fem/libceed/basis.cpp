@@ -3,6 +3,14 @@
 
 #include "basis.hpp"
 
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <tuple>
+#include <vector>
+#include <ceed/backend.h>
 #include <mfem.hpp>
 #include "utils/diagnostic.hpp"
 
@@ -84,6 +92,477 @@ void InitNonTensorBasis(const mfem::FiniteElement &fe, const mfem::IntegrationRu
   }
 }
 
+// Data for the sum-factorized application of H(curl) and H(div) bases on hexahedra. Each
+// vector component of the Nedelec and Raviart-Thomas elements is a tensor product of 1D
+// bases: component d uses the "own" 1D basis in direction d and the "other" one in the
+// remaining directions (open and closed for Nedelec, closed and open for Raviart-Thomas).
+struct TensorVectorBasisData
+{
+  // Number of 1D quadrature points and 1D basis sizes.
+  int Q, P_own, P_other;
+
+  // H(curl) (evaluates the curl) or H(div) (evaluates the divergence).
+  bool curl;
+
+  // 1D basis functions and derivatives at the quadrature points (Q x P, column-major).
+  std::vector<CeedScalar> B_own, G_own, B_other, G_other;
+
+  // Element degree of freedom and sign for each lexicographically ordered component basis
+  // function.
+  std::vector<CeedInt> dof;
+  std::vector<CeedScalar> sign;
+
+  int NumComponentDofs() const { return P_own * P_other * P_other; }
+
+  // 1D basis size and basis or derivative matrix for direction f of component d, with the
+  // derivative taken if f == e.
+  int Size(int d, int f) const { return (f == d) ? P_own : P_other; }
+  const CeedScalar *Matrix(int d, int f, int e) const
+  {
+    return (f == d) ? ((f == e) ? G_own.data() : B_own.data())
+                    : ((f == e) ? G_other.data() : B_other.data());
+  }
+};
+
+// Contribution to quadrature component r of the evaluation of a basis function of vector
+// component d, with derivative in direction e (none for e < 0) and sign s.
+struct TensorVectorBasisTerm
+{
+  int d, r, e;
+  CeedScalar s;
+};
+
+std::vector<TensorVectorBasisTerm> GetTensorVectorBasisTerms(bool curl,
+                                                             CeedEvalMode eval_mode)
+{
+  std::vector<TensorVectorBasisTerm> terms;
+  for (int d = 0; d < 3; d++)
+  {
+    if (eval_mode == CEED_EVAL_INTERP)
+    {
+      terms.push_back({d, d, -1, 1.0});
+    }
+    else if (curl)
+    {
+      // curl(uᵈ eᵈ) = ∇uᵈ x eᵈ, component r = ε(r, e, d) ∂ₑ uᵈ.
+      for (int e = 0; e < 3; e++)
+      {
+        if (e != d)
+        {
+          const int r = 3 - d - e;
+          terms.push_back({d, r, e, ((e - r + 3) % 3 == 1) ? 1.0 : -1.0});
+        }
+      }
+    }
+    else
+    {
+      terms.push_back({d, 0, d, 1.0});
+    }
+  }
+  return terms;
+}
+
+void Contract(const CeedScalar *M, int Q, bool transpose, int A, int B, int J, int C,
+              const CeedScalar *in, CeedScalar *out, bool add)
+{
+  // Computes out[a][j][c] (+)= Σ_b M(j, b) in[a][b][c], where M is the Q x P 1D matrix
+  // (column-major) or its transpose. The innermost index c includes the elements of the
+  // block, so the inner loop vectorizes.
+  for (int a = 0; a < A; a++)
+  {
+    for (int j = 0; j < J; j++)
+    {
+      CeedScalar *o = out + (a * J + j) * C;
+      if (!add)
+      {
+        std::fill(o, o + C, 0.0);
+      }
+      for (int b = 0; b < B; b++)
+      {
+        const CeedScalar m = transpose ? M[b + Q * j] : M[j + Q * b];
+        const CeedScalar *x = in + (a * B + b) * C;
+        for (int c = 0; c < C; c++)
+        {
+          o[c] += m * x[c];
+        }
+      }
+    }
+  }
+}
+
+void TensorContract(const TensorVectorBasisData &data, const TensorVectorBasisTerm &term,
+                    int ne, bool transpose, const CeedScalar *in, CeedScalar *out,
+                    CeedScalar *t1, CeedScalar *t2, bool add)
+{
+  // Apply the tensor product of 1D matrices for the given term, from the lexicographically
+  // ordered component coefficients [z][y][x][e] to the values at the quadrature points
+  // [qz][qy][qx][e], or the transpose.
+  const int Q = data.Q;
+  const int Px = data.Size(term.d, 0), Py = data.Size(term.d, 1), Pz = data.Size(term.d, 2);
+  const CeedScalar *Bx = data.Matrix(term.d, 0, term.e);
+  const CeedScalar *By = data.Matrix(term.d, 1, term.e);
+  const CeedScalar *Bz = data.Matrix(term.d, 2, term.e);
+  if (!transpose)
+  {
+    Contract(Bx, Q, false, Pz * Py, Px, Q, ne, in, t1, false);
+    Contract(By, Q, false, Pz, Py, Q, Q * ne, t1, t2, false);
+    Contract(Bz, Q, false, 1, Pz, Q, Q * Q * ne, t2, out, add);
+  }
+  else
+  {
+    Contract(Bx, Q, true, Q * Q, Q, Px, ne, in, t1, false);
+    Contract(By, Q, true, Q, Q, Py, Px * ne, t1, t2, false);
+    Contract(Bz, Q, true, 1, Q, Pz, Py * Px * ne, t2, out, add);
+  }
+}
+
+// Sum-factorized application of a single H(curl) or H(div) basis. The basis data is shared
+// between all bases for the same element and quadrature rule, while the work arrays belong
+// to each basis, which is only applied by the thread owning its Ceed context. They are
+// sized on first use for the element block size of the backend and then reused.
+class TensorVectorBasis
+{
+private:
+  std::shared_ptr<const TensorVectorBasisData> data;
+  std::vector<TensorVectorBasisTerm> interp_terms, deriv_terms;
+  std::vector<CeedScalar> x, y, t1, t2;
+
+public:
+  TensorVectorBasis(std::shared_ptr<const TensorVectorBasisData> data)
+    : data(std::move(data)),
+      interp_terms(GetTensorVectorBasisTerms(this->data->curl, CEED_EVAL_INTERP)),
+      deriv_terms(GetTensorVectorBasisTerms(
+          this->data->curl, this->data->curl ? CEED_EVAL_CURL : CEED_EVAL_DIV))
+  {
+  }
+
+  const TensorVectorBasisData &GetData() const { return *data; }
+
+  void Apply(int ne, int num_comp, bool transpose, CeedEvalMode eval_mode,
+             const CeedScalar *u, CeedScalar *v, bool add);
+};
+
+void TensorVectorBasis::Apply(int ne, int num_comp, bool transpose, CeedEvalMode eval_mode,
+                              const CeedScalar *u, CeedScalar *v, bool add)
+{
+  // Layout of the element vectors is [comp][dof][elem] and of the quadrature point vectors
+  // is [q_comp][comp][q][elem], matching the libCEED non-tensor basis application.
+  const auto &terms = (eval_mode == CEED_EVAL_INTERP) ? interp_terms : deriv_terms;
+  const int P = 3 * data->NumComponentDofs(), c_dofs = data->NumComponentDofs();
+  const int Q3 = data->Q * data->Q * data->Q;
+  const int q_comp = (eval_mode == CEED_EVAL_DIV) ? 1 : 3;
+  const int N = std::max({data->P_own, data->P_other, data->Q});
+  if (static_cast<int>(t1.size()) < N * N * N * ne)
+  {
+    x.resize(c_dofs * ne);
+    y.resize(Q3 * ne);
+    t1.resize(N * N * N * ne);
+    t2.resize(N * N * N * ne);
+  }
+  if (!add)
+  {
+    std::fill(v, v + (transpose ? num_comp * P * ne : q_comp * num_comp * Q3 * ne), 0.0);
+  }
+  for (int c = 0; c < num_comp; c++)
+  {
+    for (int d = 0; d < 3; d++)
+    {
+      const CeedInt *dof = data->dof.data() + d * c_dofs;
+      const CeedScalar *sign = data->sign.data() + d * c_dofs;
+      if (!transpose)
+      {
+        for (int l = 0; l < c_dofs; l++)
+        {
+          const CeedScalar *ul = u + (c * P + dof[l]) * ne;
+          for (int e = 0; e < ne; e++)
+          {
+            x[l * ne + e] = sign[l] * ul[e];
+          }
+        }
+        for (const auto &term : terms)
+        {
+          if (term.d != d)
+          {
+            continue;
+          }
+          TensorContract(*data, term, ne, false, x.data(), y.data(), t1.data(), t2.data(),
+                         false);
+          CeedScalar *vr = v + (term.r * num_comp + c) * Q3 * ne;
+          for (int k = 0; k < Q3 * ne; k++)
+          {
+            vr[k] += term.s * y[k];
+          }
+        }
+      }
+      else
+      {
+        std::fill(x.begin(), x.begin() + c_dofs * ne, 0.0);
+        for (const auto &term : terms)
+        {
+          if (term.d != d)
+          {
+            continue;
+          }
+          const CeedScalar *ur = u + (term.r * num_comp + c) * Q3 * ne;
+          for (int k = 0; k < Q3 * ne; k++)
+          {
+            y[k] = term.s * ur[k];
+          }
+          TensorContract(*data, term, ne, true, y.data(), x.data(), t1.data(), t2.data(),
+                         true);
+        }
+        for (int l = 0; l < c_dofs; l++)
+        {
+          CeedScalar *vl = v + (c * P + dof[l]) * ne;
+          for (int e = 0; e < ne; e++)
+          {
+            vl[e] += sign[l] * x[l * ne + e];
+          }
+        }
+      }
+    }
+  }
+}
+
+int CeedBasisDestroyTensorVector(CeedBasis basis)
+{
+  // The sum-factorized basis is stored as the backend data of the libCEED basis, and is
+  // destroyed together with it.
+  TensorVectorBasis *tensor_basis;
+  CeedCallBackend(CeedBasisGetData(basis, &tensor_basis));
+  delete tensor_basis;
+  CeedCallBackend(CeedBasisSetData(basis, nullptr));
+  return CEED_ERROR_SUCCESS;
+}
+
+int ApplyTensorVectorBasis(CeedBasis basis, CeedInt num_elem, CeedTransposeMode t_mode,
+                           CeedEvalMode eval_mode, CeedVector u, CeedVector v, bool add)
+{
+  Ceed ceed;
+  CeedInt num_comp, num_qpts;
+  CeedCallBackend(CeedBasisGetCeed(basis, &ceed));
+  CeedCallBackend(CeedBasisGetNumComponents(basis, &num_comp));
+  CeedCallBackend(CeedBasisGetNumQuadraturePoints(basis, &num_qpts));
+  TensorVectorBasis *tensor_basis;
+  CeedCallBackend(CeedBasisGetData(basis, &tensor_basis));
+  if (!tensor_basis)
+  {
+    return CeedError(ceed, CEED_ERROR_BACKEND, "Unknown tensor-product vector basis");
+  }
+  if (eval_mode == CEED_EVAL_WEIGHT)
+  {
+    if (t_mode == CEED_TRANSPOSE || add)
+    {
+      return CeedError(ceed, CEED_ERROR_BACKEND,
+                       "CEED_EVAL_WEIGHT incompatible with CEED_TRANSPOSE or ApplyAdd");
+    }
+    const CeedScalar *q_weight;
+    CeedScalar *v_array;
+    CeedCallBackend(CeedBasisGetQWeights(basis, &q_weight));
+    CeedCallBackend(CeedVectorGetArrayWrite(v, CEED_MEM_HOST, &v_array));
+    for (CeedInt i = 0; i < num_qpts; i++)
+    {
+      for (CeedInt e = 0; e < num_elem; e++)
+      {
+        v_array[i * num_elem + e] = q_weight[i];
+      }
+    }
+    CeedCallBackend(CeedVectorRestoreArray(v, &v_array));
+    return CEED_ERROR_SUCCESS;
+  }
+  const CeedEvalMode deriv_mode =
+      tensor_basis->GetData().curl ? CEED_EVAL_CURL : CEED_EVAL_DIV;
+  if (eval_mode != CEED_EVAL_INTERP && eval_mode != deriv_mode)
+  {
+    return CeedError(ceed, CEED_ERROR_BACKEND,
+                     "Unsupported evaluation mode for tensor-product vector basis");
+  }
+  const CeedScalar *u_array;
+  CeedScalar *v_array;
+  CeedCallBackend(CeedVectorGetArrayRead(u, CEED_MEM_HOST, &u_array));
+  if (add)
+  {
+    CeedCallBackend(CeedVectorGetArray(v, CEED_MEM_HOST, &v_array));
+  }
+  else
+  {
+    CeedCallBackend(CeedVectorGetArrayWrite(v, CEED_MEM_HOST, &v_array));
+  }
+  tensor_basis->Apply(num_elem, num_comp, t_mode == CEED_TRANSPOSE, eval_mode, u_array,
+                      v_array, add);
+  CeedCallBackend(CeedVectorRestoreArrayRead(u, &u_array));
+  CeedCallBackend(CeedVectorRestoreArray(v, &v_array));
+  return CEED_ERROR_SUCCESS;
+}
+
+int CeedBasisApplyTensorVector(CeedBasis basis, CeedInt num_elem, CeedTransposeMode t_mode,
+                               CeedEvalMode eval_mode, CeedVector u, CeedVector v)
+{
+  return ApplyTensorVectorBasis(basis, num_elem, t_mode, eval_mode, u, v, false);
+}
+
+int CeedBasisApplyAddTensorVector(CeedBasis basis, CeedInt num_elem,
+                                  CeedTransposeMode t_mode, CeedEvalMode eval_mode,
+                                  CeedVector u, CeedVector v)
+{
+  return ApplyTensorVectorBasis(basis, num_elem, t_mode, eval_mode, u, v, true);
+}
+
+std::unique_ptr<TensorVectorBasisData>
+BuildTensorVectorBasisData(const mfem::VectorTensorFiniteElement &fe,
+                           const mfem::IntegrationRule &ir)
+{
+  const mfem::DofToQuad &maps_c = fe.GetDofToQuad(ir, mfem::DofToQuad::TENSOR);
+  const mfem::DofToQuad &maps_o = fe.GetDofToQuadOpen(ir, mfem::DofToQuad::TENSOR);
+  const bool curl = (fe.GetMapType() == mfem::FiniteElement::H_CURL);
+  const mfem::DofToQuad &maps_own = curl ? maps_o : maps_c;
+  const mfem::DofToQuad &maps_other = curl ? maps_c : maps_o;
+  auto data = std::make_unique<TensorVectorBasisData>();
+  data->Q = maps_c.nqpt;
+  data->P_own = maps_own.ndof;
+  data->P_other = maps_other.ndof;
+  data->curl = curl;
+  auto copy = [](const mfem::Array<double> &A)
+  { return std::vector<CeedScalar>(A.HostRead(), A.HostRead() + A.Size()); };
+  data->B_own = copy(maps_own.B);
+  data->G_own = copy(maps_own.G);
+  data->B_other = copy(maps_other.B);
+  data->G_other = copy(maps_other.G);
+  const mfem::Array<int> &dof_map = fe.GetDofMap();
+  if (dof_map.Size() != 3 * data->NumComponentDofs())
+  {
+    return nullptr;
+  }
+  data->dof.resize(dof_map.Size());
+  data->sign.resize(dof_map.Size());
+  for (int l = 0; l < dof_map.Size(); l++)
+  {
+    data->dof[l] = (dof_map[l] >= 0) ? dof_map[l] : -1 - dof_map[l];
+    data->sign[l] = (dof_map[l] >= 0) ? 1.0 : -1.0;
+  }
+  return data;
+}
+
+bool VerifyTensorVectorBasis(const TensorVectorBasisData &data, const mfem::DofToQuad &maps)
+{
+  // Check the tensor-product basis against the dense interpolation and curl or divergence
+  // matrices of the element, which also verifies the lexicographic ordering and signs of
+  // the basis functions.
+  const int P = maps.ndof, Q = maps.nqpt, Q1d = data.Q, c_dofs = data.NumComponentDofs();
+  if (P != 3 * c_dofs || Q != Q1d * Q1d * Q1d)
+  {
+    return false;
+  }
+  double max_val = 1.0;
+  for (const auto *A : {&maps.Bt, &maps.Gt})
+  {
+    for (int k = 0; k < A->Size(); k++)
+    {
+      max_val = std::max(max_val, std::abs((*A)[k]));
+    }
+  }
+  const double tol = 1.0e-10 * max_val;
+  const CeedEvalMode deriv_mode = data.curl ? CEED_EVAL_CURL : CEED_EVAL_DIV;
+  for (const auto eval_mode : {CEED_EVAL_INTERP, deriv_mode})
+  {
+    const auto terms = GetTensorVectorBasisTerms(data.curl, eval_mode);
+    const mfem::Array<double> &At = (eval_mode == CEED_EVAL_INTERP) ? maps.Bt : maps.Gt;
+    const int q_comp = (eval_mode == CEED_EVAL_DIV) ? 1 : 3;
+    std::vector<double> A(q_comp * Q * P, 0.0);
+    for (const auto &term : terms)
+    {
+      for (int l = 0; l < c_dofs; l++)
+      {
+        const int i = l % data.Size(term.d, 0);
+        const int j = (l / data.Size(term.d, 0)) % data.Size(term.d, 1);
+        const int k = l / (data.Size(term.d, 0) * data.Size(term.d, 1));
+        const int o = data.dof[term.d * c_dofs + l];
+        const double s = term.s * data.sign[term.d * c_dofs + l];
+        const CeedScalar *Bx = data.Matrix(term.d, 0, term.e);
+        const CeedScalar *By = data.Matrix(term.d, 1, term.e);
+        const CeedScalar *Bz = data.Matrix(term.d, 2, term.e);
+        for (int q = 0; q < Q; q++)
+        {
+          const int qx = q % Q1d, qy = (q / Q1d) % Q1d, qz = q / (Q1d * Q1d);
+          A[o + P * (q + Q * term.r)] +=
+              s * Bx[qx + Q1d * i] * By[qy + Q1d * j] * Bz[qz + Q1d * k];
+        }
+      }
+    }
+    if (At.Size() != static_cast<int>(A.size()))
+    {
+      return false;
+    }
+    for (std::size_t k = 0; k < A.size(); k++)
+    {
+      if (std::abs(A[k] - At[k]) > tol)
+      {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+void InitTensorVectorBasis(const mfem::FiniteElement &fe, const mfem::IntegrationRule &ir,
+                           Ceed ceed, CeedBasis basis)
+{
+  // For Nedelec and Raviart-Thomas elements on hexahedra, replace the application of the
+  // dense basis with sum factorization, reducing the cost per element from O(p⁶) to
+  // O(p⁴). The dense matrices are still used by libCEED for operator assembly. This is
+  // only available for CPU backends, which apply the basis on the host.
+  CeedMemType mem;
+  PalaceCeedCall(ceed, CeedGetPreferredMemType(ceed, &mem));
+  const auto *tfe = dynamic_cast<const mfem::VectorTensorFiniteElement *>(&fe);
+  if (mem != CEED_MEM_HOST || !tfe || fe.GetGeomType() != mfem::Geometry::CUBE ||
+      (fe.GetMapType() != mfem::FiniteElement::H_CURL &&
+       fe.GetMapType() != mfem::FiniteElement::H_DIV))
+  {
+    return;
+  }
+
+  // The basis data only depends on the element and quadrature rule, and is shared between
+  // all bases (and threads) using them. It is checked against the dense basis before use.
+  static std::map<std::tuple<int, int, int, int>,
+                  std::shared_ptr<const TensorVectorBasisData>>
+      basis_data;
+  static std::mutex basis_data_mutex;
+  std::shared_ptr<const TensorVectorBasisData> data;
+  {
+    std::lock_guard<std::mutex> lock(basis_data_mutex);
+    const auto key =
+        std::make_tuple(fe.GetMapType(), fe.GetOrder(), tfe->GetBasisType(), ir.GetOrder());
+    auto it = basis_data.find(key);
+    if (it == basis_data.end())
+    {
+      it = basis_data.emplace(key, BuildTensorVectorBasisData(*tfe, ir)).first;
+    }
+    data = it->second;
+  }
+  if (!data || !VerifyTensorVectorBasis(*data, fe.GetDofToQuad(ir, mfem::DofToQuad::FULL)))
+  {
+    return;
+  }
+
+  // The sum-factorized basis, which owns its own work arrays, is attached to the libCEED
+  // basis as its backend data, and the backend's application and destroy functions are
+  // replaced. This is only done when the backend keeps no data of its own for the basis,
+  // which would otherwise be lost along with the backend's destroy function.
+  void *backend_data;
+  PalaceCeedCall(ceed, CeedBasisGetData(basis, &backend_data));
+  if (backend_data)
+  {
+    return;
+  }
+  PalaceCeedCall(ceed, CeedBasisSetData(basis, new TensorVectorBasis(std::move(data))));
+  PalaceCeedCall(ceed, CeedSetBackendFunction(ceed, "Basis", basis, "Apply",
+                                              CeedBasisApplyTensorVector));
+  PalaceCeedCall(ceed, CeedSetBackendFunction(ceed, "Basis", basis, "ApplyAdd",
+                                              CeedBasisApplyAddTensorVector));
+  PalaceCeedCall(ceed, CeedSetBackendFunction(ceed, "Basis", basis, "Destroy",
+                                              CeedBasisDestroyTensorVector));
+}
+
 PalacePragmaDiagnosticPush
 PalacePragmaDiagnosticDisableUnused
 
@@ -182,6 +661,10 @@ void InitBasis(const mfem::FiniteElement &fe, const mfem::IntegrationRule &ir,
   else
   {
     InitNonTensorBasis(fe, ir, num_comp, ceed, basis);
+    if (tensor)
+    {
+      InitTensorVectorBasis(fe, ir, ceed, *basis);
+    }
   }
 }
 
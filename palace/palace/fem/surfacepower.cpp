@@ -0,0 +1,175 @@
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "surfacepower.hpp"
+
+#include "fem/coefficient.hpp"
+#include "fem/gridfunction.hpp"
+#include "fem/integrator.hpp"
+#include "models/materialoperator.hpp"
+#include "utils/geodata.hpp"
+
+namespace palace
+{
+
+namespace
+{
+
+void AddElementMatrix(const mfem::Array<int> &rows, const mfem::Array<int> &cols,
+                      const mfem::DenseMatrix &elmat, mfem::SparseMatrix &A)
+{
+  // Negative indices indicate degrees of freedom with flipped orientation.
+  for (int j = 0; j < cols.Size(); j++)
+  {
+    const int c = (cols[j] >= 0) ? cols[j] : -1 - cols[j];
+    for (int i = 0; i < rows.Size(); i++)
+    {
+      const int r = (rows[i] >= 0) ? rows[i] : -1 - rows[i];
+      const double a = elmat(i, j);
+      A.Add(r, c, ((rows[i] >= 0) == (cols[j] >= 0)) ? a : -a);
+    }
+  }
+}
+
+}  // namespace
+
+SurfacePowerOperator::SurfacePowerOperator(mfem::ParFiniteElementSpace &nd_fespace,
+                                           mfem::ParFiniteElementSpace &rt_fespace,
+                                           const MaterialOperator &mat_op,
+                                           const mfem::Array<int> &attr_list)
+{
+  // The power is integrated as (E x H) ⋅ n = E ⋅ (-n x H) over the boundary elements of the
+  // surface, using the same quadrature and orientation conventions as the linear form with
+  // BdrSurfaceCurrentVectorCoefficient. For two-sided internal boundaries, this uses
+  // H = μ⁻¹ (B1 - B2) where n points into element 1. The sign is included in the assembled
+  // matrices.
+  auto &mesh = *nd_fespace.GetParMesh();
+  mesh.ExchangeFaceNbrData();
+  rt_fespace.ExchangeFaceNbrData();
+  const int sdim = mesh.SpaceDimension();
+  const int ne = mesh.GetNE();
+  int bdr_attr_max = mesh.bdr_attributes.Size() ? mesh.bdr_attributes.Max() : 0;
+  mfem::Array<int> attr_marker = mesh::AttrToMarker(bdr_attr_max, attr_list);
+  K = std::make_unique<mfem::SparseMatrix>(nd_fespace.GetVSize(), rt_fespace.GetVSize());
+  K_nbr = std::make_unique<mfem::SparseMatrix>(nd_fespace.GetVSize(),
+                                               rt_fespace.GetFaceNbrVSize());
+
+  mfem::FaceElementTransformations FET;
+  mfem::IsoparametricTransformation T1, T2;
+  mfem::DenseMatrix nd_vshape, rt_vshape, elmat, elmat_t;
+  mfem::Vector normal(sdim), u(sdim), Hj(sdim), col;
+  mfem::Array<int> nd_vdofs, rt_vdofs;
+  for (int i = 0; i < mesh.GetNBE(); i++)
+  {
+    if (!attr_marker[mesh.GetBdrAttribute(i) - 1])
+    {
+      continue;
+    }
+    const mfem::FiniteElement &nd_fe = *nd_fespace.GetBE(i);
+    const mfem::DofTransformation *nd_trans = nd_fespace.GetBdrElementVDofs(i, nd_vdofs);
+    mfem::ElementTransformation &T = *mesh.GetBdrElementTransformation(i);
+    const int q_order = fem::DefaultIntegrationOrder::Get(T);
+    const mfem::IntegrationRule &ir = mfem::IntRules.Get(nd_fe.GetGeomType(), q_order);
+    BdrGridFunctionCoefficient::GetBdrElementNeighborTransformations(i, mesh, FET, T1, T2);
+    const int nsides = FET.Elem2 ? 2 : 1;
+    for (int side = 0; side < nsides; side++)
+    {
+      // Element matrix coupling the boundary element Nedelec degrees of freedom to the
+      // Raviart-Thomas degrees of freedom of the neighboring element on this side.
+      const int e = (side == 0) ? FET.Elem1->ElementNo : FET.Elem2->ElementNo;
+      const bool nbr = (e >= ne);
+      const mfem::FiniteElement &rt_fe =
+          nbr ? *rt_fespace.GetFaceNbrFE(e - ne) : *rt_fespace.GetFE(e);
+      const mfem::DofTransformation *rt_trans =
+          nbr ? rt_fespace.GetFaceNbrElementVDofs(e - ne, rt_vdofs)
+              : rt_fespace.GetElementVDofs(e, rt_vdofs);
+      nd_vshape.SetSize(nd_fe.GetDof(), sdim);
+      rt_vshape.SetSize(rt_fe.GetDof(), sdim);
+      elmat.SetSize(nd_fe.GetDof(), rt_fe.GetDof());
+      elmat = 0.0;
+      for (int q = 0; q < ir.GetNPoints(); q++)
+      {
+        const mfem::IntegrationPoint &ip = ir.IntPoint(q);
+        T.SetIntPoint(&ip);
+        bool ori = BdrGridFunctionCoefficient::GetBdrElementNeighborTransformations(
+            i, mesh, FET, T1, T2, &ip);
+        mfem::ElementTransformation &Te = (side == 0) ? *FET.Elem1 : *FET.Elem2;
+        const auto muinv = mat_op.GetInvPermeability(Te.Attribute);
+        nd_fe.CalcVShape(T, nd_vshape);
+        rt_fe.CalcVShape(Te, rt_vshape);
+        BdrGridFunctionCoefficient::GetNormal(T, normal, ori);
+        const double w = ((side == 0) ? -1.0 : 1.0) * ip.weight * T.Weight();
+        for (int j = 0; j < rt_vshape.Height(); j++)
+        {
+          rt_vshape.GetRow(j, u);
+          muinv.Mult(u, Hj);
+          BdrGridFunctionCoefficient::Cross3(normal, Hj, u);
+          for (int k = 0; k < nd_vshape.Height(); k++)
+          {
+            double dot = 0.0;
+            for (int d = 0; d < sdim; d++)
+            {
+              dot += nd_vshape(k, d) * u(d);
+            }
+            elmat(k, j) += w * dot;
+          }
+        }
+      }
+
+      // Apply the degree of freedom transformations for both spaces, so that the matrix
+      // acts directly on the local degrees of freedom of the grid functions.
+      if (nd_trans)
+      {
+        for (int j = 0; j < elmat.Width(); j++)
+        {
+          elmat.GetColumnReference(j, col);
+          nd_trans->TransformDual(col);
+        }
+      }
+      if (rt_trans)
+      {
+        elmat_t.Transpose(elmat);
+        for (int k = 0; k < elmat_t.Width(); k++)
+        {
+          elmat_t.GetColumnReference(k, col);
+          rt_trans->TransformDual(col);
+        }
+        elmat.Transpose(elmat_t);
+      }
+      AddElementMatrix(nd_vdofs, rt_vdofs, elmat, nbr ? *K_nbr : *K);
+    }
+  }
+  K->Finalize();
+  K_nbr->Finalize();
+}
+
+void SurfacePowerOperator::AddMult(const mfem::ParGridFunction &B, mfem::Vector &y) const
+{
+  K->AddMult(B, y);
+  if (K_nbr->Width() > 0)
+  {
+    K_nbr->AddMult(B.FaceNbrData(), y);
+  }
+}
+
+std::complex<double> SurfacePowerOperator::GetLocalPower(const GridFunction &E,
+                                                         const GridFunction &B) const
+{
+  // For K including the sign, P = Eᵀ K B⋆ with E and B the local degrees of freedom.
+  MFEM_VERIFY(E.HasImag() == B.HasImag(),
+              "Mismatch between real- and complex-valued E and B fields in port power "
+              "calculation!");
+  mfem::Vector yr(K->Height());
+  yr = 0.0;
+  AddMult(B.Real(), yr);
+  if (E.HasImag())
+  {
+    mfem::Vector yi(K->Height());
+    yi = 0.0;
+    AddMult(B.Imag(), yi);
+    return {E.Real() * yr + E.Imag() * yi, E.Imag() * yr - E.Real() * yi};
+  }
+  return E.Real() * yr;
+}
+
+}  // namespace palace
@@ -0,0 +1,48 @@
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef PALACE_FEM_SURFACE_POWER_HPP
+#define PALACE_FEM_SURFACE_POWER_HPP
+
+#include <complex>
+#include <memory>
+#include <mfem.hpp>
+
+namespace palace
+{
+
+class GridFunction;
+class MaterialOperator;
+
+//
+// A class for computing the power flux P = ∫ (E x H⋆) ⋅ n dS through a surface, with
+// H = μ⁻¹ B. The power is bilinear in E and B, so the boundary coupling between the
+// electric field (Nedelec) and magnetic flux density (Raviart-Thomas) spaces is assembled
+// once as a sparse matrix on the local degrees of freedom, after which each evaluation is
+// a sparse matrix-vector product and a dot product.
+//
+class SurfacePowerOperator
+{
+private:
+  // Coupling matrices between the local Nedelec degrees of freedom and the local and face
+  // neighbor Raviart-Thomas degrees of freedom, respectively. The magnetic flux density on
+  // two-sided internal boundaries is evaluated from both neighboring elements, which may
+  // belong to another process.
+  std::unique_ptr<mfem::SparseMatrix> K, K_nbr;
+
+  void AddMult(const mfem::ParGridFunction &B, mfem::Vector &y) const;
+
+public:
+  SurfacePowerOperator(mfem::ParFiniteElementSpace &nd_fespace,
+                       mfem::ParFiniteElementSpace &rt_fespace,
+                       const MaterialOperator &mat_op, const mfem::Array<int> &attr_list);
+
+  // Return the contribution of the local process to the power through the surface, where
+  // +n is the direction of propagation (into the domain), without the global reduction
+  // across processes. Requires that the face neighbor data of B has been exchanged.
+  std::complex<double> GetLocalPower(const GridFunction &E, const GridFunction &B) const;
+};
+
+}  // namespace palace
+
+#endif  // PALACE_FEM_SURFACE_POWER_HPP
@@ -3,6 +3,7 @@
 
 #include "errorestimator.hpp"
 
+#include <algorithm>
 #include <limits>
 #include "fem/bilinearform.hpp"
 #include "fem/integrator.hpp"
@@ -62,6 +63,78 @@ auto BuildLevelParOperator(std::unique_ptr<Operator> &&a, const FiniteElementSpa
   return BuildLevelParOperator<OperType>(std::move(a), fespace, fespace);
 }
 
+// Workspace objects for computing the element recovery operators for local flux recovery.
+struct LocalRecoveryWorkspace
+{
+  mfem::IsoparametricTransformation T;
+  mfem::DofTransformation smooth_trans, rhs_trans;
+  mfem::DenseMatrix smooth_vshape, rhs_vshape, rhs_cvshape, M_K, B_K, R_Kt;
+  mfem::DenseMatrixInverse M_K_inv;
+  mfem::Vector col;
+};
+
+void GetElementRecoveryOperator(const mfem::ParFiniteElementSpace &smooth_fespace,
+                                const mfem::ParFiniteElementSpace &rhs_fespace, int e,
+                                const mfem::IntegrationRule &ir, const mfem::DenseMatrix &C,
+                                LocalRecoveryWorkspace &w, mfem::Array<int> &smooth_vdofs,
+                                mfem::Array<int> &rhs_vdofs, mfem::DenseMatrix &R_K)
+{
+  // Compute the element recovery operator R_K = M_K⁻¹ B_K, where M_K is the mass matrix of
+  // the smooth space and B_K is the mixed mass matrix with the material coefficient on
+  // element K. The degree of freedom transformations for both spaces are included so that
+  // R_K acts directly on the local degrees of freedom.
+  const mfem::ParMesh &pmesh = *smooth_fespace.GetParMesh();
+  const mfem::FiniteElement &smooth_fe = *smooth_fespace.GetFE(e);
+  const mfem::FiniteElement &rhs_fe = *rhs_fespace.GetFE(e);
+  const int ns = smooth_fe.GetDof(), nr = rhs_fe.GetDof();
+  const int sdim = pmesh.SpaceDimension();
+  pmesh.GetElementTransformation(e, &w.T);
+  w.smooth_vshape.SetSize(ns, sdim);
+  w.rhs_vshape.SetSize(nr, sdim);
+  w.rhs_cvshape.SetSize(nr, sdim);
+  w.M_K.SetSize(ns, ns);
+  w.B_K.SetSize(ns, nr);
+  w.M_K = 0.0;
+  w.B_K = 0.0;
+  for (int q = 0; q < ir.GetNPoints(); q++)
+  {
+    const mfem::IntegrationPoint &ip = ir.IntPoint(q);
+    w.T.SetIntPoint(&ip);
+    smooth_fe.CalcVShape(w.T, w.smooth_vshape);
+    rhs_fe.CalcVShape(w.T, w.rhs_vshape);
+    mfem::MultABt(w.rhs_vshape, C, w.rhs_cvshape);
+    const double wt = ip.weight * w.T.Weight();
+    mfem::AddMult_a_AAt(wt, w.smooth_vshape, w.M_K);
+    mfem::AddMult_a_ABt(wt, w.smooth_vshape, w.rhs_cvshape, w.B_K);
+  }
+  w.M_K_inv.Factor(w.M_K);
+  R_K.SetSize(ns, nr);
+  w.M_K_inv.Mult(w.B_K, R_K);
+
+  // Primal transformation for the range, and inverse primal transformation for the domain
+  // (applied as the dual transformation of the transpose).
+  smooth_fespace.GetElementVDofs(e, smooth_vdofs, w.smooth_trans);
+  if (!w.smooth_trans.IsIdentity())
+  {
+    for (int j = 0; j < nr; j++)
+    {
+      R_K.GetColumnReference(j, w.col);
+      w.smooth_trans.TransformPrimal(w.col);
+    }
+  }
+  rhs_fespace.GetElementVDofs(e, rhs_vdofs, w.rhs_trans);
+  if (!w.rhs_trans.IsIdentity())
+  {
+    w.R_Kt.Transpose(R_K);
+    for (int i = 0; i < ns; i++)
+    {
+      w.R_Kt.GetColumnReference(i, w.col);
+      w.rhs_trans.TransformDual(w.col);
+    }
+    R_K.Transpose(w.R_Kt);
+  }
+}
+
 template <typename OperType>
 auto ConfigureLinearSolver(const FiniteElementSpaceHierarchy &fespaces, double tol,
                            int max_it, int print, bool use_mg)
@@ -107,10 +180,15 @@ template <typename VecType>
 FluxProjector<VecType>::FluxProjector(const MaterialPropertyCoefficient &coeff,
                                       const FiniteElementSpaceHierarchy &smooth_fespaces,
                                       const FiniteElementSpace &rhs_fespace, double tol,
-                                      int max_it, int print, bool use_mg)
+                                      int max_it, int print, bool use_mg, bool use_local)
+  : smooth_fespace(smooth_fespaces.GetFinestFESpace()), rhs_fespace(rhs_fespace)
 {
   BlockTimer bt(Timer::CONSTRUCT_ESTIMATOR);
-  const auto &smooth_fespace = smooth_fespaces.GetFinestFESpace();
+  if (use_local)
+  {
+    AssembleLocal(coeff);
+    return;
+  }
   {
     constexpr bool skip_zeros = false;
     BilinearForm m(smooth_fespace);
@@ -145,10 +223,121 @@ FluxProjector<VecType>::FluxProjector(const MaterialPropertyCoefficient &coeff,
   rhs.UseDevice(true);
 }
 
+template <typename VecType>
+void FluxProjector<VecType>::AssembleLocal(const MaterialPropertyCoefficient &coeff)
+{
+  // Set up the quadrature rule for each element geometry and the material property for each
+  // element. The element recovery operators are not stored, but computed on the fly for
+  // each application of the projector, so that the memory required is independent of the
+  // element order.
+  const auto &mesh = smooth_fespace.GetMesh();
+  const mfem::ParMesh &pmesh = mesh.Get();
+  const int ne = pmesh.GetNE();
+  const auto &loc_attr = mesh.GetCeedAttributes();
+  const auto &attr_mat = coeff.GetAttributeToMaterial();
+  irs.assign(mfem::Geometry::NUM_GEOMETRIES, nullptr);
+  elem_mat.resize(ne);
+  for (int e = 0; e < ne; e++)
+  {
+    const auto geom = pmesh.GetElementGeometry(e);
+    if (!irs[geom])
+    {
+      irs[geom] = &mfem::IntRules.Get(geom, fem::DefaultIntegrationOrder::Get(pmesh, geom));
+    }
+    elem_mat[e] = attr_mat[loc_attr.at(pmesh.GetAttribute(e)) - 1];
+    MFEM_VERIFY(elem_mat[e] >= 0, "Missing material property for local flux recovery!");
+  }
+  mat_coeff = coeff.GetMaterialProperties();
+
+  // The averaging of shared degrees of freedom uses the multiplicity of each local degree
+  // of freedom of the smooth space, summed over all processes.
+  Vector mult(smooth_fespace.GetVSize());
+  mult = 0.0;
+  auto *h_mult = mult.HostReadWrite();
+  mfem::Array<int> vdofs;
+  for (int e = 0; e < ne; e++)
+  {
+    smooth_fespace.Get().GetElementVDofs(e, vdofs);
+    for (int i = 0; i < vdofs.Size(); i++)
+    {
+      const int j = vdofs[i];
+      h_mult[(j >= 0) ? j : -1 - j] += 1.0;
+    }
+  }
+  inv_mult.SetSize(smooth_fespace.GetTrueVSize());
+  smooth_fespace.GetProlongationMatrix()->MultTranspose(mult, inv_mult);
+  inv_mult.Reciprocal();
+  inv_mult.UseDevice(true);
+  x_loc.SetSize(rhs_fespace.GetVSize());
+  y_loc.SetSize(smooth_fespace.GetVSize());
+  x_loc.UseDevice(true);
+  y_loc.UseDevice(true);
+}
+
+template <typename VecType>
+void FluxProjector<VecType>::MultLocal(const Vector &x, Vector &y) const
+{
+  // Compute and apply the element recovery operators and sum the contributions to each
+  // local degree of freedom, then sum over processes (only requires communication between
+  // neighbors) and divide by the multiplicity.
+  const mfem::ParFiniteElementSpace &smooth_pfespace = smooth_fespace.Get();
+  const mfem::ParFiniteElementSpace &rhs_pfespace = rhs_fespace.Get();
+  const mfem::ParMesh &pmesh = smooth_fespace.GetMesh().Get();
+  rhs_fespace.GetProlongationMatrix()->Mult(x, x_loc);
+  const double *h_x = x_loc.HostRead();
+  double *h_y = y_loc.HostWrite();
+  std::fill_n(h_y, y_loc.Size(), 0.0);
+  const int ne = static_cast<int>(elem_mat.size());
+  PalacePragmaOmp(parallel)
+  {
+    LocalRecoveryWorkspace w;
+    mfem::Array<int> s_dofs, r_dofs;
+    mfem::DenseMatrix R_K;
+    mfem::Vector xe, ye;
+    PalacePragmaOmp(for schedule(static))
+    for (int e = 0; e < ne; e++)
+    {
+      GetElementRecoveryOperator(smooth_pfespace, rhs_pfespace, e,
+                                 *irs[pmesh.GetElementGeometry(e)], mat_coeff(elem_mat[e]),
+                                 w, s_dofs, r_dofs, R_K);
+      const int ns = s_dofs.Size(), nr = r_dofs.Size();
+      xe.SetSize(nr);
+      ye.SetSize(ns);
+      for (int j = 0; j < nr; j++)
+      {
+        const int k = r_dofs[j];
+        xe(j) = (k >= 0) ? h_x[k] : -h_x[-1 - k];
+      }
+      R_K.Mult(xe, ye);
+      for (int i = 0; i < ns; i++)
+      {
+        const int k = s_dofs[i];
+        PalacePragmaOmp(atomic update)
+        h_y[(k >= 0) ? k : -1 - k] += (k >= 0) ? ye(i) : -ye(i);
+      }
+    }
+  }
+  smooth_fespace.GetProlongationMatrix()->MultTranspose(y_loc, y);
+  y *= inv_mult;
+}
+
 template <typename VecType>
 void FluxProjector<VecType>::Mult(const VecType &x, VecType &y) const
 {
   BlockTimer bt(Timer::SOLVE_ESTIMATOR);
+  if (!ksp)
+  {
+    if constexpr (std::is_same<VecType, ComplexVector>::value)
+    {
+      MultLocal(x.Real(), y.Real());
+      MultLocal(x.Imag(), y.Imag());
+    }
+    else
+    {
+      MultLocal(x, y);
+    }
+    return;
+  }
   MFEM_ASSERT(x.Size() == Flux->Width() && y.Size() == rhs.Size(),
               "Invalid vector dimensions for FluxProjector::Mult!");
   // Mpi::Print(" Computing smooth flux recovery (projection) for error estimation\n");
@@ -253,11 +442,11 @@ template <typename VecType>
 GradFluxErrorEstimator<VecType>::GradFluxErrorEstimator(
     const MaterialOperator &mat_op, FiniteElementSpace &nd_fespace,
     FiniteElementSpaceHierarchy &rt_fespaces, double tol, int max_it, int print,
-    bool use_mg)
+    bool use_mg, bool use_local)
   : nd_fespace(nd_fespace), rt_fespace(rt_fespaces.GetFinestFESpace()),
     projector(MaterialPropertyCoefficient(mat_op.GetAttributeToMaterial(),
                                           mat_op.GetPermittivityReal()),
-              rt_fespaces, nd_fespace, tol, max_it, print, use_mg),
+              rt_fespaces, nd_fespace, tol, max_it, print, use_mg, use_local),
     integ_op(nd_fespace.GetMesh().GetNE(), nd_fespace.GetVSize()),
     E_gf(nd_fespace.GetVSize()), D(rt_fespace.GetTrueVSize()), D_gf(rt_fespace.GetVSize())
 {
@@ -372,11 +561,11 @@ template <typename VecType>
 CurlFluxErrorEstimator<VecType>::CurlFluxErrorEstimator(
     const MaterialOperator &mat_op, FiniteElementSpace &rt_fespace,
     FiniteElementSpaceHierarchy &nd_fespaces, double tol, int max_it, int print,
-    bool use_mg)
+    bool use_mg, bool use_local)
   : rt_fespace(rt_fespace), nd_fespace(nd_fespaces.GetFinestFESpace()),
     projector(MaterialPropertyCoefficient(mat_op.GetAttributeToMaterial(),
                                           mat_op.GetInvPermeability()),
-              nd_fespaces, rt_fespace, tol, max_it, print, use_mg),
+              nd_fespaces, rt_fespace, tol, max_it, print, use_mg, use_local),
     integ_op(nd_fespace.GetMesh().GetNE(), rt_fespace.GetVSize()),
     B_gf(rt_fespace.GetVSize()), H(nd_fespace.GetTrueVSize()), H_gf(nd_fespace.GetVSize())
 {
@@ -485,11 +674,11 @@ template <typename VecType>
 TimeDependentFluxErrorEstimator<VecType>::TimeDependentFluxErrorEstimator(
     const MaterialOperator &mat_op, FiniteElementSpaceHierarchy &nd_fespaces,
     FiniteElementSpaceHierarchy &rt_fespaces, double tol, int max_it, int print,
-    bool use_mg)
+    bool use_mg, bool use_local)
   : grad_estimator(mat_op, nd_fespaces.GetFinestFESpace(), rt_fespaces, tol, max_it, print,
-                   use_mg),
+                   use_mg, use_local),
     curl_estimator(mat_op, rt_fespaces.GetFinestFESpace(), nd_fespaces, tol, max_it, print,
-                   use_mg)
+                   use_mg, use_local)
 {
 }
 
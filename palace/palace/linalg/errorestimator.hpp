@@ -5,6 +5,7 @@
 #define PALACE_LINALG_ERROR_ESTIMATOR_HPP
 
 #include <memory>
+#include <vector>
 #include <mfem.hpp>
 #include "fem/errorindicator.hpp"
 #include "fem/fespace.hpp"
@@ -21,7 +22,8 @@ class MaterialOperator;
 
 //
 // Classes used in the estimation of element-wise solution errors via a global L2 projection
-// of a discontinuous flux onto a smooth space (flux recovery).
+// of a discontinuous flux onto a smooth space (flux recovery), or optionally a local
+// element-wise projection followed by averaging of shared degrees of freedom.
 //
 
 template <typename VecType>
@@ -29,7 +31,10 @@ class TimeDependentFluxErrorEstimator;
 
 // This solver computes a smooth recovery of a discontinuous flux. The difference between
 // this resulting smooth flux and the original non-smooth flux provides a localizable error
-// estimate.
+// estimate. When use_local is true, the global projection is replaced by the L2 projection
+// onto the smooth space on each element, with the values of degrees of freedom shared
+// between elements averaged. This requires no linear solve and only communication between
+// neighboring processes.
 template <typename VecType>
 class FluxProjector
 {
@@ -37,20 +42,36 @@ class FluxProjector
                                              ComplexOperator, Operator>::type;
 
 private:
+  // Finite element spaces for the smooth and discontinuous fluxes.
+  const FiniteElementSpace &smooth_fespace, &rhs_fespace;
+
   // Operator for the mass matrix inversion.
   std::unique_ptr<OperType> Flux, M;
 
   // Linear solver and preconditioner for the projected linear system.
   std::unique_ptr<BaseKspSolver<OperType>> ksp;
 
-  // Workspace object for solver application.
+  // Data for computing the element recovery operators R_K = M_K⁻¹ B_K for the local flux
+  // recovery: the quadrature rule for each geometry, the material index of each element,
+  // and the material properties. Also the inverse multiplicity of the smooth space true
+  // degrees of freedom.
+  std::vector<const mfem::IntegrationRule *> irs;
+  std::vector<int> elem_mat;
+  mfem::DenseTensor mat_coeff;
+  Vector inv_mult;
+
+  // Workspace objects for solver application.
   mutable VecType rhs;
+  mutable Vector x_loc, y_loc;
+
+  void AssembleLocal(const MaterialPropertyCoefficient &coeff);
+  void MultLocal(const Vector &x, Vector &y) const;
 
 public:
   FluxProjector(const MaterialPropertyCoefficient &coeff,
                 const FiniteElementSpaceHierarchy &smooth_fespaces,
                 const FiniteElementSpace &rhs_fespace, double tol, int max_it, int print,
-                bool use_mg);
+                bool use_mg, bool use_local);
 
   void Mult(const VecType &x, VecType &y) const;
 };
@@ -66,7 +87,7 @@ private:
   // Finite element spaces used to represent E and the recovered D.
   const FiniteElementSpace &nd_fespace, &rt_fespace;
 
-  // Global L2 projection solver.
+  // L2 projection solver for the flux recovery.
   FluxProjector<VecType> projector;
 
   // Operator which performs the integration of the flux error on each element.
@@ -78,7 +99,7 @@ private:
 public:
   GradFluxErrorEstimator(const MaterialOperator &mat_op, FiniteElementSpace &nd_fespace,
                          FiniteElementSpaceHierarchy &rt_fespaces, double tol, int max_it,
-                         int print, bool use_mg);
+                         int print, bool use_mg, bool use_local);
 
   // Compute elemental error indicators given the electric field as a vector of true dofs,
   // and fold into an existing indicator. The indicators are nondimensionalized using the
@@ -98,7 +119,7 @@ private:
   // Finite element space used to represent B and the recovered H.
   const FiniteElementSpace &rt_fespace, &nd_fespace;
 
-  // Global L2 projection solver.
+  // L2 projection solver for the flux recovery.
   FluxProjector<VecType> projector;
 
   // Operator which performs the integration of the flux error on each element.
@@ -110,7 +131,7 @@ private:
 public:
   CurlFluxErrorEstimator(const MaterialOperator &mat_op, FiniteElementSpace &rt_fespace,
                          FiniteElementSpaceHierarchy &nd_fespaces, double tol, int max_it,
-                         int print, bool use_mg);
+                         int print, bool use_mg, bool use_local);
 
   // Compute elemental error indicators given the magnetic flux density as a vector of true
   // dofs, and fold into an existing indicator. The indicators are nondimensionalized using
@@ -133,7 +154,7 @@ public:
   TimeDependentFluxErrorEstimator(const MaterialOperator &mat_op,
                                   FiniteElementSpaceHierarchy &nd_fespaces,
                                   FiniteElementSpaceHierarchy &rt_fespaces, double tol,
-                                  int max_it, int print, bool use_mg);
+                                  int max_it, int print, bool use_mg, bool use_local);
 
   // Compute elemental error indicators given the electric field and magnetic flux density
   // as a vectors of true dofs, and fold into an existing indicator. The indicators are
@@ -93,6 +93,47 @@ namespace
 
 static HypreVector X, Y;
 
+// Return a pointer to the real and imaginary parts of a complex-valued vector when they are
+// stored contiguously as a two-column block, or nullptr otherwise. Multivector products are
+// only used for host execution.
+const double *ReadBlock(const ComplexVector &x)
+{
+#if defined(HYPRE_USING_GPU)
+  return nullptr;
+#else
+  const double *xr = x.Real().Read(), *xi = x.Imag().Read();
+  return (xi == xr + x.Size()) ? xr : nullptr;
+#endif
+}
+
+double *WriteBlock(ComplexVector &y, bool read)
+{
+  double *yr = read ? y.Real().ReadWrite() : y.Real().Write();
+  double *yi = read ? y.Imag().ReadWrite() : y.Imag().Write();
+  return (yi == yr + y.Size()) ? yr : nullptr;
+}
+
+hypre_Vector *CreateBlockVector(const double *data, HYPRE_Int size)
+{
+  hypre_Vector *vec = hypre_SeqMultiVectorCreate(size, 2);
+  hypre_SeqVectorSetDataOwner(vec, 0);
+  hypre_VectorData(vec) = const_cast<double *>(data);
+  hypre_SeqVectorInitialize(vec);
+  return vec;
+}
+
+hypre_ParVector *CreateParBlockVector(MPI_Comm comm, HYPRE_BigInt global_size,
+                                      const HYPRE_BigInt *starts, const double *data)
+{
+  hypre_ParVector *vec =
+      hypre_ParMultiVectorCreate(comm, global_size, const_cast<HYPRE_BigInt *>(starts), 2);
+  hypre_Vector *loc = hypre_ParVectorLocalVector(vec);
+  hypre_SeqVectorSetDataOwner(loc, 0);
+  hypre_VectorData(loc) = const_cast<double *>(data);
+  hypre_ParVectorInitialize(vec);
+  return vec;
+}
+
 }  // namespace
 
 void HypreCSRMatrix::Mult(const Vector &x, Vector &y) const
@@ -123,4 +164,311 @@ void HypreCSRMatrix::AddMultTranspose(const Vector &x, Vector &y, const double a
   hypre_CSRMatrixMatvecT(a, mat, X, 1.0, Y);
 }
 
+void HypreCSRMatrix::MultBlock(const ComplexVector &x, ComplexVector &y, const double a,
+                               const double b, bool transpose) const
+{
+  const double *px = ReadBlock(x);
+  double *py = px ? WriteBlock(y, b != 0.0) : nullptr;
+  if (!px || !py)
+  {
+    for (bool imag : {false, true})
+    {
+      X.Update(imag ? x.Imag() : x.Real());
+      Y.Update(imag ? y.Imag() : y.Real());
+      if (transpose)
+      {
+        hypre_CSRMatrixMatvecT(a, mat, X, b, Y);
+      }
+      else
+      {
+        hypre_CSRMatrixMatvec(a, mat, X, b, Y);
+      }
+    }
+    return;
+  }
+  hypre_Vector *XX = CreateBlockVector(px, x.Size());
+  hypre_Vector *YY = CreateBlockVector(py, y.Size());
+  if (transpose)
+  {
+    hypre_CSRMatrixMatvecT(a, mat, XX, b, YY);
+  }
+  else
+  {
+    hypre_CSRMatrixMatvec(a, mat, XX, b, YY);
+  }
+  hypre_SeqVectorDestroy(XX);
+  hypre_SeqVectorDestroy(YY);
+}
+
+void ParMultBlock(const mfem::HypreParMatrix &P, const ComplexVector &x, ComplexVector &y,
+                  bool transpose)
+{
+  const double *px = ReadBlock(x);
+  double *py = px ? WriteBlock(y, false) : nullptr;
+  if (!px || !py)
+  {
+    if (transpose)
+    {
+      P.MultTranspose(x.Real(), y.Real());
+      P.MultTranspose(x.Imag(), y.Imag());
+    }
+    else
+    {
+      P.Mult(x.Real(), y.Real());
+      P.Mult(x.Imag(), y.Imag());
+    }
+    return;
+  }
+  P.HypreRead();
+  hypre_ParVector *XX =
+      transpose ? CreateParBlockVector(P.GetComm(), P.GetGlobalNumRows(), P.RowPart(), px)
+                : CreateParBlockVector(P.GetComm(), P.GetGlobalNumCols(), P.ColPart(), px);
+  hypre_ParVector *YY =
+      transpose ? CreateParBlockVector(P.GetComm(), P.GetGlobalNumCols(), P.ColPart(), py)
+                : CreateParBlockVector(P.GetComm(), P.GetGlobalNumRows(), P.RowPart(), py);
+  if (transpose)
+  {
+    hypre_ParCSRMatrixMatvecT(1.0, P, XX, 0.0, YY);
+  }
+  else
+  {
+    hypre_ParCSRMatrixMatvec(1.0, P, XX, 0.0, YY);
+  }
+  hypre_ParVectorDestroy(XX);
+  hypre_ParVectorDestroy(YY);
+}
+
+FloatCSRMatrix::FloatCSRMatrix(const HypreCSRMatrix &A)
+  : palace::Operator(A.Height(), A.Width()), I(A.Height() + 1), J(A.NNZ()), data(A.NNZ())
+{
+  // The entries are converted on the host from a host copy of the matrix, since the
+  // matrix arrays may reside in device memory when HYPRE uses the GPU.
+  hypre_CSRMatrix *h_A = hypre_CSRMatrixClone_v2(A, 1, HYPRE_MEMORY_HOST);
+  const auto *h_AI = hypre_CSRMatrixI(h_A);
+  const auto *h_AJ = hypre_CSRMatrixJ(h_A);
+  const auto *h_Adata = hypre_CSRMatrixData(h_A);
+  auto *h_I = I.HostWrite();
+  auto *h_J = J.HostWrite();
+  auto *h_data = data.HostWrite();
+  for (int i = 0; i < height + 1; i++)
+  {
+    h_I[i] = h_AI[i];
+  }
+  for (int k = 0; k < data.Size(); k++)
+  {
+    h_J[k] = h_AJ[k];
+    h_data[k] = static_cast<float>(h_Adata[k]);
+  }
+  hypre_CSRMatrixDestroy(h_A);
+}
+
+void FloatCSRMatrix::AssembleDiagonal(Vector &diag) const
+{
+  diag.SetSize(height);
+  const auto *d_I = I.Read();
+  const auto *d_J = J.Read();
+  const auto *d_data = data.Read();
+  auto *d_diag = diag.Write();
+  mfem::forall(height,
+               [=] MFEM_HOST_DEVICE(int i)
+               {
+                 double d = 0.0;
+                 for (int k = d_I[i]; k < d_I[i + 1]; k++)
+                 {
+                   if (d_J[k] == i)
+                   {
+                     d = d_data[k];
+                     break;
+                   }
+                 }
+                 d_diag[i] = d;
+               });
+}
+
+void FloatCSRMatrix::Mult(const Vector &x, Vector &y) const
+{
+  const auto *d_I = I.Read();
+  const auto *d_J = J.Read();
+  const auto *d_data = data.Read();
+  const auto *d_x = x.Read();
+  auto *d_y = y.Write();
+  mfem::forall(height,
+               [=] MFEM_HOST_DEVICE(int i)
+               {
+                 double sum = 0.0;
+                 for (int k = d_I[i]; k < d_I[i + 1]; k++)
+                 {
+                   sum += static_cast<double>(d_data[k]) * d_x[d_J[k]];
+                 }
+                 d_y[i] = sum;
+               });
+}
+
+void FloatCSRMatrix::AddMult(const Vector &x, Vector &y, const double a) const
+{
+  const auto *d_I = I.Read();
+  const auto *d_J = J.Read();
+  const auto *d_data = data.Read();
+  const auto *d_x = x.Read();
+  auto *d_y = y.ReadWrite();
+  mfem::forall(height,
+               [=] MFEM_HOST_DEVICE(int i)
+               {
+                 double sum = 0.0;
+                 for (int k = d_I[i]; k < d_I[i + 1]; k++)
+                 {
+                   sum += static_cast<double>(d_data[k]) * d_x[d_J[k]];
+                 }
+                 d_y[i] += a * sum;
+               });
+}
+
+void FloatCSRMatrix::MultTranspose(const Vector &x, Vector &y) const
+{
+  y = 0.0;
+  AddMultTranspose(x, y);
+}
+
+void FloatCSRMatrix::AddMultTranspose(const Vector &x, Vector &y, const double a) const
+{
+  // The transpose product is not used in performance critical paths, and is computed on
+  // the host to avoid atomic updates.
+  const auto *h_I = I.HostRead();
+  const auto *h_J = J.HostRead();
+  const auto *h_data = data.HostRead();
+  const auto *h_x = x.HostRead();
+  auto *h_y = y.HostReadWrite();
+  for (int i = 0; i < height; i++)
+  {
+    const double ax = a * h_x[i];
+    for (int k = h_I[i]; k < h_I[i + 1]; k++)
+    {
+      h_y[h_J[k]] += static_cast<double>(h_data[k]) * ax;
+    }
+  }
+}
+
+std::unique_ptr<Operator> ToSinglePrecision(std::unique_ptr<Operator> &&op)
+{
+  if (const auto *A = dynamic_cast<const HypreCSRMatrix *>(op.get()))
+  {
+    return std::make_unique<FloatCSRMatrix>(*A);
+  }
+  return std::move(op);
+}
+
+HypreCSRMatrixSum::HypreCSRMatrixSum(std::vector<std::unique_ptr<HypreCSRMatrix>> &&mats)
+  : terms(std::move(mats)), maps(terms.size())
+{
+  // Compute the merged sparsity pattern of all terms.
+  for (const auto &term : terms)
+  {
+    if (!term)
+    {
+      continue;
+    }
+    sum = std::make_unique<HypreCSRMatrix>(sum ? hypre_CSRMatrixAdd(1.0, *sum, 1.0, *term)
+                                               : hypre_CSRMatrixClone(*term, 0));
+  }
+  MFEM_VERIFY(sum, "HypreCSRMatrixSum requires at least one nonempty term!");
+
+  // Locate each nonzero of each term in the merged pattern, without assuming any ordering
+  // of the column indices within a row. This is done on the host, once.
+  hypre_CSRMatrix *h_sum = hypre_CSRMatrixClone_v2(*sum, 0, HYPRE_MEMORY_HOST);
+  const auto *h_I = hypre_CSRMatrixI(h_sum);
+  const auto *h_J = hypre_CSRMatrixJ(h_sum);
+  std::vector<int> loc(sum->Width(), -1);
+  for (std::size_t t = 0; t < terms.size(); t++)
+  {
+    if (!terms[t])
+    {
+      continue;
+    }
+    MFEM_VERIFY(terms[t]->Height() == sum->Height() && terms[t]->Width() == sum->Width(),
+                "Size mismatch for HypreCSRMatrixSum term!");
+    hypre_CSRMatrix *h_term = hypre_CSRMatrixClone_v2(*terms[t], 0, HYPRE_MEMORY_HOST);
+    const auto *h_It = hypre_CSRMatrixI(h_term);
+    const auto *h_Jt = hypre_CSRMatrixJ(h_term);
+    maps[t].SetSize(terms[t]->NNZ());
+    auto *h_map = maps[t].HostWrite();
+    for (int i = 0; i < sum->Height(); i++)
+    {
+      for (auto k = h_I[i]; k < h_I[i + 1]; k++)
+      {
+        loc[h_J[k]] = k;
+      }
+      for (auto k = h_It[i]; k < h_It[i + 1]; k++)
+      {
+        // Each entry of the merged pattern is claimed at most once per term, so the
+        // accumulation in Sum is free of write conflicts.
+        const auto j = h_Jt[k];
+        MFEM_VERIFY(loc[j] >= 0,
+                    "Unexpected sparsity pattern mismatch for HypreCSRMatrixSum term!");
+        h_map[k] = loc[j];
+        loc[j] = -1;
+      }
+      for (auto k = h_I[i]; k < h_I[i + 1]; k++)
+      {
+        loc[h_J[k]] = -1;
+      }
+    }
+    hypre_CSRMatrixDestroy(h_term);
+  }
+  hypre_CSRMatrixDestroy(h_sum);
+}
+
+const HypreCSRMatrix &HypreCSRMatrixSum::Sum(const std::vector<double> &coeffs)
+{
+  MFEM_VERIFY(coeffs.size() == terms.size(),
+              "Invalid number of coefficients for HypreCSRMatrixSum::Sum!");
+  hypre_CSRMatrixSetConstantValues(*sum, 0.0);
+  auto *d_sum = sum->GetData();
+  for (std::size_t k = 0; k < terms.size(); k++)
+  {
+    if (!terms[k] || coeffs[k] == 0.0)
+    {
+      continue;
+    }
+    const auto *d_term = terms[k]->GetData();
+    const auto *d_map = maps[k].Read();
+    const double a = coeffs[k];
+    mfem::forall(terms[k]->NNZ(),
+                 [=] MFEM_HOST_DEVICE(int i) { d_sum[d_map[i]] += a * d_term[i]; });
+  }
+  return *sum;
+}
+
+Vector GetAbsRowSums(const mfem::HypreParMatrix &A)
+{
+  A.HostRead();
+  mfem::SparseMatrix diag, offd;
+  HYPRE_BigInt *cmap;
+  A.GetDiag(diag);
+  A.GetOffd(offd, cmap);
+  Vector d(A.Height());
+  d.UseDevice(true);
+  auto *h_d = d.HostWrite();
+  for (int i = 0; i < d.Size(); i++)
+  {
+    h_d[i] = 0.0;
+  }
+  for (const auto *mat : {&diag, &offd})
+  {
+    if (mat->Height() == 0)
+    {
+      continue;
+    }
+    const int *I = mat->HostReadI();
+    const double *data = mat->HostReadData();
+    for (int i = 0; i < d.Size(); i++)
+    {
+      for (int k = I[i]; k < I[i + 1]; k++)
+      {
+        h_d[i] += std::abs(data[k]);
+      }
+    }
+  }
+  return d;
+}
+
 }  // namespace palace::hypre
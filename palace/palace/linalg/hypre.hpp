@@ -4,6 +4,8 @@
 #ifndef PALACE_LINALG_HYPRE_HPP
 #define PALACE_LINALG_HYPRE_HPP
 
+#include <memory>
+#include <vector>
 #include <mfem.hpp>
 #include "linalg/operator.hpp"
 #include "linalg/vector.hpp"
@@ -77,9 +79,86 @@ public:
 
   void AddMultTranspose(const Vector &x, Vector &y, const double a = 1.0) const override;
 
+  // Compute y = a A x + b y, or y = a Aᵀ x + b y, for the real and imaginary parts of a
+  // complex-valued vector as a two-column block with a single pass over the matrix. If the
+  // parts of x or y are not stored contiguously, they are multiplied separately.
+  void MultBlock(const ComplexVector &x, ComplexVector &y, const double a = 1.0,
+                 const double b = 0.0, bool transpose = false) const;
+
   operator hypre_CSRMatrix *() const { return mat; }
 };
 
+//
+// Copy of an HypreCSRMatrix with the matrix entries stored in single precision, for use in
+// preconditioners where the reduced accuracy of the entries is acceptable. Products use
+// double precision vectors and accumulation.
+//
+class FloatCSRMatrix : public palace::Operator
+{
+private:
+  mfem::Array<HYPRE_Int> I, J;
+  mfem::Array<float> data;
+
+public:
+  FloatCSRMatrix(const HypreCSRMatrix &A);
+
+  auto NNZ() const { return data.Size(); }
+
+  void AssembleDiagonal(Vector &diag) const override;
+
+  void Mult(const Vector &x, Vector &y) const override;
+
+  void AddMult(const Vector &x, Vector &y, const double a = 1.0) const override;
+
+  void MultTranspose(const Vector &x, Vector &y) const override;
+
+  void AddMultTranspose(const Vector &x, Vector &y, const double a = 1.0) const override;
+};
+
+// Convert an assembled local operator to single precision storage. Operators which are not
+// an HypreCSRMatrix are returned unchanged.
+std::unique_ptr<Operator> ToSinglePrecision(std::unique_ptr<Operator> &&op);
+
+//
+// Helper class for computing linear combinations of a fixed set of sparse matrices with
+// varying coefficients. The sparsity pattern of the sum (union of the patterns of all
+// terms) and the location of each term's nonzeros within it are computed once at
+// construction, after which forming a linear combination requires only a single pass over
+// the nonzeros of each term.
+//
+class HypreCSRMatrixSum
+{
+private:
+  // Terms of the sum (empty terms are allowed and are skipped), and for each the index of
+  // each of its nonzeros in the merged sparsity pattern.
+  std::vector<std::unique_ptr<HypreCSRMatrix>> terms;
+  std::vector<mfem::Array<int>> maps;
+
+  // Matrix with the merged sparsity pattern, which stores the result of Sum.
+  std::unique_ptr<HypreCSRMatrix> sum;
+
+public:
+  HypreCSRMatrixSum(std::vector<std::unique_ptr<HypreCSRMatrix>> &&mats);
+
+  auto Size() const { return terms.size(); }
+
+  // Compute the sum Σₖ aₖ Aₖ for the given coefficients. The result is stored in a matrix
+  // owned by this object, which is reused by (and only valid until) the next call.
+  const HypreCSRMatrix &Sum(const std::vector<double> &coeffs);
+};
+
+// Compute y = P x, or y = Pᵀ x, for the real and imaginary parts of a complex-valued vector
+// as a two-column block, with a single pass over the matrix and a single exchange of
+// off-process vector entries. If the parts of x or y are not stored contiguously, they are
+// multiplied separately.
+void ParMultBlock(const mfem::HypreParMatrix &P, const ComplexVector &x, ComplexVector &y,
+                  bool transpose = false);
+
+// Compute the row sums of the absolute values of the entries of the matrix,
+// dᵢ = Σⱼ |Aᵢⱼ|. For symmetric A, diag(d) - A is diagonally dominant with nonnegative
+// diagonal, so diag(d) ≥ A.
+Vector GetAbsRowSums(const mfem::HypreParMatrix &A);
+
 }  // namespace palace::hypre
 
 #endif  // PALACE_LINALG_HYPRE_HPP
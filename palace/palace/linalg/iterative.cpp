@@ -6,7 +6,9 @@
 #include <algorithm>
 #include <cmath>
 #include <limits>
+#include <numeric>
 #include <string>
+#include <Eigen/Dense>
 #include "linalg/orthog.hpp"
 #include "utils/communication.hpp"
 #include "utils/timer.hpp"
@@ -319,11 +321,80 @@ inline void OrthogonalizeIteration(GmresSolverBase::OrthogType type, MPI_Comm co
       linalg::OrthogonalizeColumnCGS(comm, V, w, Hj, j + 1);
       break;
     case GmresSolverBase::OrthogType::CGS2:
+    case GmresSolverBase::OrthogType::DCGS2:
+      // DCGS2 is only used in the Arnoldi process of GMRES, otherwise use CGS2.
       linalg::OrthogonalizeColumnCGS(comm, V, w, Hj, j + 1, true);
       break;
   }
 }
 
+template <typename VecType, typename ScalarType>
+inline void LocalGram(const std::vector<VecType> &X, const std::vector<int> &ix,
+                      const std::vector<VecType> &Y, const std::vector<int> &iy,
+                      ScalarType *G)
+{
+  // Local contribution to G = Xᴴ Y for the given columns of X and Y, stored column-major.
+  const std::size_t m = ix.size();
+  for (std::size_t j = 0; j < iy.size(); j++)
+  {
+    for (std::size_t i = 0; i < m; i++)
+    {
+      G[i + j * m] = linalg::LocalDot(Y[iy[j]], X[ix[i]]);
+    }
+  }
+}
+
+template <typename MatType>
+inline void GetBlockBasis(const MatType &G, MatType &T)
+{
+  // Given the Gram matrix G = Wᴴ W, compute T such that the columns of W T are orthonormal
+  // and span the numerical range of W. Directions with singular values below a relative
+  // threshold are dropped, which avoids breakdown for rank-deficient blocks.
+  T.resize(G.rows(), 0);
+  if (G.rows() == 0)
+  {
+    return;
+  }
+  Eigen::SelfAdjointEigenSolver<MatType> eig(G);
+  const auto &lambda = eig.eigenvalues();
+  const double lambda_max = lambda(lambda.size() - 1);
+  if (!(lambda_max > 0.0))
+  {
+    return;
+  }
+  std::vector<int> keep;
+  for (int k = static_cast<int>(lambda.size()) - 1; k >= 0; k--)
+  {
+    if (lambda(k) > 1.0e-12 * lambda_max)
+    {
+      keep.push_back(k);
+    }
+  }
+  T.resize(G.rows(), keep.size());
+  for (std::size_t k = 0; k < keep.size(); k++)
+  {
+    T.col(k) = eig.eigenvectors().col(keep[k]) / std::sqrt(lambda(keep[k]));
+  }
+}
+
+inline void GetRecycleCandidates(const Eigen::VectorXcd &p,
+                                 std::vector<Eigen::VectorXcd> &candidates)
+{
+  candidates.push_back(p);
+}
+
+inline void GetRecycleCandidates(const Eigen::VectorXcd &p,
+                                 std::vector<Eigen::VectorXd> &candidates)
+{
+  // For real-valued problems, eigenvectors for a complex conjugate pair of eigenvalues span
+  // the same real subspace as their real and imaginary parts.
+  candidates.push_back(p.real());
+  if (p.imag().norm() > 1.0e-12 * p.norm())
+  {
+    candidates.push_back(p.imag());
+  }
+}
+
 }  // namespace
 
 template <typename OperType>
@@ -366,6 +437,14 @@ void CgSolver<OperType>::Mult(const VecType &b, VecType &x) const
   MFEM_VERIFY(A, "Operator must be set for CgSolver::Mult!");
   MFEM_ASSERT(A->Width() == x.Size() && A->Height() == b.Size(),
               "Size mismatch for CgSolver::Mult!");
+  for (auto *V : {&R, &Z, &P})
+  {
+    if (V->empty())
+    {
+      V->resize(1);
+    }
+  }
+  VecType &r = R[0], &z = Z[0], &p = P[0];
   r.SetSize(A->Height());
   z.SetSize(A->Height());
   p.SetSize(A->Height());
@@ -485,6 +564,412 @@ void CgSolver<OperType>::Mult(const VecType &b, VecType &x) const
   final_it = it;
 }
 
+template <typename OperType>
+void CgSolver<OperType>::Mult(const std::vector<VecType> &b, std::vector<VecType> &x) const
+{
+  using MatType = Eigen::Matrix<ScalarType, Eigen::Dynamic, Eigen::Dynamic>;
+  using MapType = Eigen::Map<const MatType>;
+  MFEM_VERIFY(A, "Operator must be set for CgSolver::Mult!");
+  MFEM_VERIFY(b.size() == x.size(),
+              "Mismatch in number of right-hand sides and solutions for CgSolver::Mult!");
+  const int m = static_cast<int>(b.size());
+  if (m < 2)
+  {
+    for (int j = 0; j < m; j++)
+    {
+      Mult(b[j], x[j]);
+    }
+    return;
+  }
+
+  // Set up workspace. The search directions P and their images Q = A P have at most as many
+  // columns as there are right-hand sides. The first vectors of R, Z, and P are those used
+  // for single right-hand side solves.
+  for (auto *V : {&R, &Z, &P, &Q})
+  {
+    V->resize(m);
+    for (auto &v : *V)
+    {
+      v.SetSize(A->Height());
+      v.UseDevice(true);
+    }
+  }
+  auto ApplyPrec = [this](const VecType &u, VecType &v)
+  {
+    if (B)
+    {
+      ApplyB(B, u, v, this->use_timer);
+    }
+    else
+    {
+      v = u;
+    }
+  };
+  auto UpdateDirections = [this](const std::vector<int> &act, const MatType &T)
+  {
+    for (int k = 0; k < T.cols(); k++)
+    {
+      P[k] = 0.0;
+      for (int i = 0; i < T.rows(); i++)
+      {
+        P[k].Add(T(i, k), Z[act[i]]);
+      }
+    }
+    return static_cast<int>(T.cols());
+  };
+
+  // Initialize. A single reduction computes the residual norms ||rⱼ||_B, the norms
+  // ||bⱼ||_B of the right-hand sides when using an initial guess, and the Gram matrix of
+  // the preconditioned residuals for the first block of search directions.
+  std::vector<int> act(m);
+  std::iota(act.begin(), act.end(), 0);
+  for (int j = 0; j < m; j++)
+  {
+    MFEM_ASSERT(A->Width() == x[j].Size() && A->Height() == b[j].Size(),
+                "Size mismatch for CgSolver::Mult!");
+    if (this->initial_guess)
+    {
+      A->Mult(x[j], R[j]);
+      linalg::AXPBY(1.0, b[j], -1.0, R[j]);
+      ApplyPrec(b[j], Q[j]);
+    }
+    else
+    {
+      R[j] = b[j];
+      x[j] = 0.0;
+    }
+    ApplyPrec(R[j], Z[j]);
+  }
+  std::vector<ScalarType> buf(2 * m + m * m, 0.0);
+  for (int j = 0; j < m; j++)
+  {
+    buf[j] = linalg::LocalDot(Z[j], R[j]);
+    if (this->initial_guess)
+    {
+      buf[m + j] = linalg::LocalDot(Q[j], b[j]);
+    }
+  }
+  LocalGram(Z, act, Z, act, buf.data() + 2 * m);
+  Mpi::GlobalSum(static_cast<int>(buf.size()), buf.data(), comm);
+
+  std::vector<RealType> res(m), res0(m), eps(m);
+  std::vector<int> keep;
+  for (int j = 0; j < m; j++)
+  {
+    CheckDot(buf[j], "PCG preconditioner is not positive definite: (Br, r) = ");
+    res[j] = std::sqrt(std::abs(buf[j]));
+    if (this->initial_guess)
+    {
+      CheckDot(buf[m + j], "PCG preconditioner is not positive definite: (Bb, b) = ");
+      res0[j] = std::sqrt(std::abs(buf[m + j]));
+    }
+    else
+    {
+      res0[j] = res[j];
+    }
+    eps[j] = std::max(rel_tol * res0[j], abs_tol);
+    if (res[j] >= eps[j])
+    {
+      keep.push_back(j);
+    }
+  }
+  auto GetWorstIndex = [&res, &res0]()
+  {
+    int jmax = 0;
+    RealType rmax = 0.0;
+    for (std::size_t j = 0; j < res.size(); j++)
+    {
+      const RealType ratio = (res0[j] > 0.0) ? res[j] / res0[j] : 0.0;
+      if (ratio > rmax)
+      {
+        jmax = static_cast<int>(j);
+        rmax = ratio;
+      }
+    }
+    return jmax;
+  };
+  MatType G(keep.size(), keep.size()), T;
+  {
+    MapType ZtZ(buf.data() + 2 * m, m, m);
+    for (std::size_t l = 0; l < keep.size(); l++)
+    {
+      for (std::size_t i = 0; i < keep.size(); i++)
+      {
+        G(i, l) = ZtZ(keep[i], keep[l]);
+      }
+    }
+  }
+  act = keep;
+  GetBlockBasis(G, T);
+  int s = UpdateDirections(act, T);
+
+  // Begin iterations.
+  int it = 0;
+  if (print_opts.iterations)
+  {
+    Mpi::Print(comm, "{}Residual norms for block PCG solve ({:d} right-hand sides)\n",
+               std::string(tab_width + int_width - 1, ' '), m);
+  }
+  for (; it < max_it && !act.empty() && s > 0; it++)
+  {
+    if (print_opts.iterations)
+    {
+      Mpi::Print(comm, "{}{:{}d} KSP residual norm ||r||_B = {:.6e} ({:d} active)\n",
+                 std::string(tab_width, ' '), it, int_width, res[GetWorstIndex()],
+                 act.size());
+    }
+    const int na = static_cast<int>(act.size());
+    std::vector<int> dirs(s);
+    std::iota(dirs.begin(), dirs.end(), 0);
+
+    // Compute Q = A P, and the step α = (Pᴴ Q)⁻¹ Pᴴ R for the active right-hand sides.
+    for (int k = 0; k < s; k++)
+    {
+      A->Mult(P[k], Q[k]);
+    }
+    buf.resize(s * s + s * na);
+    LocalGram(P, dirs, Q, dirs, buf.data());
+    LocalGram(P, dirs, R, act, buf.data() + s * s);
+    Mpi::GlobalSum(static_cast<int>(buf.size()), buf.data(), comm);
+    MapType PtQ(buf.data(), s, s);
+    Eigen::LLT<MatType> llt(MatType(0.5 * (PtQ + PtQ.adjoint())));
+    MFEM_VERIFY(llt.info() == Eigen::Success,
+                "Block PCG operator is not positive definite: Pᴴ A P is not SPD!");
+    const MatType alpha = llt.solve(MapType(buf.data() + s * s, s, na));
+    for (int j = 0; j < na; j++)
+    {
+      for (int k = 0; k < s; k++)
+      {
+        x[act[j]].Add(alpha(k, j), P[k]);
+        R[act[j]].Add(-alpha(k, j), Q[k]);
+      }
+      ApplyPrec(R[act[j]], Z[act[j]]);
+    }
+
+    // A second reduction computes the residual norms along with all inner products required
+    // for the next block of search directions W = Z + P β, β = -(Pᴴ Q)⁻¹ Qᴴ Z. Using
+    // Pᴴ P = I, the Gram matrix is Wᴴ W = Zᴴ Z + (Pᴴ Z)ᴴ β + βᴴ Pᴴ Z + βᴴ β.
+    buf.resize(na + na * na + 2 * s * na);
+    for (int j = 0; j < na; j++)
+    {
+      buf[j] = linalg::LocalDot(Z[act[j]], R[act[j]]);
+    }
+    LocalGram(Z, act, Z, act, buf.data() + na);
+    LocalGram(P, dirs, Z, act, buf.data() + na + na * na);
+    LocalGram(Q, dirs, Z, act, buf.data() + na + na * na + s * na);
+    Mpi::GlobalSum(static_cast<int>(buf.size()), buf.data(), comm);
+    keep.clear();
+    for (int j = 0; j < na; j++)
+    {
+      CheckDot(buf[j], "PCG preconditioner is not positive definite: (Br, r) = ");
+      res[act[j]] = std::sqrt(std::abs(buf[j]));
+      if (res[act[j]] >= eps[act[j]])
+      {
+        keep.push_back(j);
+      }
+    }
+    const int nk = static_cast<int>(keep.size());
+    MapType ZtZ(buf.data() + na, na, na);
+    MapType PtZ(buf.data() + na + na * na, s, na);
+    const MatType beta = -llt.solve(MapType(buf.data() + na + na * na + s * na, s, na));
+    MatType beta_k(s, nk), PtZ_k(s, nk);
+    G.resize(nk, nk);
+    for (int l = 0; l < nk; l++)
+    {
+      beta_k.col(l) = beta.col(keep[l]);
+      PtZ_k.col(l) = PtZ.col(keep[l]);
+      for (int i = 0; i < nk; i++)
+      {
+        G(i, l) = ZtZ(keep[i], keep[l]);
+      }
+    }
+    G += PtZ_k.adjoint() * beta_k + beta_k.adjoint() * PtZ_k + beta_k.adjoint() * beta_k;
+
+    // Right-hand sides which have converged are removed from the block, and the new search
+    // directions are formed in place of the preconditioned residuals.
+    for (int l = 0; l < nk; l++)
+    {
+      keep[l] = act[keep[l]];
+      for (int k = 0; k < s; k++)
+      {
+        Z[keep[l]].Add(beta_k(k, l), P[k]);
+      }
+    }
+    act = keep;
+    GetBlockBasis(G, T);
+    s = UpdateDirections(act, T);
+  }
+  const int jmax = GetWorstIndex();
+  converged = act.empty();
+  if (print_opts.iterations)
+  {
+    Mpi::Print(comm, "{}{:{}d} KSP residual norm ||r||_B = {:.6e} ({:d} active)\n",
+               std::string(tab_width, ' '), it, int_width, res[jmax], act.size());
+  }
+  if (print_opts.summary ||
+      (print_opts.warnings && (rel_tol > 0.0 || abs_tol > 0.0) && !converged))
+  {
+    Mpi::Print(comm, "{}Block PCG solver {} in {:d} iteration{}",
+               std::string(tab_width, ' '), converged ? "converged" : "did NOT converge",
+               it, (it == 1) ? "" : "s");
+    if (it > 0 && res0[jmax] > 0.0)
+    {
+      Mpi::Print(comm, " (avg. reduction factor: {:.3e})\n",
+                 std::pow(res[jmax] / res0[jmax], 1.0 / it));
+    }
+    else
+    {
+      Mpi::Print(comm, "\n");
+    }
+  }
+  initial_res = res0[jmax];
+  final_res = res[jmax];
+  final_it = it;
+}
+
+template <typename OperType>
+void PipelinedCgSolver<OperType>::Mult(const VecType &b, VecType &x) const
+{
+  // Set up workspace.
+  ScalarType gamma, gamma_prev = 0.0, delta, alpha = 0.0, beta, denom;
+  RealType res, eps = 0.0;
+  MFEM_VERIFY(A, "Operator must be set for PipelinedCgSolver::Mult!");
+  MFEM_ASSERT(A->Width() == x.Size() && A->Height() == b.Size(),
+              "Size mismatch for PipelinedCgSolver::Mult!");
+  for (auto *v : {&r, &u, &w, &m, &n, &p, &q, &s, &z})
+  {
+    v->SetSize(A->Height());
+    v->UseDevice(true);
+  }
+
+  // Initialize.
+  if (this->initial_guess)
+  {
+    A->Mult(x, r);
+    linalg::AXPBY(1.0, b, -1.0, r);
+  }
+  else
+  {
+    r = b;
+    x = 0.0;
+  }
+  if (B)
+  {
+    ApplyB(B, r, u, this->use_timer);
+  }
+  else
+  {
+    u = r;
+  }
+  A->Mult(u, w);
+  if (this->initial_guess)
+  {
+    ScalarType beta_rhs;
+    if (B)
+    {
+      ApplyB(B, b, p, this->use_timer);
+      beta_rhs = linalg::Dot(comm, p, b);
+    }
+    else
+    {
+      beta_rhs = linalg::Norml2(comm, b);
+    }
+    CheckDot(beta_rhs, "PCG preconditioner is not positive definite: (Bb, b) = ");
+    initial_res = std::sqrt(std::abs(beta_rhs));
+    eps = std::max(rel_tol * initial_res, abs_tol);
+  }
+
+  // Begin iterations. The recurrences for s = A p, q = B s, and z = A q replace the
+  // applications of the operator and preconditioner to the search direction, so that the
+  // inner products γ = (Br, r) and δ = (A Br, Br) can be reduced while computing m = B w
+  // and n = A m for w = A B r. The preconditioner and operator applications of the
+  // final iteration are not used.
+  int it = 0;
+  if (print_opts.iterations)
+  {
+    Mpi::Print(comm, "{}Residual norms for pipelined PCG solve\n",
+               std::string(tab_width + int_width - 1, ' '));
+  }
+  for (;; it++)
+  {
+    ScalarType dots[2] = {linalg::LocalDot(u, r), linalg::LocalDot(w, u)};
+    MPI_Request req = Mpi::GlobalSumAsync(2, dots, comm);
+    if (B)
+    {
+      ApplyB(B, w, m, this->use_timer);
+    }
+    else
+    {
+      m = w;
+    }
+    A->Mult(m, n);
+    Mpi::Wait(req);
+    gamma = dots[0];
+    delta = dots[1];
+    CheckDot(gamma, "PCG preconditioner is not positive definite: (Br, r) = ");
+    res = std::sqrt(std::abs(gamma));
+    if (it == 0 && !this->initial_guess)
+    {
+      initial_res = res;
+      eps = std::max(rel_tol * initial_res, abs_tol);
+    }
+    if (print_opts.iterations)
+    {
+      Mpi::Print(comm, "{}{:{}d} KSP residual norm ||r||_B = {:.6e}\n",
+                 std::string(tab_width, ' '), it, int_width, res);
+    }
+    converged = (res < eps);
+    if (converged || it == max_it)
+    {
+      break;
+    }
+
+    if (it == 0)
+    {
+      denom = delta;
+      CheckDot(denom, "PCG operator is not positive definite: (Ap, p) = ");
+      alpha = gamma / denom;
+      z = n;
+      q = m;
+      s = w;
+      p = u;
+    }
+    else
+    {
+      beta = gamma / gamma_prev;
+      denom = delta - beta * gamma / alpha;
+      CheckDot(denom, "PCG operator is not positive definite: (Ap, p) = ");
+      alpha = gamma / denom;
+      linalg::AXPBY(ScalarType(1.0), n, beta, z);
+      linalg::AXPBY(ScalarType(1.0), m, beta, q);
+      linalg::AXPBY(ScalarType(1.0), w, beta, s);
+      linalg::AXPBY(ScalarType(1.0), u, beta, p);
+    }
+    x.Add(alpha, p);
+    r.Add(-alpha, s);
+    u.Add(-alpha, q);
+    w.Add(-alpha, z);
+    gamma_prev = gamma;
+  }
+  if (print_opts.summary || (print_opts.warnings && eps > 0.0 && !converged))
+  {
+    Mpi::Print(comm, "{}Pipelined PCG solver {} in {:d} iteration{}",
+               std::string(tab_width, ' '), converged ? "converged" : "did NOT converge",
+               it, (it == 1) ? "" : "s");
+    if (it > 0)
+    {
+      Mpi::Print(comm, " (avg. reduction factor: {:.3e})\n",
+                 std::pow(res / initial_res, 1.0 / it));
+    }
+    else
+    {
+      Mpi::Print(comm, "\n");
+    }
+  }
+  final_res = res;
+  final_it = it;
+}
+
 template <typename OperType>
 void GmresSolver<OperType>::Initialize() const
 {
@@ -597,40 +1082,47 @@ void GmresSolver<OperType>::Mult(const VecType &b, VecType &x) const
     s[0] = beta;
 
     int j = 0;
-    for (;; j++, it++)
+    if (orthog_type == OrthogType::DCGS2)
     {
-      if (print_opts.iterations)
-      {
-        Mpi::Print(comm, "{}{:{}d} (restart {:d}) KSP residual norm {:.6e}\n",
-                   std::string(tab_width, ' '), it, int_width, restart, beta);
-      }
-      VecType &w = V[j + 1];
-      if (w.Size() == 0)
+      j = ArnoldiDCGS2(restart, eps, beta, it);
+    }
+    else
+    {
+      for (;; j++, it++)
       {
-        Update(j);
-      }
-      ApplyBA(pc_side, A, B, V[j], w, r, this->use_timer);
+        if (print_opts.iterations)
+        {
+          Mpi::Print(comm, "{}{:{}d} (restart {:d}) KSP residual norm {:.6e}\n",
+                     std::string(tab_width, ' '), it, int_width, restart, beta);
+        }
+        VecType &w = V[j + 1];
+        if (w.Size() == 0)
+        {
+          Update(j);
+        }
+        ApplyBA(pc_side, A, B, V[j], w, r, this->use_timer);
 
-      ScalarType *Hj = H.data() + j * (max_dim + 1);
-      OrthogonalizeIteration(orthog_type, comm, V, w, Hj, j);
-      Hj[j + 1] = linalg::Norml2(comm, w);
-      w *= 1.0 / Hj[j + 1];
+        ScalarType *Hj = H.data() + j * (max_dim + 1);
+        OrthogonalizeIteration(orthog_type, comm, V, w, Hj, j);
+        Hj[j + 1] = linalg::Norml2(comm, w);
+        w *= 1.0 / Hj[j + 1];
 
-      for (int k = 0; k < j; k++)
-      {
-        ApplyPlaneRotation(Hj[k], Hj[k + 1], cs[k], sn[k]);
-      }
-      GeneratePlaneRotation(Hj[j], Hj[j + 1], cs[j], sn[j]);
-      ApplyPlaneRotation(Hj[j], Hj[j + 1], cs[j], sn[j]);
-      ApplyPlaneRotation(s[j], s[j + 1], cs[j], sn[j]);
+        for (int k = 0; k < j; k++)
+        {
+          ApplyPlaneRotation(Hj[k], Hj[k + 1], cs[k], sn[k]);
+        }
+        GeneratePlaneRotation(Hj[j], Hj[j + 1], cs[j], sn[j]);
+        ApplyPlaneRotation(Hj[j], Hj[j + 1], cs[j], sn[j]);
+        ApplyPlaneRotation(s[j], s[j + 1], cs[j], sn[j]);
 
-      beta = std::abs(s[j + 1]);
-      CheckDot(beta, "GMRES residual norm is not valid: beta = ");
-      converged = (beta < eps);
-      if (converged || j + 1 == max_dim || it + 1 == max_it)
-      {
-        it++;
-        break;
+        beta = std::abs(s[j + 1]);
+        CheckDot(beta, "GMRES residual norm is not valid: beta = ");
+        converged = (beta < eps);
+        if (converged || j + 1 == max_dim || it + 1 == max_it)
+        {
+          it++;
+          break;
+        }
       }
     }
 
@@ -689,6 +1181,126 @@ void GmresSolver<OperType>::Mult(const VecType &b, VecType &x) const
   final_it = it;
 }
 
+template <typename OperType>
+int GmresSolver<OperType>::ArnoldiDCGS2(int restart, RealType eps, RealType &beta,
+                                        int &it) const
+{
+  // Arnoldi process with one-reduce classical Gram-Schmidt with reorthogonalization and
+  // delayed normalization, see Świrydowicz et al., Low synchronization Gram-Schmidt and
+  // generalized minimal residual algorithms, Numer. Linear Algebra Appl. (2021). At the
+  // start of iteration j, V[j] has been orthogonalized once against V[0], ..., V[j - 1] but
+  // not normalized. The reorthogonalization coefficients and norm of V[j] are reduced while
+  // the operator is applied to it, and the result is then corrected using the Arnoldi
+  // relation. This leaves a single blocking reduction per iteration, for the first
+  // orthogonalization of the new vector. Column j - 1 of the Hessenberg matrix, and hence
+  // the residual estimate, is completed at iteration j.
+  const int ldh = max_dim + 1;
+  Hu.resize(H.size());
+  c.resize(max_dim + 1);
+  g.resize(max_dim + 1);
+  if (print_opts.iterations)
+  {
+    Mpi::Print(comm, "{}{:{}d} (restart {:d}) KSP residual norm {:.6e}\n",
+               std::string(tab_width, ' '), it, int_width, restart, beta);
+  }
+  if (V[1].Size() == 0)
+  {
+    Update(0);
+  }
+  ApplyBA(pc_side, A, B, V[0], V[1], r, this->use_timer);
+  linalg::OrthogonalizeColumnCGS(comm, V, V[1], Hu.data(), 1);
+
+  int j = 1;
+  for (;; j++)
+  {
+    // Start the reduction for the reorthogonalization coefficients and norm of V[j]. Unless
+    // this is the last iteration of the cycle, apply the operator to the unnormalized
+    // vector in the meantime.
+    VecType &v = V[j];
+    const bool last = (j == max_dim || it + 1 == max_it);
+    for (int k = 0; k < j; k++)
+    {
+      c[k] = linalg::LocalDot(v, V[k]);
+    }
+    c[j] = linalg::LocalDot(v, v);
+    if (!last)
+    {
+      if (V[j + 1].Size() == 0)
+      {
+        Update(j);
+      }
+      MPI_Request req = Mpi::GlobalSumAsync(j + 1, c.data(), comm);
+      ApplyBA(pc_side, A, B, v, V[j + 1], r, this->use_timer);
+      Mpi::Wait(req);
+    }
+    else
+    {
+      Mpi::GlobalSum(j + 1, c.data(), comm);
+    }
+
+    // Reorthogonalize and normalize V[j], completing column j - 1 of the Hessenberg matrix.
+    // The norm after reorthogonalization is computed explicitly if the update is
+    // inaccurate due to cancellation.
+    ScalarType *Huj = Hu.data() + (j - 1) * ldh;
+    RealType nrm2 = std::real(c[j]);
+    for (int k = 0; k < j; k++)
+    {
+      v.Add(-c[k], V[k]);
+      Huj[k] += c[k];
+      nrm2 -= std::norm(c[k]);
+    }
+    const RealType nrm =
+        (nrm2 > 1.0e-6 * std::real(c[j])) ? std::sqrt(nrm2) : linalg::Norml2(comm, v);
+    Huj[j] = nrm;
+    if (nrm > 0.0)
+    {
+      v *= 1.0 / nrm;
+    }
+
+    // Update the QR factorization of the Hessenberg matrix and the residual estimate.
+    ScalarType *Hj = H.data() + (j - 1) * ldh;
+    std::copy(Huj, Huj + j + 1, Hj);
+    for (int k = 0; k < j - 1; k++)
+    {
+      ApplyPlaneRotation(Hj[k], Hj[k + 1], cs[k], sn[k]);
+    }
+    GeneratePlaneRotation(Hj[j - 1], Hj[j], cs[j - 1], sn[j - 1]);
+    ApplyPlaneRotation(Hj[j - 1], Hj[j], cs[j - 1], sn[j - 1]);
+    ApplyPlaneRotation(s[j - 1], s[j], cs[j - 1], sn[j - 1]);
+
+    beta = std::abs(s[j]);
+    CheckDot(beta, "GMRES residual norm is not valid: beta = ");
+    converged = (beta < eps);
+    it++;
+    if (converged || last || nrm == 0.0)
+    {
+      break;
+    }
+    if (print_opts.iterations)
+    {
+      Mpi::Print(comm, "{}{:{}d} (restart {:d}) KSP residual norm {:.6e}\n",
+                 std::string(tab_width, ' '), it, int_width, restart, beta);
+    }
+
+    // The operator was applied to the unnormalized V[j] = (v - V_j c) / nrm, so correct the
+    // result using the Arnoldi relation A V_j = V_{j+1} Hu: w = (A v - V_{j+1} Hu c) / nrm.
+    // Then orthogonalize once against V[0], ..., V[j] to start column j.
+    VecType &w = V[j + 1];
+    for (int i = 0; i <= j; i++)
+    {
+      g[i] = 0.0;
+      for (int k = std::max(i - 1, 0); k < j; k++)
+      {
+        g[i] += Hu[k * ldh + i] * c[k];
+      }
+      w.Add(-g[i], V[i]);
+    }
+    w *= 1.0 / nrm;
+    linalg::OrthogonalizeColumnCGS(comm, V, w, Hu.data() + j * ldh, j + 1);
+  }
+  return j - 1;
+}
+
 template <typename OperType>
 void FgmresSolver<OperType>::Initialize() const
 {
@@ -855,13 +1467,394 @@ void FgmresSolver<OperType>::Mult(const VecType &b, VecType &x) const
   final_it = it;
 }
 
+template <typename OperType>
+void GcroDrSolver<OperType>::Initialize() const
+{
+  GmresSolver<OperType>::Initialize();
+  MFEM_VERIFY(max_recycle_dim >= 0 && max_recycle_dim < max_dim,
+              "GCRO-DR recycled subspace dimension must be less than the restart dimension "
+              "(got "
+                  << max_recycle_dim << " and " << max_dim << ")!");
+  Hh.resize((max_dim + 1) * max_dim);
+  Bk.resize(max_recycle_dim * max_dim);
+  w.resize(max_recycle_dim);
+  y.SetSize(A->Height());
+  z.SetSize(A->Height());
+  y.UseDevice(true);
+  z.UseDevice(true);
+}
+
+template <typename OperType>
+void GcroDrSolver<OperType>::UpdateRecycleSpace() const
+{
+  // Recompute C = A B U for the current operator and orthonormalize the result as C = Q R,
+  // with U <- U R⁻¹. Linearly dependent columns are discarded.
+  const int k = static_cast<int>(U.size());
+  int l = 0;
+  for (int i = 0; i < k; i++)
+  {
+    if (l < i)
+    {
+      U[l] = U[i];
+    }
+    ApplyBA(PrecSide::RIGHT, A, B, U[l], C[l], z, this->use_timer);
+    const RealType nrm0 = linalg::Norml2(comm, C[l]);
+    OrthogonalizeIteration(orthog_type, comm, C, C[l], w.data(), l - 1);
+    const RealType nrm = linalg::Norml2(comm, C[l]);
+    if (nrm <= 1.0e-12 * nrm0)
+    {
+      continue;
+    }
+    C[l] *= 1.0 / nrm;
+    for (int q = 0; q < l; q++)
+    {
+      U[l].Add(-w[q], U[q]);
+    }
+    U[l] *= 1.0 / nrm;
+    l++;
+  }
+  U.resize(l);
+  C.resize(l);
+}
+
+template <typename OperType>
+void GcroDrSolver<OperType>::ComputeRecycleSpace(int m) const
+{
+  // Compute harmonic Ritz vectors for the subspace Ŵ = [U V_m], where A B Ŵ = W G with
+  // W = [C V_{m+1}] and G = [I Bk; 0 H]. The harmonic Ritz vectors Ŵ p satisfy
+  // Gᴴ G p = θ Gᴴ Wᴴ Ŵ p, and those for the eigenvalues θ of smallest magnitude are
+  // retained. The small dense problems are replicated across all processes.
+  using MatType = Eigen::Matrix<ScalarType, Eigen::Dynamic, Eigen::Dynamic>;
+  using ColType = Eigen::Matrix<ScalarType, Eigen::Dynamic, 1>;
+  const int k = static_cast<int>(U.size()), n = k + m;
+  MatType G = MatType::Zero(n + 1, n), WhW = MatType::Zero(n + 1, n);
+  G.topLeftCorner(k, k).setIdentity();
+  for (int j = 0; j < m; j++)
+  {
+    for (int i = 0; i < k; i++)
+    {
+      G(i, k + j) = Bk[j * max_recycle_dim + i];
+    }
+    for (int i = 0; i <= j + 1; i++)
+    {
+      G(k + i, k + j) = Hh[j * (max_dim + 1) + i];
+    }
+    WhW(k + j, k + j) = 1.0;
+  }
+  if (k > 0)
+  {
+    // Compute Wᴴ U with a single global reduction.
+    std::vector<ScalarType> dots((n + 1) * k);
+    for (int l = 0; l < k; l++)
+    {
+      for (int i = 0; i < k; i++)
+      {
+        dots[l * (n + 1) + i] = U[l] * C[i];  // Local inner product
+      }
+      for (int i = 0; i <= m; i++)
+      {
+        dots[l * (n + 1) + k + i] = U[l] * V[i];  // Local inner product
+      }
+    }
+    Mpi::GlobalSum(static_cast<int>(dots.size()), dots.data(), comm);
+    WhW.leftCols(k) = Eigen::Map<const MatType>(dots.data(), n + 1, k);
+  }
+
+  // Solve the generalized eigenvalue problem in the equivalent form
+  // (Gᴴ G)⁻¹ Gᴴ Wᴴ Ŵ p = μ p, μ = 1 / θ, since Gᴴ G is Hermitian positive definite.
+  const MatType M = (G.adjoint() * G).llt().solve(G.adjoint() * WhW);
+  Eigen::ComplexEigenSolver<Eigen::MatrixXcd> eig(M.template cast<std::complex<double>>());
+  MFEM_VERIFY(eig.info() == Eigen::Success,
+              "Harmonic Ritz vector computation failed for GCRO-DR solver!");
+  std::vector<int> perm(n);
+  std::iota(perm.begin(), perm.end(), 0);
+  std::sort(perm.begin(), perm.end(),
+            [&eig](int i, int j)
+            { return std::abs(eig.eigenvalues()(i)) > std::abs(eig.eigenvalues()(j)); });
+  std::vector<ColType> candidates;
+  for (int i : perm)
+  {
+    GetRecycleCandidates(eig.eigenvectors().col(i), candidates);
+  }
+
+  // Orthonormalize the selected coefficient vectors.
+  MatType P(n, std::min(max_recycle_dim, n));
+  int k_new = 0;
+  for (auto &p : candidates)
+  {
+    if (k_new == P.cols())
+    {
+      break;
+    }
+    const RealType nrm0 = p.norm();
+    for (int refine = 0; refine < 2; refine++)
+    {
+      p -= P.leftCols(k_new) * (P.leftCols(k_new).adjoint() * p);
+    }
+    const RealType nrm = p.norm();
+    if (nrm > 1.0e-8 * nrm0)
+    {
+      P.col(k_new++) = p / nrm;
+    }
+  }
+
+  if (k_new == 0)
+  {
+    U.clear();
+    C.clear();
+    return;
+  }
+
+  // Factor G P = Q R, after which the new subspace is given by C = W Q and U = Ŵ P R⁻¹.
+  Eigen::HouseholderQR<MatType> qr(G * P.leftCols(k_new));
+  const MatType Q = qr.householderQ() * MatType::Identity(n + 1, k_new);
+  const MatType R = qr.matrixQR().topRows(k_new).template triangularView<Eigen::Upper>();
+  const MatType PR = R.template triangularView<Eigen::Upper>()
+                         .template solve<Eigen::OnTheRight>(P.leftCols(k_new));
+  std::vector<VecType> U_new(k_new), C_new(k_new);
+  for (int i = 0; i < k_new; i++)
+  {
+    U_new[i].SetSize(A->Height());
+    C_new[i].SetSize(A->Height());
+    U_new[i].UseDevice(true);
+    C_new[i].UseDevice(true);
+    U_new[i] = 0.0;
+    C_new[i] = 0.0;
+    for (int l = 0; l < k; l++)
+    {
+      U_new[i].Add(PR(l, i), U[l]);
+      C_new[i].Add(Q(l, i), C[l]);
+    }
+    for (int l = 0; l < m; l++)
+    {
+      U_new[i].Add(PR(k + l, i), V[l]);
+    }
+    for (int l = 0; l <= m; l++)
+    {
+      C_new[i].Add(Q(k + l, i), V[l]);
+    }
+  }
+  U = std::move(U_new);
+  C = std::move(C_new);
+}
+
+template <typename OperType>
+void GcroDrSolver<OperType>::Mult(const VecType &b, VecType &x) const
+{
+  // Set up workspace.
+  RealType beta = 0.0, true_beta, eps = 0.0;
+  MFEM_VERIFY(A, "Operator must be set for GcroDrSolver::Mult!");
+  MFEM_ASSERT(A->Width() == x.Size() && A->Height() == b.Size(),
+              "Size mismatch for GcroDrSolver::Mult!");
+  r.SetSize(A->Height());
+  r.UseDevice(true);
+  Initialize();
+
+  // Update the recycled subspace when the operator has changed since the last solve. These
+  // operator applications are not counted as iterations.
+  if (update_recycle)
+  {
+    UpdateRecycleSpace();
+    update_recycle = false;
+  }
+  auto AddSolutionUpdate = [&]()
+  {
+    if (B)
+    {
+      ApplyB(B, y, z, this->use_timer);
+      x += z;
+    }
+    else
+    {
+      x += y;
+    }
+  };
+
+  // Begin iterations.
+  converged = false;
+  int it = 0, restart = 0;
+  if (print_opts.iterations)
+  {
+    Mpi::Print(comm, "{}Residual norms for GCRO-DR solve (recycled dimension {:d})\n",
+               std::string(tab_width + int_width - 1, ' '), U.size());
+  }
+  for (; it < max_it; restart++)
+  {
+    // Initialize.
+    InitialResidual(PrecSide::RIGHT, A, B, b, x, r, V[0],
+                    (this->initial_guess || restart > 0), this->use_timer);
+    true_beta = linalg::Norml2(comm, r);
+    CheckDot(true_beta, "GCRO-DR residual norm is not valid: beta = ");
+    if (it == 0)
+    {
+      if (this->initial_guess)
+      {
+        auto beta_rhs = linalg::Norml2(comm, b);
+        CheckDot(beta_rhs, "GCRO-DR residual norm is not valid: beta_rhs = ");
+        initial_res = beta_rhs;
+      }
+      else
+      {
+        initial_res = true_beta;
+      }
+      eps = std::max(rel_tol * initial_res, abs_tol);
+    }
+    else if (beta > 0.0 && std::abs(beta - true_beta) > 0.1 * true_beta &&
+             print_opts.warnings)
+    {
+      Mpi::Print(
+          comm,
+          "{}GCRO-DR residual at restart ({:.6e}) is far from the residual norm estimate "
+          "from the recursion formula ({:.6e}) (initial residual = {:.6e})\n",
+          std::string(tab_width, ' '), true_beta, beta, initial_res);
+    }
+
+    // Deflate the residual using the recycled subspace, r = (I - C Cᴴ) r, with the
+    // corresponding solution update y = U Cᴴ r.
+    const int k = static_cast<int>(C.size());
+    y = 0.0;
+    if (k > 0)
+    {
+      OrthogonalizeIteration(orthog_type, comm, C, r, w.data(), k - 1);
+      for (int i = 0; i < k; i++)
+      {
+        y.Add(w[i], U[i]);
+      }
+      true_beta = linalg::Norml2(comm, r);
+    }
+    beta = true_beta;
+    if (beta < eps)
+    {
+      converged = true;
+      if (k > 0)
+      {
+        AddSolutionUpdate();
+      }
+      break;
+    }
+
+    V[0] = 0.0;
+    V[0].Add(1.0 / beta, r);
+    std::fill(s.begin(), s.end(), 0.0);
+    s[0] = beta;
+
+    // Arnoldi process for (I - C Cᴴ) A B, with the projections Bk = Cᴴ A B V_m.
+    const int m = max_dim - k;
+    int j = 0;
+    for (;; j++, it++)
+    {
+      if (print_opts.iterations)
+      {
+        Mpi::Print(comm, "{}{:{}d} (restart {:d}) KSP residual norm {:.6e}\n",
+                   std::string(tab_width, ' '), it, int_width, restart, beta);
+      }
+      VecType &v = V[j + 1];
+      if (v.Size() == 0)
+      {
+        this->Update(j);
+      }
+      ApplyBA(PrecSide::RIGHT, A, B, V[j], v, z, this->use_timer);
+
+      if (k > 0)
+      {
+        ScalarType *Bj = Bk.data() + j * max_recycle_dim;
+        OrthogonalizeIteration(orthog_type, comm, C, v, Bj, k - 1);
+      }
+      ScalarType *Hj = H.data() + j * (max_dim + 1);
+      OrthogonalizeIteration(orthog_type, comm, V, v, Hj, j);
+      Hj[j + 1] = linalg::Norml2(comm, v);
+      v *= 1.0 / Hj[j + 1];
+      std::copy(Hj, Hj + j + 2, Hh.data() + j * (max_dim + 1));
+
+      for (int l = 0; l < j; l++)
+      {
+        ApplyPlaneRotation(Hj[l], Hj[l + 1], cs[l], sn[l]);
+      }
+      GeneratePlaneRotation(Hj[j], Hj[j + 1], cs[j], sn[j]);
+      ApplyPlaneRotation(Hj[j], Hj[j + 1], cs[j], sn[j]);
+      ApplyPlaneRotation(s[j], s[j + 1], cs[j], sn[j]);
+
+      beta = std::abs(s[j + 1]);
+      CheckDot(beta, "GCRO-DR residual norm is not valid: beta = ");
+      converged = (beta < eps);
+      if (converged || j + 1 == m || it + 1 == max_it)
+      {
+        it++;
+        break;
+      }
+    }
+
+    // Reconstruct the solution update y += V_m z - U Bk z (for restart or due to
+    // convergence or maximum iterations).
+    for (int i = j; i >= 0; i--)
+    {
+      ScalarType *Hi = H.data() + i * (max_dim + 1);
+      s[i] /= Hi[i];
+      for (int l = i - 1; l >= 0; l--)
+      {
+        s[l] -= Hi[l] * s[i];
+      }
+    }
+    for (int l = 0; l <= j; l++)
+    {
+      y.Add(s[l], V[l]);
+    }
+    for (int i = 0; i < k; i++)
+    {
+      ScalarType t = 0.0;
+      for (int l = 0; l <= j; l++)
+      {
+        t += Bk[l * max_recycle_dim + i] * s[l];
+      }
+      y.Add(-t, U[i]);
+    }
+    AddSolutionUpdate();
+
+    // Update the recycled subspace from the current cycle.
+    if (max_recycle_dim > 0)
+    {
+      ComputeRecycleSpace(j + 1);
+    }
+    if (converged)
+    {
+      break;
+    }
+  }
+  if (print_opts.iterations)
+  {
+    Mpi::Print(comm, "{}{:{}d} (restart {:d}) KSP residual norm {:.6e}\n",
+               std::string(tab_width, ' '), it, int_width, restart, beta);
+  }
+  if (print_opts.summary || (print_opts.warnings && eps > 0.0 && !converged))
+  {
+    Mpi::Print(comm, "{}GCRO-DR solver {} in {:d} iteration{}",
+               std::string(tab_width, ' '),
+               converged ? "converged" : "did NOT converge", it, (it == 1) ? "" : "s");
+    if (it > 0)
+    {
+      Mpi::Print(comm, " (avg. reduction factor: {:.3e})\n",
+                 std::pow(beta / initial_res, 1.0 / it));
+    }
+    else
+    {
+      Mpi::Print(comm, "\n");
+    }
+  }
+  final_res = beta;
+  final_it = it;
+}
+
 template class IterativeSolver<Operator>;
 template class IterativeSolver<ComplexOperator>;
 template class CgSolver<Operator>;
 template class CgSolver<ComplexOperator>;
+template class PipelinedCgSolver<Operator>;
+template class PipelinedCgSolver<ComplexOperator>;
 template class GmresSolver<Operator>;
 template class GmresSolver<ComplexOperator>;
 template class FgmresSolver<Operator>;
 template class FgmresSolver<ComplexOperator>;
+template class GcroDrSolver<Operator>;
+template class GcroDrSolver<ComplexOperator>;
 
 }  // namespace palace
@@ -133,13 +133,61 @@ protected:
   using IterativeSolver<OperType>::final_res;
   using IterativeSolver<OperType>::final_it;
 
-  // Temporary workspace for solve.
-  mutable VecType r, z, p;
+  // Temporary workspace for solves, with one vector of each of R, Z, and P used for a
+  // single right-hand side and one per right-hand side for block solves.
+  mutable std::vector<VecType> R, Z, P, Q;
 
 public:
   CgSolver(MPI_Comm comm, int print) : IterativeSolver<OperType>(comm, print) {}
 
   void Mult(const VecType &b, VecType &x) const override;
+
+  // Solve for multiple right-hand sides at once using the breakdown-free block PCG method
+  // of Ji and Li, A breakdown-free block conjugate gradient method, BIT Numer. Math.
+  // (2017). The search directions for all right-hand sides share a single Krylov subspace,
+  // with linearly dependent directions and those of converged right-hand sides dropped
+  // during the orthonormalization of each new block. All inner products for an iteration
+  // are computed with two global reductions. The reported residuals are those of the
+  // right-hand side with the largest relative residual.
+  void Mult(const std::vector<VecType> &b, std::vector<VecType> &x) const;
+};
+
+// Pipelined preconditioned Conjugate Gradient method for SPD linear systems, which uses a
+// single nonblocking reduction per iteration overlapped with the application of the
+// preconditioner and operator. See Ghysels and Vanroose, Hiding global synchronization
+// latency in the preconditioned Conjugate Gradient algorithm, Parallel Comput. (2014).
+template <typename OperType>
+class PipelinedCgSolver : public IterativeSolver<OperType>
+{
+protected:
+  using VecType = typename Solver<OperType>::VecType;
+  using RealType = typename IterativeSolver<OperType>::RealType;
+  using ScalarType = typename IterativeSolver<OperType>::ScalarType;
+
+  using IterativeSolver<OperType>::comm;
+  using IterativeSolver<OperType>::print_opts;
+  using IterativeSolver<OperType>::int_width;
+  using IterativeSolver<OperType>::tab_width;
+
+  using IterativeSolver<OperType>::rel_tol;
+  using IterativeSolver<OperType>::abs_tol;
+  using IterativeSolver<OperType>::max_it;
+
+  using IterativeSolver<OperType>::A;
+  using IterativeSolver<OperType>::B;
+
+  using IterativeSolver<OperType>::converged;
+  using IterativeSolver<OperType>::initial_res;
+  using IterativeSolver<OperType>::final_res;
+  using IterativeSolver<OperType>::final_it;
+
+  // Temporary workspace for solve.
+  mutable VecType r, u, w, m, n, p, q, s, z;
+
+public:
+  PipelinedCgSolver(MPI_Comm comm, int print) : IterativeSolver<OperType>(comm, print) {}
+
+  void Mult(const VecType &b, VecType &x) const override;
 };
 
 // Base class defining enums for GMRES.
@@ -150,7 +198,8 @@ public:
   {
     MGS,
     CGS,
-    CGS2
+    CGS2,
+    DCGS2
   };
 
   enum class PrecSide
@@ -204,10 +253,20 @@ protected:
   mutable std::vector<ScalarType> s, sn;
   mutable std::vector<RealType> cs;
 
+  // Temporary workspace for the low-synchronization Arnoldi process: the Hessenberg matrix
+  // before the Givens rotations are applied, and the coefficients of the delayed
+  // reorthogonalization.
+  mutable std::vector<ScalarType> Hu, c, g;
+
   // Allocate storage for solve.
   virtual void Initialize() const;
   virtual void Update(int j) const;
 
+  // Run one cycle of the Arnoldi process with one-reduce delayed classical Gram-Schmidt
+  // (DCGS2) orthogonalization, starting from the normalized V[0]. Returns the index of the
+  // last column of the Hessenberg matrix.
+  int ArnoldiDCGS2(int restart, RealType eps, RealType &beta, int &it) const;
+
 public:
   GmresSolver(MPI_Comm comm, int print)
     : IterativeSolver<OperType>(comm, print), max_dim(-1), orthog_type(OrthogType::MGS),
@@ -289,6 +348,109 @@ public:
   void Mult(const VecType &b, VecType &x) const override;
 };
 
+// Generalized Conjugate Residual method with inner Orthogonalization and Deflated
+// Restarting (GCRO-DR) for sequences of general nonsymmetric linear systems. A subspace of
+// harmonic Ritz vectors is retained across restarts and across calls to Mult, and is used
+// to deflate the Krylov space for subsequent solves with the same or a slowly varying
+// operator. Only right preconditioning is supported. See Parks et al., Recycling Krylov
+// subspaces for sequences of linear systems, SIAM J. Sci. Comput. (2006).
+template <typename OperType>
+class GcroDrSolver : public GmresSolver<OperType>
+{
+public:
+  using OrthogType = typename GmresSolverBase::OrthogType;
+  using PrecSide = typename GmresSolverBase::PrecSide;
+
+protected:
+  using VecType = typename GmresSolver<OperType>::VecType;
+  using RealType = typename GmresSolver<OperType>::RealType;
+  using ScalarType = typename GmresSolver<OperType>::ScalarType;
+
+  using GmresSolver<OperType>::comm;
+  using GmresSolver<OperType>::print_opts;
+  using GmresSolver<OperType>::int_width;
+  using GmresSolver<OperType>::tab_width;
+
+  using GmresSolver<OperType>::rel_tol;
+  using GmresSolver<OperType>::abs_tol;
+  using GmresSolver<OperType>::max_it;
+
+  using GmresSolver<OperType>::A;
+  using GmresSolver<OperType>::B;
+
+  using GmresSolver<OperType>::converged;
+  using GmresSolver<OperType>::initial_res;
+  using GmresSolver<OperType>::final_res;
+  using GmresSolver<OperType>::final_it;
+
+  using GmresSolver<OperType>::max_dim;
+  using GmresSolver<OperType>::orthog_type;
+  using GmresSolver<OperType>::pc_side;
+  using GmresSolver<OperType>::V;
+  using GmresSolver<OperType>::r;
+  using GmresSolver<OperType>::H;
+  using GmresSolver<OperType>::s;
+  using GmresSolver<OperType>::sn;
+  using GmresSolver<OperType>::cs;
+
+  // Maximum dimension of the recycled subspace.
+  int max_recycle_dim;
+
+  // Recycled subspace, with A B U = C and C having orthonormal columns. C is recomputed
+  // from U when the operator changes.
+  mutable std::vector<VecType> U, C;
+  mutable bool update_recycle;
+
+  // Temporary workspace for solve.
+  mutable VecType y, z;
+  mutable std::vector<ScalarType> Hh, Bk, w;
+
+  // Allocate storage for solve.
+  void Initialize() const override;
+
+  // Recompute C = A B U for a new operator and orthonormalize.
+  void UpdateRecycleSpace() const;
+
+  // Compute a new recycled subspace from harmonic Ritz vectors of the subspace [U V_m]
+  // following an Arnoldi cycle of length m.
+  void ComputeRecycleSpace(int m) const;
+
+public:
+  GcroDrSolver(MPI_Comm comm, int print)
+    : GmresSolver<OperType>(comm, print), max_recycle_dim(0), update_recycle(false)
+  {
+    pc_side = PrecSide::RIGHT;
+  }
+
+  // Set the maximum dimension of the recycled subspace.
+  void SetRecycleDim(int dim) { max_recycle_dim = dim; }
+
+  // Discard the recycled subspace.
+  void ClearRecycleSpace()
+  {
+    U.clear();
+    C.clear();
+  }
+
+  void SetOperator(const OperType &op) override
+  {
+    if (A && A->Height() != op.Height())
+    {
+      ClearRecycleSpace();
+    }
+    GmresSolver<OperType>::SetOperator(op);
+    update_recycle = true;
+  }
+
+  void SetPrecSide(PrecSide side) override
+  {
+    MFEM_VERIFY(side == PrecSide::RIGHT,
+                "GCRO-DR solver only supports right preconditioning!");
+  }
+
+  void Mult(const VecType &b, VecType &x) const override;
+};
+
 }  // namespace palace
 
 #endif  // PALACE_LINALG_ITERATIVE_HPP
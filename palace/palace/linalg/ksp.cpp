@@ -35,6 +35,9 @@ std::unique_ptr<IterativeSolver<OperType>> ConfigureKrylovSolver(MPI_Comm comm,
     case config::LinearSolverData::KspType::CG:
       ksp = std::make_unique<CgSolver<OperType>>(comm, print);
       break;
+    case config::LinearSolverData::KspType::PIPECG:
+      ksp = std::make_unique<PipelinedCgSolver<OperType>>(comm, print);
+      break;
     case config::LinearSolverData::KspType::GMRES:
       {
         auto gmres = std::make_unique<GmresSolver<OperType>>(comm, print);
@@ -49,6 +52,14 @@ std::unique_ptr<IterativeSolver<OperType>> ConfigureKrylovSolver(MPI_Comm comm,
         ksp = std::move(fgmres);
       }
       break;
+    case config::LinearSolverData::KspType::GCRODR:
+      {
+        auto gcrodr = std::make_unique<GcroDrSolver<OperType>>(comm, print);
+        gcrodr->SetRestartDim(iodata.solver.linear.max_size);
+        gcrodr->SetRecycleDim(iodata.solver.linear.recycle_size);
+        ksp = std::move(gcrodr);
+      }
+      break;
     case config::LinearSolverData::KspType::MINRES:
     case config::LinearSolverData::KspType::BICGSTAB:
     case config::LinearSolverData::KspType::DEFAULT:
@@ -87,11 +98,12 @@ std::unique_ptr<IterativeSolver<OperType>> ConfigureKrylovSolver(MPI_Comm comm,
     }
   }
 
-  // Configure orthogonalization method for GMRES/FMGRES.
+  // Configure orthogonalization method for GMRES/FMGRES/GCRO-DR.
   if (type == config::LinearSolverData::KspType::GMRES ||
-      type == config::LinearSolverData::KspType::FGMRES)
+      type == config::LinearSolverData::KspType::FGMRES ||
+      type == config::LinearSolverData::KspType::GCRODR)
   {
-    // Because FGMRES inherits from GMRES, this is OK.
+    // Because FGMRES and GCRO-DR inherit from GMRES, this is OK.
     auto *gmres = static_cast<GmresSolver<OperType> *>(ksp.get());
     switch (iodata.solver.linear.gs_orthog_type)
     {
@@ -104,6 +116,18 @@ std::unique_ptr<IterativeSolver<OperType>> ConfigureKrylovSolver(MPI_Comm comm,
       case config::LinearSolverData::OrthogType::CGS2:
         gmres->SetOrthogonalization(GmresSolverBase::OrthogType::CGS2);
         break;
+      case config::LinearSolverData::OrthogType::DCGS2:
+        if (type == config::LinearSolverData::KspType::GMRES)
+        {
+          gmres->SetOrthogonalization(GmresSolverBase::OrthogType::DCGS2);
+        }
+        else
+        {
+          Mpi::Warning(comm, "DCGS2 orthogonalization is only available for GMRES, using "
+                             "CGS2 instead!\n");
+          gmres->SetOrthogonalization(GmresSolverBase::OrthogType::CGS2);
+        }
+        break;
     }
   }
 
@@ -248,7 +272,8 @@ BaseKspSolver<OperType>::BaseKspSolver(const IoData &iodata,
 template <typename OperType>
 BaseKspSolver<OperType>::BaseKspSolver(std::unique_ptr<IterativeSolver<OperType>> &&ksp,
                                        std::unique_ptr<Solver<OperType>> &&pc)
-  : ksp(std::move(ksp)), pc(std::move(pc)), ksp_mult(0), ksp_mult_it(0), use_timer(false)
+  : ksp(std::move(ksp)), pc(std::move(pc)), ksp_mult(0), ksp_mult_it(0), ksp_mult_rhs(0),
+    use_timer(false)
 {
   if (this->pc)
   {
@@ -290,6 +315,36 @@ void BaseKspSolver<OperType>::Mult(const VecType &x, VecType &y) const
   }
   ksp_mult++;
   ksp_mult_it += ksp->GetNumIterations();
+  ksp_mult_rhs++;
+}
+
+template <typename OperType>
+void BaseKspSolver<OperType>::Mult(const std::vector<VecType> &X,
+                                   std::vector<VecType> &Y) const
+{
+  MFEM_VERIFY(X.size() == Y.size(),
+              "Mismatch in number of right-hand sides and solutions for linear solve!");
+  const auto *cg = dynamic_cast<const CgSolver<OperType> *>(ksp.get());
+  if (!cg || X.size() < 2)
+  {
+    for (std::size_t i = 0; i < X.size(); i++)
+    {
+      Mult(X[i], Y[i]);
+    }
+    return;
+  }
+  BlockTimer bt(Timer::KSP, use_timer);
+  cg->Mult(X, Y);
+  if (!ksp->GetConverged())
+  {
+    Mpi::Warning(ksp->GetComm(),
+                 "Block linear solver did not converge, norm(Ax-b)/norm(b) = {:.3e} "
+                 "(norm(b) = {:.3e})!\n",
+                 ksp->GetFinalRes() / ksp->GetInitialRes(), ksp->GetInitialRes());
+  }
+  ksp_mult++;
+  ksp_mult_it += ksp->GetNumIterations();
+  ksp_mult_rhs += static_cast<int>(X.size());
 }
 
 template class BaseKspSolver<Operator>;
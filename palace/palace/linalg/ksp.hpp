@@ -6,6 +6,7 @@
 
 #include <memory>
 #include <type_traits>
+#include <vector>
 #include "linalg/iterative.hpp"
 #include "linalg/operator.hpp"
 #include "linalg/solver.hpp"
@@ -34,9 +35,9 @@ protected:
   std::unique_ptr<IterativeSolver<OperType>> ksp;
   std::unique_ptr<Solver<OperType>> pc;
 
-  // Counters for number of calls to Mult method for linear solves, and cumulative number
-  // of iterations.
-  mutable int ksp_mult, ksp_mult_it;
+  // Counters for number of linear solves (a block solve for multiple right-hand sides
+  // counts once), cumulative number of iterations, and number of right-hand sides solved.
+  mutable int ksp_mult, ksp_mult_it, ksp_mult_rhs;
 
   // Enable timer contribution for Timer::KSP_PRECONDITIONER.
   bool use_timer;
@@ -49,10 +50,15 @@ public:
 
   int NumTotalMult() const { return ksp_mult; }
   int NumTotalMultIterations() const { return ksp_mult_it; }
+  int NumTotalMultRHS() const { return ksp_mult_rhs; }
 
   void SetOperators(const OperType &op, const OperType &pc_op);
 
   void Mult(const VecType &x, VecType &y) const;
+
+  // Solve for multiple right-hand sides. When the Krylov solver is CG, all right-hand sides
+  // are solved together using block CG, otherwise they are solved one after another.
+  void Mult(const std::vector<VecType> &X, std::vector<VecType> &Y) const;
 };
 
 using KspSolver = BaseKspSolver<Operator>;
@@ -9,6 +9,25 @@
 namespace palace
 {
 
+namespace
+{
+
+bool StageBlock(const ComplexVector &x, const FiniteElementSpace &fespace)
+{
+  // Vectors whose real and imaginary parts are not stored contiguously are staged through
+  // a T-vector workspace, so that the parallel prolongation (or its transpose) can be
+  // applied to both parts as a two-column block. The block path is not used with GPU
+  // builds of HYPRE, and otherwise only for HypreParMatrix prolongation operators.
+#if defined(HYPRE_USING_GPU)
+  return false;
+#else
+  return dynamic_cast<const mfem::HypreParMatrix *>(fespace.GetProlongationMatrix()) &&
+         x.Imag().GetData() != x.Real().GetData() + x.Size();
+#endif
+}
+
+}  // namespace
+
 ParOperator::ParOperator(std::unique_ptr<Operator> &&dA, const Operator *pA,
                          const FiniteElementSpace &trial_fespace,
                          const FiniteElementSpace &test_fespace, bool test_restrict)
@@ -471,24 +490,34 @@ void ComplexParOperator::Mult(const ComplexVector &x, ComplexVector &y) const
 
   auto &lx = trial_fespace.GetLVector<ComplexVector>();
   auto &ly = GetTestLVector();
-  if (dbc_tdof_list.Size())
+  if (dbc_tdof_list.Size() || StageBlock(x, trial_fespace))
   {
     auto &tx = trial_fespace.GetTVector<ComplexVector>();
     tx = x;
-    linalg::SetSubVector(tx, dbc_tdof_list, 0.0);
-    trial_fespace.GetProlongationMatrix()->Mult(tx.Real(), lx.Real());
-    trial_fespace.GetProlongationMatrix()->Mult(tx.Imag(), lx.Imag());
+    if (dbc_tdof_list.Size())
+    {
+      linalg::SetSubVector(tx, dbc_tdof_list, 0.0);
+    }
+    ProlongationMult(tx, lx);
   }
   else
   {
-    trial_fespace.GetProlongationMatrix()->Mult(x.Real(), lx.Real());
-    trial_fespace.GetProlongationMatrix()->Mult(x.Imag(), lx.Imag());
+    ProlongationMult(x, lx);
   }
 
   // Apply the operator on the L-vector.
-  A->Mult(lx, ly);
+  LocalMult(lx, ly, false, false);
 
-  RestrictionMatrixMult(ly, y);
+  if (!use_R && StageBlock(y, test_fespace))
+  {
+    auto &ty = test_fespace.GetTVector<ComplexVector>();
+    RestrictionMatrixMult(ly, ty);
+    y = ty;
+  }
+  else
+  {
+    RestrictionMatrixMult(ly, y);
+  }
   if (dbc_tdof_list.Size())
   {
     if (diag_policy == Operator::DiagonalPolicy::DIAG_ONE)
@@ -509,11 +538,14 @@ void ComplexParOperator::MultTranspose(const ComplexVector &x, ComplexVector &y)
 
   auto &lx = trial_fespace.GetLVector<ComplexVector>();
   auto &ly = GetTestLVector();
-  if (dbc_tdof_list.Size())
+  if (dbc_tdof_list.Size() || (!use_R && StageBlock(x, test_fespace)))
   {
     auto &ty = test_fespace.GetTVector<ComplexVector>();
     ty = x;
-    linalg::SetSubVector(ty, dbc_tdof_list, 0.0);
+    if (dbc_tdof_list.Size())
+    {
+      linalg::SetSubVector(ty, dbc_tdof_list, 0.0);
+    }
     RestrictionMatrixMultTranspose(ty, ly);
   }
   else
@@ -522,10 +554,18 @@ void ComplexParOperator::MultTranspose(const ComplexVector &x, ComplexVector &y)
   }
 
   // Apply the operator on the L-vector.
-  A->MultTranspose(ly, lx);
+  LocalMult(ly, lx, true, false);
 
-  trial_fespace.GetProlongationMatrix()->MultTranspose(lx.Real(), y.Real());
-  trial_fespace.GetProlongationMatrix()->MultTranspose(lx.Imag(), y.Imag());
+  if (StageBlock(y, trial_fespace))
+  {
+    auto &tx = trial_fespace.GetTVector<ComplexVector>();
+    ProlongationMultTranspose(lx, tx);
+    y = tx;
+  }
+  else
+  {
+    ProlongationMultTranspose(lx, y);
+  }
   if (dbc_tdof_list.Size())
   {
     if (diag_policy == Operator::DiagonalPolicy::DIAG_ONE)
@@ -547,11 +587,14 @@ void ComplexParOperator::MultHermitianTranspose(const ComplexVector &x,
 
   auto &lx = trial_fespace.GetLVector<ComplexVector>();
   auto &ly = GetTestLVector();
-  if (dbc_tdof_list.Size())
+  if (dbc_tdof_list.Size() || (!use_R && StageBlock(x, test_fespace)))
   {
     auto &ty = test_fespace.GetTVector<ComplexVector>();
     ty = x;
-    linalg::SetSubVector(ty, dbc_tdof_list, 0.0);
+    if (dbc_tdof_list.Size())
+    {
+      linalg::SetSubVector(ty, dbc_tdof_list, 0.0);
+    }
     RestrictionMatrixMultTranspose(ty, ly);
   }
   else
@@ -560,10 +603,18 @@ void ComplexParOperator::MultHermitianTranspose(const ComplexVector &x,
   }
 
   // Apply the operator on the L-vector.
-  A->MultHermitianTranspose(ly, lx);
+  LocalMult(ly, lx, true, true);
 
-  trial_fespace.GetProlongationMatrix()->MultTranspose(lx.Real(), y.Real());
-  trial_fespace.GetProlongationMatrix()->MultTranspose(lx.Imag(), y.Imag());
+  if (StageBlock(y, trial_fespace))
+  {
+    auto &tx = trial_fespace.GetTVector<ComplexVector>();
+    ProlongationMultTranspose(lx, tx);
+    y = tx;
+  }
+  else
+  {
+    ProlongationMultTranspose(lx, y);
+  }
   if (dbc_tdof_list.Size())
   {
     if (diag_policy == Operator::DiagonalPolicy::DIAG_ONE)
@@ -585,22 +636,23 @@ void ComplexParOperator::AddMult(const ComplexVector &x, ComplexVector &y,
 
   auto &lx = trial_fespace.GetLVector<ComplexVector>();
   auto &ly = GetTestLVector();
-  if (dbc_tdof_list.Size())
+  if (dbc_tdof_list.Size() || StageBlock(x, trial_fespace))
   {
     auto &tx = trial_fespace.GetTVector<ComplexVector>();
     tx = x;
-    linalg::SetSubVector(tx, dbc_tdof_list, 0.0);
-    trial_fespace.GetProlongationMatrix()->Mult(tx.Real(), lx.Real());
-    trial_fespace.GetProlongationMatrix()->Mult(tx.Imag(), lx.Imag());
+    if (dbc_tdof_list.Size())
+    {
+      linalg::SetSubVector(tx, dbc_tdof_list, 0.0);
+    }
+    ProlongationMult(tx, lx);
   }
   else
   {
-    trial_fespace.GetProlongationMatrix()->Mult(x.Real(), lx.Real());
-    trial_fespace.GetProlongationMatrix()->Mult(x.Imag(), lx.Imag());
+    ProlongationMult(x, lx);
   }
 
   // Apply the operator on the L-vector.
-  A->Mult(lx, ly);
+  LocalMult(lx, ly, false, false);
 
   auto &ty = test_fespace.GetTVector<ComplexVector>();
   RestrictionMatrixMult(ly, ty);
@@ -626,11 +678,14 @@ void ComplexParOperator::AddMultTranspose(const ComplexVector &x, ComplexVector
 
   auto &lx = trial_fespace.GetLVector<ComplexVector>();
   auto &ly = GetTestLVector();
-  if (dbc_tdof_list.Size())
+  if (dbc_tdof_list.Size() || (!use_R && StageBlock(x, test_fespace)))
   {
     auto &ty = test_fespace.GetTVector<ComplexVector>();
     ty = x;
-    linalg::SetSubVector(ty, dbc_tdof_list, 0.0);
+    if (dbc_tdof_list.Size())
+    {
+      linalg::SetSubVector(ty, dbc_tdof_list, 0.0);
+    }
     RestrictionMatrixMultTranspose(ty, ly);
   }
   else
@@ -639,11 +694,10 @@ void ComplexParOperator::AddMultTranspose(const ComplexVector &x, ComplexVector
   }
 
   // Apply the operator on the L-vector.
-  A->MultTranspose(ly, lx);
+  LocalMult(ly, lx, true, false);
 
   auto &tx = trial_fespace.GetTVector<ComplexVector>();
-  trial_fespace.GetProlongationMatrix()->MultTranspose(lx.Real(), tx.Real());
-  trial_fespace.GetProlongationMatrix()->MultTranspose(lx.Imag(), tx.Imag());
+  ProlongationMultTranspose(lx, tx);
   if (dbc_tdof_list.Size())
   {
     if (diag_policy == Operator::DiagonalPolicy::DIAG_ONE)
@@ -666,11 +720,14 @@ void ComplexParOperator::AddMultHermitianTranspose(const ComplexVector &x, Compl
 
   auto &lx = trial_fespace.GetLVector<ComplexVector>();
   auto &ly = GetTestLVector();
-  if (dbc_tdof_list.Size())
+  if (dbc_tdof_list.Size() || (!use_R && StageBlock(x, test_fespace)))
   {
     auto &ty = test_fespace.GetTVector<ComplexVector>();
     ty = x;
-    linalg::SetSubVector(ty, dbc_tdof_list, 0.0);
+    if (dbc_tdof_list.Size())
+    {
+      linalg::SetSubVector(ty, dbc_tdof_list, 0.0);
+    }
     RestrictionMatrixMultTranspose(ty, ly);
   }
   else
@@ -679,11 +736,10 @@ void ComplexParOperator::AddMultHermitianTranspose(const ComplexVector &x, Compl
   }
 
   // Apply the operator on the L-vector.
-  A->MultHermitianTranspose(ly, lx);
+  LocalMult(ly, lx, true, true);
 
   auto &tx = trial_fespace.GetTVector<ComplexVector>();
-  trial_fespace.GetProlongationMatrix()->MultTranspose(lx.Real(), tx.Real());
-  trial_fespace.GetProlongationMatrix()->MultTranspose(lx.Imag(), tx.Imag());
+  ProlongationMultTranspose(lx, tx);
   if (dbc_tdof_list.Size())
   {
     if (diag_policy == Operator::DiagonalPolicy::DIAG_ONE)
@@ -698,13 +754,97 @@ void ComplexParOperator::AddMultHermitianTranspose(const ComplexVector &x, Compl
   y.AXPY(a, tx);
 }
 
+void ComplexParOperator::LocalMult(const ComplexVector &x, ComplexVector &y, bool transpose,
+                                   bool conj) const
+{
+  // When both parts of the local operator are assembled sparse matrices, each is applied to
+  // the real and imaginary parts of the input together, streaming each matrix only once
+  // instead of twice.
+  const auto *Ar = dynamic_cast<const hypre::HypreCSRMatrix *>(A->Real());
+  const auto *Ai = dynamic_cast<const hypre::HypreCSRMatrix *>(A->Imag());
+  if ((A->Real() && !Ar) || (A->Imag() && !Ai))
+  {
+    if (!transpose)
+    {
+      A->Mult(x, y);
+    }
+    else if (conj)
+    {
+      A->MultHermitianTranspose(x, y);
+    }
+    else
+    {
+      A->MultTranspose(x, y);
+    }
+    return;
+  }
+  if (Ar)
+  {
+    Ar->MultBlock(x, y, 1.0, 0.0, transpose);
+  }
+  else
+  {
+    y = 0.0;
+  }
+  if (Ai)
+  {
+    // y += i Ai x (or -i Aiᵀ x for the Hermitian transpose).
+    lz.UseDevice(true);
+    lz.SetSize(2 * y.Size());
+    ComplexVector z(lz, 0, y.Size());
+    Ai->MultBlock(x, z, 1.0, 0.0, transpose);
+    const double s = conj ? -1.0 : 1.0;
+    linalg::AXPY(-s, z.Imag(), y.Real());
+    linalg::AXPY(s, z.Real(), y.Imag());
+  }
+}
+
+void ComplexParOperator::ProlongationMult(const ComplexVector &tx, ComplexVector &lx) const
+{
+  // The prolongation is applied to the real and imaginary parts together, exchanging the
+  // shared degrees of freedom of both in a single round of communication.
+  const auto *P = trial_fespace.GetProlongationMatrix();
+  if (const auto *hP = dynamic_cast<const mfem::HypreParMatrix *>(P))
+  {
+    hypre::ParMultBlock(*hP, tx, lx);
+  }
+  else
+  {
+    P->Mult(tx.Real(), lx.Real());
+    P->Mult(tx.Imag(), lx.Imag());
+  }
+}
+
+void ComplexParOperator::ProlongationMultTranspose(const ComplexVector &lx,
+                                                   ComplexVector &tx) const
+{
+  const auto *P = trial_fespace.GetProlongationMatrix();
+  if (const auto *hP = dynamic_cast<const mfem::HypreParMatrix *>(P))
+  {
+    hypre::ParMultBlock(*hP, lx, tx, true);
+  }
+  else
+  {
+    P->MultTranspose(lx.Real(), tx.Real());
+    P->MultTranspose(lx.Imag(), tx.Imag());
+  }
+}
+
 void ComplexParOperator::RestrictionMatrixMult(const ComplexVector &ly,
                                                ComplexVector &ty) const
 {
   if (!use_R)
   {
-    test_fespace.GetProlongationMatrix()->MultTranspose(ly.Real(), ty.Real());
-    test_fespace.GetProlongationMatrix()->MultTranspose(ly.Imag(), ty.Imag());
+    const auto *P = test_fespace.GetProlongationMatrix();
+    if (const auto *hP = dynamic_cast<const mfem::HypreParMatrix *>(P))
+    {
+      hypre::ParMultBlock(*hP, ly, ty, true);
+    }
+    else
+    {
+      P->MultTranspose(ly.Real(), ty.Real());
+      P->MultTranspose(ly.Imag(), ty.Imag());
+    }
   }
   else
   {
@@ -718,8 +858,16 @@ void ComplexParOperator::RestrictionMatrixMultTranspose(const ComplexVector &ty,
 {
   if (!use_R)
   {
-    test_fespace.GetProlongationMatrix()->Mult(ty.Real(), ly.Real());
-    test_fespace.GetProlongationMatrix()->Mult(ty.Imag(), ly.Imag());
+    const auto *P = test_fespace.GetProlongationMatrix();
+    if (const auto *hP = dynamic_cast<const mfem::HypreParMatrix *>(P))
+    {
+      hypre::ParMultBlock(*hP, ty, ly);
+    }
+    else
+    {
+      P->Mult(ty.Real(), ly.Real());
+      P->Mult(ty.Imag(), ly.Imag());
+    }
   }
   else
   {
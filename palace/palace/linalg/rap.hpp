@@ -130,7 +130,16 @@ private:
   // Real and imaginary parts of the operator as non-owning ParOperator objects.
   std::unique_ptr<ParOperator> RAPr, RAPi;
 
-  // Helper methods for operator application.
+  // Temporary storage for the application of assembled local operators.
+  mutable Vector lz;
+
+  // Helper methods for operator application. The real and imaginary parts are prolonged
+  // and restricted together, as a two-column block. The local operator is applied to both
+  // parts together only when it is fully assembled, partially assembled (libCEED) local
+  // operators apply each part separately.
+  void LocalMult(const ComplexVector &x, ComplexVector &y, bool transpose, bool conj) const;
+  void ProlongationMult(const ComplexVector &tx, ComplexVector &lx) const;
+  void ProlongationMultTranspose(const ComplexVector &lx, ComplexVector &tx) const;
   void RestrictionMatrixMult(const ComplexVector &ly, ComplexVector &ty) const;
   void RestrictionMatrixMultTranspose(const ComplexVector &ty, ComplexVector &ly) const;
   ComplexVector &GetTestLVector() const;
@@ -278,6 +278,22 @@ int main(int argc, char *argv[])
   }
 #endif
 
+  // For a parallel-in-frequency driven sweep, split the world communicator into contiguous
+  // groups of processes which each own a copy of the distributed mesh.
+  MPI_Comm comm = world_comm;
+  if (iodata.problem.type == config::ProblemData::Type::DRIVEN &&
+      iodata.solver.driven.freq_groups > 1)
+  {
+    const int n_group = iodata.solver.driven.freq_groups;
+    MFEM_VERIFY(world_size % n_group == 0,
+                "Number of MPI processes (" << world_size
+                                            << ") must be divisible by the number of "
+                                               "frequency groups ("
+                                            << n_group << ")!");
+    MPI_Comm_split(world_comm, Mpi::Rank(world_comm) / (world_size / n_group),
+                   Mpi::Rank(world_comm), &comm);
+  }
+
   // Initialize the problem driver.
   PrintPalaceInfo(world_comm, world_size, omp_threads, ngpu, device);
   const auto solver = [&]() -> std::unique_ptr<BaseSolver>
@@ -285,8 +301,8 @@ int main(int argc, char *argv[])
     switch (iodata.problem.type)
     {
       case config::ProblemData::Type::DRIVEN:
-        return std::make_unique<DrivenSolver>(iodata, world_root, world_size, omp_threads,
-                                              GetPalaceGitTag());
+        return std::make_unique<DrivenSolver>(iodata, Mpi::Root(comm), world_size,
+                                              omp_threads, GetPalaceGitTag());
       case config::ProblemData::Type::EIGENMODE:
         return std::make_unique<EigenSolver>(iodata, world_root, world_size, omp_threads,
                                              GetPalaceGitTag());
@@ -308,7 +324,7 @@ int main(int argc, char *argv[])
   std::vector<std::unique_ptr<Mesh>> mesh;
   {
     std::vector<std::unique_ptr<mfem::ParMesh>> mfem_mesh;
-    mfem_mesh.push_back(mesh::ReadMesh(world_comm, iodata));
+    mfem_mesh.push_back(mesh::ReadMesh(comm, iodata));
     iodata.NondimensionalizeInputs(*mfem_mesh[0]);
     mesh::RefineMesh(iodata, mfem_mesh);
     for (auto &m : mfem_mesh)
@@ -328,6 +344,13 @@ int main(int argc, char *argv[])
   // Finalize libCEED.
   ceed::Finalize();
 
+  // Free the communicator for frequency groups, after the mesh objects using it.
+  mesh.clear();
+  if (comm != world_comm)
+  {
+    MPI_Comm_free(&comm);
+  }
+
   // Finalize SLEPc/PETSc.
 #if defined(PALACE_WITH_SLEPC)
   slepc::Finalize();
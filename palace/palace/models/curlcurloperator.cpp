@@ -21,7 +21,8 @@ namespace palace
 
 CurlCurlOperator::CurlCurlOperator(const IoData &iodata,
                                    const std::vector<std::unique_ptr<Mesh>> &mesh)
-  : print_hdr(true), dbc_attr(SetUpBoundaryProperties(iodata, *mesh.back())),
+  : print_hdr(true), mg_single(iodata.solver.linear.mg_single_precision),
+    dbc_attr(SetUpBoundaryProperties(iodata, *mesh.back())),
     nd_fecs(fem::ConstructFECollections<mfem::ND_FECollection>(
         iodata.solver.order, mesh.back()->Dimension(), iodata.solver.linear.mg_max_levels,
         iodata.solver.linear.mg_coarsen_type, false)),
@@ -184,6 +185,10 @@ std::unique_ptr<Operator> CurlCurlOperator::GetStiffnessMatrix()
         Mpi::Print("\n");
       }
     }
+    if (mg_single && l > 0 && l < GetNDSpaces().GetNumLevels() - 1)
+    {
+      k_vec[l] = hypre::ToSinglePrecision(std::move(k_vec[l]));
+    }
     auto K_l = std::make_unique<ParOperator>(std::move(k_vec[l]), nd_fespace_l);
     K_l->SetEssentialTrueDofs(dbc_tdof_lists[l], Operator::DiagonalPolicy::DIAG_ONE);
     K->AddOperator(std::move(K_l));
@@ -28,6 +28,9 @@ private:
   // Helper variable for log file printing.
   bool print_hdr;
 
+  // Use single precision operators for the intermediate multigrid levels.
+  const bool mg_single;
+
   // Essential boundary condition attributes.
   mfem::Array<int> dbc_attr;
   std::vector<mfem::Array<int>> dbc_tdof_lists;
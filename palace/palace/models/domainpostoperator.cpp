@@ -140,6 +140,36 @@ DomainPostOperator::DomainPostOperator(const IoData &iodata, const MaterialOpera
 }
 
 double DomainPostOperator::GetElectricFieldEnergy(const GridFunction &E) const
+{
+  double dot = GetLocalElectricFieldEnergy(E);
+  Mpi::GlobalSum(1, &dot, E.GetComm());
+  return dot;
+}
+
+double DomainPostOperator::GetMagneticFieldEnergy(const GridFunction &B) const
+{
+  double dot = GetLocalMagneticFieldEnergy(B);
+  Mpi::GlobalSum(1, &dot, B.GetComm());
+  return dot;
+}
+
+double DomainPostOperator::GetDomainElectricFieldEnergy(int idx,
+                                                        const GridFunction &E) const
+{
+  double dot = GetLocalDomainElectricFieldEnergy(idx, E);
+  Mpi::GlobalSum(1, &dot, E.GetComm());
+  return dot;
+}
+
+double DomainPostOperator::GetDomainMagneticFieldEnergy(int idx,
+                                                        const GridFunction &B) const
+{
+  double dot = GetLocalDomainMagneticFieldEnergy(idx, B);
+  Mpi::GlobalSum(1, &dot, B.GetComm());
+  return dot;
+}
+
+double DomainPostOperator::GetLocalElectricFieldEnergy(const GridFunction &E) const
 {
   if (M_elec)
   {
@@ -150,7 +180,6 @@ double DomainPostOperator::GetElectricFieldEnergy(const GridFunction &E) const
       M_elec->Mult(E.Imag(), D);
       dot += linalg::LocalDot(E.Imag(), D);
     }
-    Mpi::GlobalSum(1, &dot, E.GetComm());
     return 0.5 * dot;
   }
   MFEM_ABORT(
@@ -158,7 +187,7 @@ double DomainPostOperator::GetElectricFieldEnergy(const GridFunction &E) const
   return 0.0;
 }
 
-double DomainPostOperator::GetMagneticFieldEnergy(const GridFunction &B) const
+double DomainPostOperator::GetLocalMagneticFieldEnergy(const GridFunction &B) const
 {
   if (M_mag)
   {
@@ -169,7 +198,6 @@ double DomainPostOperator::GetMagneticFieldEnergy(const GridFunction &B) const
       M_mag->Mult(B.Imag(), H);
       dot += linalg::LocalDot(B.Imag(), H);
     }
-    Mpi::GlobalSum(1, &dot, B.GetComm());
     return 0.5 * dot;
   }
   MFEM_ABORT(
@@ -177,8 +205,8 @@ double DomainPostOperator::GetMagneticFieldEnergy(const GridFunction &B) const
   return 0.0;
 }
 
-double DomainPostOperator::GetDomainElectricFieldEnergy(int idx,
-                                                        const GridFunction &E) const
+double DomainPostOperator::GetLocalDomainElectricFieldEnergy(int idx,
+                                                             const GridFunction &E) const
 {
   // Compute the electric field energy integral for only a portion of the domain.
   auto it = M_i.find(idx);
@@ -195,12 +223,11 @@ double DomainPostOperator::GetDomainElectricFieldEnergy(int idx,
     it->second.first->Mult(E.Imag(), D);
     dot += linalg::LocalDot(E.Imag(), D);
   }
-  Mpi::GlobalSum(1, &dot, E.GetComm());
   return 0.5 * dot;
 }
 
-double DomainPostOperator::GetDomainMagneticFieldEnergy(int idx,
-                                                        const GridFunction &B) const
+double DomainPostOperator::GetLocalDomainMagneticFieldEnergy(int idx,
+                                                             const GridFunction &B) const
 {
   // Compute the magnetic field energy integral for only a portion of the domain.
   auto it = M_i.find(idx);
@@ -217,7 +244,6 @@ double DomainPostOperator::GetDomainMagneticFieldEnergy(int idx,
     it->second.second->Mult(B.Imag(), H);
     dot += linalg::LocalDot(B.Imag(), H);
   }
-  Mpi::GlobalSum(1, &dot, B.GetComm());
   return 0.5 * dot;
 }
 
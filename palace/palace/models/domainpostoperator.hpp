@@ -49,6 +49,14 @@ public:
   // domain.
   double GetDomainElectricFieldEnergy(int idx, const GridFunction &E) const;
   double GetDomainMagneticFieldEnergy(int idx, const GridFunction &E) const;
+
+  // Get the contributions of the local process to the above volume integrals, without the
+  // global reduction across processes. These allow several quantities to be reduced with a
+  // single communication.
+  double GetLocalElectricFieldEnergy(const GridFunction &E) const;
+  double GetLocalMagneticFieldEnergy(const GridFunction &B) const;
+  double GetLocalDomainElectricFieldEnergy(int idx, const GridFunction &E) const;
+  double GetLocalDomainMagneticFieldEnergy(int idx, const GridFunction &B) const;
 };
 
 }  // namespace palace
@@ -20,7 +20,8 @@ namespace palace
 
 LaplaceOperator::LaplaceOperator(const IoData &iodata,
                                  const std::vector<std::unique_ptr<Mesh>> &mesh)
-  : print_hdr(true), dbc_attr(SetUpBoundaryProperties(iodata, *mesh.back())),
+  : print_hdr(true), mg_single(iodata.solver.linear.mg_single_precision),
+    dbc_attr(SetUpBoundaryProperties(iodata, *mesh.back())),
     h1_fecs(fem::ConstructFECollections<mfem::H1_FECollection>(
         iodata.solver.order, mesh.back()->Dimension(), iodata.solver.linear.mg_max_levels,
         iodata.solver.linear.mg_coarsen_type, false)),
@@ -216,6 +217,10 @@ std::unique_ptr<Operator> LaplaceOperator::GetStiffnessMatrix()
         Mpi::Print("\n");
       }
     }
+    if (mg_single && l > 0 && l < GetH1Spaces().GetNumLevels() - 1)
+    {
+      k_vec[l] = hypre::ToSinglePrecision(std::move(k_vec[l]));
+    }
     auto K_l = std::make_unique<ParOperator>(std::move(k_vec[l]), h1_fespace_l);
     K_l->SetEssentialTrueDofs(dbc_tdof_lists[l], Operator::DiagonalPolicy::DIAG_ONE);
     K->AddOperator(std::move(K_l));
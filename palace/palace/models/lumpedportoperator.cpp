@@ -221,66 +221,46 @@ void LumpedPortData::InitializeLinearForms(mfem::ParFiniteElementSpace &nd_fespa
 }
 
 std::complex<double> LumpedPortData::GetPower(GridFunction &E, GridFunction &B) const
+{
+  std::complex<double> dot = GetLocalPower(E, B);
+  Mpi::GlobalSum(1, &dot, E.GetComm());
+  return dot;
+}
+
+std::complex<double> LumpedPortData::GetSParameter(GridFunction &E) const
+{
+  std::complex<double> dot = GetLocalSParameter(E);
+  Mpi::GlobalSum(1, &dot, E.GetComm());
+  return dot;
+}
+
+std::complex<double> LumpedPortData::GetVoltage(GridFunction &E) const
+{
+  std::complex<double> dot = GetLocalVoltage(E);
+  Mpi::GlobalSum(1, &dot, E.GetComm());
+  return dot;
+}
+
+std::complex<double> LumpedPortData::GetLocalPower(GridFunction &E, GridFunction &B) const
 {
   // Compute port power, (E x H) ⋅ n = E ⋅ (-n x H), integrated over the port surface using
   // the computed E and H = μ⁻¹ B fields, where +n is the direction of propagation (into the
-  // domain). The BdrSurfaceCurrentVectorCoefficient computes -n x H for an outward normal,
-  // so we multiply by -1. The linear form is reconstructed from scratch each time due to
-  // changing H.
-  MFEM_VERIFY((E.HasImag() && B.HasImag()) || (!E.HasImag() && !B.HasImag()),
-              "Mismatch between real- and complex-valued E and B fields in port power "
-              "calculation!");
-  const bool has_imag = E.HasImag();
-  auto &nd_fespace = *E.ParFESpace();
-  const auto &mesh = *nd_fespace.GetParMesh();
-  SumVectorCoefficient fbr(mesh.SpaceDimension()), fbi(mesh.SpaceDimension());
-  mfem::Array<int> attr_list;
-  for (const auto &elem : elems)
+  // domain). The boundary coupling operator is assembled once and reused for every new E
+  // and B.
+  if (!p)
   {
-    fbr.AddCoefficient(
-        std::make_unique<RestrictedVectorCoefficient<BdrSurfaceCurrentVectorCoefficient>>(
-            elem->GetAttrList(), B.Real(), mat_op));
-    if (has_imag)
+    mfem::Array<int> attr_list;
+    for (const auto &elem : elems)
     {
-      fbi.AddCoefficient(
-          std::make_unique<RestrictedVectorCoefficient<BdrSurfaceCurrentVectorCoefficient>>(
-              elem->GetAttrList(), B.Imag(), mat_op));
+      attr_list.Append(elem->GetAttrList());
     }
-    attr_list.Append(elem->GetAttrList());
-  }
-  int bdr_attr_max = mesh.bdr_attributes.Size() ? mesh.bdr_attributes.Max() : 0;
-  mfem::Array<int> attr_marker = mesh::AttrToMarker(bdr_attr_max, attr_list);
-  std::complex<double> dot;
-  {
-    mfem::LinearForm pr(&nd_fespace);
-    pr.AddBoundaryIntegrator(new VectorFEBoundaryLFIntegrator(fbr), attr_marker);
-    pr.UseFastAssembly(false);
-    pr.UseDevice(false);
-    pr.Assemble();
-    pr.UseDevice(true);
-    dot = -(pr * E.Real()) + (has_imag ? -1i * (pr * E.Imag()) : 0.0);
-  }
-  if (has_imag)
-  {
-    mfem::LinearForm pi(&nd_fespace);
-    pi.AddBoundaryIntegrator(new VectorFEBoundaryLFIntegrator(fbi), attr_marker);
-    pi.UseFastAssembly(false);
-    pi.UseDevice(false);
-    pi.Assemble();
-    pi.UseDevice(true);
-    dot += -(pi * E.Imag()) + 1i * (pi * E.Real());
-    Mpi::GlobalSum(1, &dot, E.ParFESpace()->GetComm());
-    return dot;
-  }
-  else
-  {
-    double rdot = dot.real();
-    Mpi::GlobalSum(1, &rdot, E.ParFESpace()->GetComm());
-    return rdot;
+    p = std::make_unique<SurfacePowerOperator>(*E.ParFESpace(), *B.ParFESpace(), mat_op,
+                                               attr_list);
   }
+  return p->GetLocalPower(E, B);
 }
 
-std::complex<double> LumpedPortData::GetSParameter(GridFunction &E) const
+std::complex<double> LumpedPortData::GetLocalSParameter(GridFunction &E) const
 {
   // Compute port S-parameter, or the projection of the field onto the port mode.
   InitializeLinearForms(*E.ParFESpace());
@@ -289,11 +269,10 @@ std::complex<double> LumpedPortData::GetSParameter(GridFunction &E) const
   {
     dot.imag((*s) * E.Imag());
   }
-  Mpi::GlobalSum(1, &dot, E.GetComm());
   return dot;
 }
 
-std::complex<double> LumpedPortData::GetVoltage(GridFunction &E) const
+std::complex<double> LumpedPortData::GetLocalVoltage(GridFunction &E) const
 {
   // Compute the average voltage across the port.
   InitializeLinearForms(*E.ParFESpace());
@@ -302,7 +281,6 @@ std::complex<double> LumpedPortData::GetVoltage(GridFunction &E) const
   {
     dot.imag((*v) * E.Imag());
   }
-  Mpi::GlobalSum(1, &dot, E.GetComm());
   return dot;
 }
 
@@ -636,27 +614,34 @@ void LumpedPortOperator::AddMassBdrCoefficients(double coeff,
 
 void LumpedPortOperator::AddExcitationBdrCoefficients(SumVectorCoefficient &fb)
 {
-  // Construct the RHS source term for lumped port boundaries, which looks like -U_inc =
-  // +2 iω/Z_s E_inc for a port boundary with an incident field E_inc. The chosen incident
-  // field magnitude corresponds to a unit incident power over the full port boundary. See
-  // p. 49 and p. 82 of the COMSOL RF Module manual for more detail.
-  // Note: The real RHS returned here does not yet have the factor of (iω) included, so
-  // works for time domain simulations requiring RHS -U_inc(t).
   for (const auto &[idx, data] : ports)
   {
     if (!data.excitation)
     {
       continue;
     }
-    MFEM_VERIFY(std::abs(data.R) > 0.0,
-                "Unexpected zero resistance in excited lumped port!");
-    for (const auto &elem : data.elems)
-    {
-      const double Rs = data.R * data.GetToSquare(*elem);
-      const double Hinc = 1.0 / std::sqrt(Rs * elem->GetGeometryWidth() *
-                                          elem->GetGeometryLength() * data.elems.size());
-      fb.AddCoefficient(elem->GetModeCoefficient(2.0 * Hinc));
-    }
+    AddExcitationBdrCoefficients(idx, fb);
+  }
+}
+
+void LumpedPortOperator::AddExcitationBdrCoefficients(int idx, SumVectorCoefficient &fb)
+{
+  // Construct the RHS source term for lumped port boundaries, which looks like -U_inc =
+  // +2 iω/Z_s E_inc for a port boundary with an incident field E_inc. The chosen incident
+  // field magnitude corresponds to a unit incident power over the full port boundary. See
+  // p. 49 and p. 82 of the COMSOL RF Module manual for more detail.
+  // Note: The real RHS returned here does not yet have the factor of (iω) included, so
+  // works for time domain simulations requiring RHS -U_inc(t).
+  const LumpedPortData &data = GetPort(idx);
+  MFEM_VERIFY(data.excitation,
+              "Lumped port index " << idx << " is not marked for excitation!");
+  MFEM_VERIFY(std::abs(data.R) > 0.0, "Unexpected zero resistance in excited lumped port!");
+  for (const auto &elem : data.elems)
+  {
+    const double Rs = data.R * data.GetToSquare(*elem);
+    const double Hinc = 1.0 / std::sqrt(Rs * elem->GetGeometryWidth() *
+                                        elem->GetGeometryLength() * data.elems.size());
+    fb.AddCoefficient(elem->GetModeCoefficient(2.0 * Hinc));
   }
 }
 
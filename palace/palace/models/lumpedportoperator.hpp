@@ -10,6 +10,7 @@
 #include <vector>
 #include <mfem.hpp>
 #include "fem/lumpedelement.hpp"
+#include "fem/surfacepower.hpp"
 
 namespace palace
 {
@@ -48,6 +49,9 @@ private:
   // Linear forms for postprocessing integrated quantities on the port.
   mutable std::unique_ptr<mfem::LinearForm> s, v;
 
+  // Boundary coupling operator for postprocessing the port power.
+  mutable std::unique_ptr<SurfacePowerOperator> p;
+
   void InitializeLinearForms(mfem::ParFiniteElementSpace &nd_fespace) const;
 
 public:
@@ -75,6 +79,12 @@ public:
   std::complex<double> GetPower(GridFunction &E, GridFunction &B) const;
   std::complex<double> GetSParameter(GridFunction &E) const;
   std::complex<double> GetVoltage(GridFunction &E) const;
+
+  // Contributions of the local process to the port power, S-parameter, and voltage, without
+  // the global reduction across processes.
+  std::complex<double> GetLocalPower(GridFunction &E, GridFunction &B) const;
+  std::complex<double> GetLocalSParameter(GridFunction &E) const;
+  std::complex<double> GetLocalVoltage(GridFunction &E) const;
 };
 
 //
@@ -118,8 +128,10 @@ public:
 
   // Add contributions to the right-hand side source term vector for an incident field at
   // excited port boundaries, -U_inc/(iω) for the real version (versus the full -U_inc for
-  // the complex one).
+  // the complex one). The second overload adds only the contribution from the excited port
+  // with the given index.
   void AddExcitationBdrCoefficients(SumVectorCoefficient &fb);
+  void AddExcitationBdrCoefficients(int idx, SumVectorCoefficient &fb);
 };
 
 }  // namespace palace
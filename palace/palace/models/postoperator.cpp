@@ -3,6 +3,8 @@
 
 #include "postoperator.hpp"
 
+#include <algorithm>
+#include <limits>
 #include "fem/coefficient.hpp"
 #include "fem/errorindicator.hpp"
 #include "models/curlcurloperator.hpp"
@@ -12,7 +14,6 @@
 #include "models/surfacecurrentoperator.hpp"
 #include "models/waveportoperator.hpp"
 #include "utils/communication.hpp"
-#include "utils/geodata.hpp"
 #include "utils/iodata.hpp"
 
 namespace palace
@@ -48,10 +49,8 @@ PostOperator::PostOperator(const IoData &iodata, SpaceOperator &space_op,
     B(std::make_unique<GridFunction>(space_op.GetRTSpace(),
                                      iodata.problem.type !=
                                          config::ProblemData::Type::TRANSIENT)),
-    lumped_port_init(false), wave_port_init(false),
-    paraview(CreateParaviewPath(iodata, name), &space_op.GetNDSpace().GetParMesh()),
-    paraview_bdr(CreateParaviewPath(iodata, name) + "_boundary",
-                 &space_op.GetNDSpace().GetParMesh()),
+    lumped_port_init(false), wave_port_init(false), energy_init(false),
+    measurement_init(false), reduced_init(false),
     interp_op(iodata, space_op.GetNDSpace().GetParMesh())
 {
   bool side_n_min = (iodata.boundaries.postpro.side ==
@@ -85,7 +84,7 @@ PostOperator::PostOperator(const IoData &iodata, SpaceOperator &space_op,
   }
 
   // Initialize data collection objects.
-  InitializeDataCollection(iodata);
+  InitializeDataCollection(iodata, name);
 }
 
 PostOperator::PostOperator(const IoData &iodata, LaplaceOperator &laplace_op,
@@ -95,10 +94,7 @@ PostOperator::PostOperator(const IoData &iodata, LaplaceOperator &laplace_op,
     dom_post_op(iodata, laplace_op.GetMaterialOp(), laplace_op.GetH1Space()),
     E(std::make_unique<GridFunction>(laplace_op.GetNDSpace())),
     V(std::make_unique<GridFunction>(laplace_op.GetH1Space())), lumped_port_init(false),
-    wave_port_init(false),
-    paraview(CreateParaviewPath(iodata, name), &laplace_op.GetNDSpace().GetParMesh()),
-    paraview_bdr(CreateParaviewPath(iodata, name) + "_boundary",
-                 &laplace_op.GetNDSpace().GetParMesh()),
+    wave_port_init(false), energy_init(false), measurement_init(false), reduced_init(false),
     interp_op(iodata, laplace_op.GetNDSpace().GetParMesh())
 {
   // Note: When using this constructor, you should not use any of the magnetic field related
@@ -115,7 +111,7 @@ PostOperator::PostOperator(const IoData &iodata, LaplaceOperator &laplace_op,
       &E->Real(), nullptr, mat_op, true, mfem::Vector());
 
   // Initialize data collection objects.
-  InitializeDataCollection(iodata);
+  InitializeDataCollection(iodata, name);
 }
 
 PostOperator::PostOperator(const IoData &iodata, CurlCurlOperator &curlcurl_op,
@@ -125,10 +121,7 @@ PostOperator::PostOperator(const IoData &iodata, CurlCurlOperator &curlcurl_op,
     dom_post_op(iodata, curlcurl_op.GetMaterialOp(), curlcurl_op.GetNDSpace()),
     B(std::make_unique<GridFunction>(curlcurl_op.GetRTSpace())),
     A(std::make_unique<GridFunction>(curlcurl_op.GetNDSpace())), lumped_port_init(false),
-    wave_port_init(false),
-    paraview(CreateParaviewPath(iodata, name), &curlcurl_op.GetNDSpace().GetParMesh()),
-    paraview_bdr(CreateParaviewPath(iodata, name) + "_boundary",
-                 &curlcurl_op.GetNDSpace().GetParMesh()),
+    wave_port_init(false), energy_init(false), measurement_init(false), reduced_init(false),
     interp_op(iodata, curlcurl_op.GetNDSpace().GetParMesh())
 {
   // Note: When using this constructor, you should not use any of the electric field related
@@ -144,37 +137,34 @@ PostOperator::PostOperator(const IoData &iodata, CurlCurlOperator &curlcurl_op,
   J_sr = std::make_unique<BdrSurfaceCurrentVectorCoefficient>(B->Real(), mat_op);
 
   // Initialize data collection objects.
-  InitializeDataCollection(iodata);
+  InitializeDataCollection(iodata, name);
 }
 
-void PostOperator::InitializeDataCollection(const IoData &iodata)
+void PostOperator::InitializeDataCollection(const IoData &iodata, const std::string &name)
 {
   // Set up postprocessing for output to disk. Results are stored in a directory at
-  // `iodata.problem.output/paraview`.
-  const mfem::VTKFormat format = mfem::VTKFormat::BINARY32;
-#if defined(MFEM_USE_ZLIB)
-  const int compress = -1;  // Default compression level
-#else
-  const int compress = 0;
-#endif
-  const bool use_ho = true;
+  // `iodata.problem.output/paraview`. The output mesh coordinate units are the same as the
+  // input, and fields on H(curl) and H(div) spaces are scaled to "undo" the effect of
+  // redimensionalizing the mesh which would carry into the fields during the mapping from
+  // reference to physical space through the element Jacobians. No transformation for V is
+  // needed (H1 interpolation).
+  if (iodata.problem.output.empty())
+  {
+    return;
+  }
+  mfem::ParMesh &mesh =
+      HasE() ? *E->ParFESpace()->GetParMesh() : *B->ParFESpace()->GetParMesh();
   const int refine_ho = HasE() ? E->ParFESpace()->GetMaxElementOrder()
                                : B->ParFESpace()->GetMaxElementOrder();
-  mesh_Lc0 = iodata.GetMeshLengthScale();
-
-  // Output mesh coordinate units same as input.
-  paraview.SetCycle(-1);
-  paraview.SetDataFormat(format);
-  paraview.SetCompressionLevel(compress);
-  paraview.SetHighOrderOutput(use_ho);
-  paraview.SetLevelsOfDetail(refine_ho);
-
-  //paraview_bdr.SetBoundaryOutput(true);
-  paraview_bdr.SetCycle(-1);
-  paraview_bdr.SetDataFormat(format);
-  paraview_bdr.SetCompressionLevel(compress);
-  paraview_bdr.SetHighOrderOutput(use_ho);
-  paraview_bdr.SetLevelsOfDetail(refine_ho);
+  const double L = iodata.GetMeshLengthScale();
+  const double Ld = std::pow(L, mesh.Dimension() - 1);
+  paraview = std::make_unique<FieldWriter>(CreateParaviewPath(iodata, name), mesh, L,
+                                           refine_ho, iodata.problem.async_output);
+  if (iodata.problem.type == config::ProblemData::Type::TRANSIENT &&
+      iodata.solver.transient.restart)
+  {
+    paraview->UseRestartMode(true);
+  }
 
   // Output fields @ phase = 0 and π/2 for frequency domain (rather than, for example,
   // peak phasors or magnitude = sqrt(2) * RMS). Also output fields evaluated on mesh
@@ -185,14 +175,14 @@ void PostOperator::InitializeDataCollection(const IoData &iodata)
   {
     if (HasImag())
     {
-      paraview.RegisterField("E_real", &E->Real());
-      paraview.RegisterField("E_imag", &E->Imag());
+      paraview->RegisterField("E_real", E->Real(), L);
+      paraview->RegisterField("E_imag", E->Imag(), L);
       //paraview_bdr.RegisterField("E_real", E_sr.get());
       //paraview_bdr.RegisterField("E_imag", E_si.get());
     }
     else
     {
-      paraview.RegisterField("E", &E->Real());
+      paraview->RegisterField("E", E->Real(), L);
       //paraview_bdr.RegisterField("E", E_sr.get());
     }
   }
@@ -200,25 +190,25 @@ void PostOperator::InitializeDataCollection(const IoData &iodata)
   {
     if (HasImag())
     {
-      paraview.RegisterField("B_real", &B->Real());
-      paraview.RegisterField("B_imag", &B->Imag());
+      paraview->RegisterField("B_real", B->Real(), Ld);
+      paraview->RegisterField("B_imag", B->Imag(), Ld);
       //paraview_bdr.RegisterField("B_real", B_sr.get());
       //paraview_bdr.RegisterField("B_imag", B_si.get());
     }
     else
     {
-      paraview.RegisterField("B", &B->Real());
+      paraview->RegisterField("B", B->Real(), Ld);
       //paraview_bdr.RegisterField("B", B_sr.get());
     }
   }
   if (V)
   {
-    paraview.RegisterField("V", &V->Real());
+    paraview->RegisterField("V", V->Real());
     //paraview_bdr.RegisterField("V", V_s.get());
   }
   if (A)
   {
-    paraview.RegisterField("A", &A->Real());
+    paraview->RegisterField("A", A->Real(), L);
     //paraview_bdr.RegisterField("A", A_s.get());
   }
 
@@ -288,7 +278,8 @@ void PostOperator::SetEGridFunction(const ComplexVector &e, bool exchange_face_n
     E->Real().ExchangeFaceNbrData();  // Ready for parallel comm on shared faces
     E->Imag().ExchangeFaceNbrData();
   }
-  lumped_port_init = wave_port_init = false;
+  lumped_port_init = wave_port_init = reduced_init = false;
+  energy_init = measurement_init = false;
 }
 
 void PostOperator::SetBGridFunction(const ComplexVector &b, bool exchange_face_nbr_data)
@@ -303,7 +294,8 @@ void PostOperator::SetBGridFunction(const ComplexVector &b, bool exchange_face_n
     B->Real().ExchangeFaceNbrData();  // Ready for parallel comm on shared faces
     B->Imag().ExchangeFaceNbrData();
   }
-  lumped_port_init = wave_port_init = false;
+  lumped_port_init = wave_port_init = reduced_init = false;
+  energy_init = measurement_init = false;
 }
 
 void PostOperator::SetEGridFunction(const Vector &e, bool exchange_face_nbr_data)
@@ -316,7 +308,8 @@ void PostOperator::SetEGridFunction(const Vector &e, bool exchange_face_nbr_data
   {
     E->Real().ExchangeFaceNbrData();
   }
-  lumped_port_init = wave_port_init = false;
+  lumped_port_init = wave_port_init = reduced_init = false;
+  energy_init = measurement_init = false;
 }
 
 void PostOperator::SetBGridFunction(const Vector &b, bool exchange_face_nbr_data)
@@ -329,7 +322,8 @@ void PostOperator::SetBGridFunction(const Vector &b, bool exchange_face_nbr_data
   {
     B->Real().ExchangeFaceNbrData();
   }
-  lumped_port_init = wave_port_init = false;
+  lumped_port_init = wave_port_init = reduced_init = false;
+  energy_init = measurement_init = false;
 }
 
 void PostOperator::SetVGridFunction(const Vector &v, bool exchange_face_nbr_data)
@@ -342,6 +336,7 @@ void PostOperator::SetVGridFunction(const Vector &v, bool exchange_face_nbr_data
   {
     V->Real().ExchangeFaceNbrData();
   }
+  energy_init = measurement_init = false;
 }
 
 void PostOperator::SetAGridFunction(const Vector &a, bool exchange_face_nbr_data)
@@ -354,58 +349,321 @@ void PostOperator::SetAGridFunction(const Vector &a, bool exchange_face_nbr_data
   {
     A->Real().ExchangeFaceNbrData();
   }
+  energy_init = measurement_init = false;
 }
 
-double PostOperator::GetEFieldEnergy() const
+bool PostOperator::SetReducedBasis(const std::vector<Vector> &V, std::size_t n,
+                                   const Operator &Curl,
+                                   const LumpedPortOperator &lumped_port_op,
+                                   const WavePortOperator &wave_port_op)
 {
-  if (V)
+  MFEM_VERIFY(HasImag() && E && B, "Incorrect usage of PostOperator::SetReducedBasis!");
+  MFEM_VERIFY(n <= V.size(), "Invalid dimension for reduced-order basis!");
+  reduced.reset();
+  reduced_init = false;
+  if (wave_port_op.Size() > 0 || !surf_post_op.eps_surfs.empty() ||
+      std::any_of(surf_post_op.flux_surfs.begin(), surf_post_op.flux_surfs.end(),
+                  [](const auto &surf)
+                  { return surf.second.type == SurfaceFluxType::POWER; }))
   {
-    return dom_post_op.GetElectricFieldEnergy(*V);
+    return false;
   }
-  else
+  reduced = std::make_unique<ReducedPostData>();
+  auto &data = *reduced;
+  data.y.setZero(n);
+  data.omega = 0.0;
+
+  // The basis for the magnetic flux density is W = ∇ x V, the factor -1/(iω) is applied
+  // when evaluating the quantities at a given frequency.
+  std::vector<Vector> W(n);
+  for (std::size_t j = 0; j < n; j++)
+  {
+    W[j].SetSize(Curl.Height());
+    W[j].UseDevice(true);
+    Curl.Mult(V[j], W[j]);
+  }
+
+  // Collect the quadratic forms for the field energies. The operators act on the local
+  // (L-vector) dofs of the grid functions.
+  struct ProjectionData
+  {
+    const Operator *M;
+    const mfem::ParGridFunction *U;
+    const std::vector<Vector> *W;
+    Eigen::MatrixXd *Mr;
+  };
+  std::vector<ProjectionData> proj;
+  auto AddProjection = [&](const Operator *M, bool elec, Eigen::MatrixXd &Mr)
+  {
+    if (M)
+    {
+      Mr.setZero(n, n);
+      proj.push_back({M, elec ? &E->Real() : &B->Real(), elec ? &V : &W, &Mr});
+    }
+  };
+  AddProjection(dom_post_op.M_elec.get(), true, data.M_elec);
+  AddProjection(dom_post_op.M_mag.get(), false, data.M_mag);
+  for (const auto &[idx, M] : dom_post_op.M_i)
+  {
+    auto &Mr = data.M_i[idx];
+    AddProjection(M.first.get(), true, Mr.first);
+    AddProjection(M.second.get(), false, Mr.second);
+  }
+  for (const auto &[idx, port] : lumped_port_op)
+  {
+    auto &vs = data.lumped_port_vs[idx];
+    vs.first.resize(n);
+    vs.second.resize(n);
+  }
+  for (const auto &[idx, surf] : surf_post_op.flux_surfs)
+  {
+    data.flux[idx].resize(n);
+  }
+  const bool probes = !interp_op.GetProbes().empty();
+  if (probes)
+  {
+    data.probe_E.setZero(interp_op.GetProbes().size() * E->VectorDim(), n);
+    data.probe_B.setZero(interp_op.GetProbes().size() * B->VectorDim(), n);
+  }
+
+  // Evaluate the quantities for each basis vector, with zero imaginary parts for the grid
+  // functions. The projected matrices are symmetric, so only the lower triangular part is
+  // computed, as wᵢᵀ (Pᵀ M P wⱼ) with the prolongation P from true dofs to local dofs. All
+  // quantities for a basis vector are reduced across processes with a single communication.
+  *E = 0.0;
+  *B = 0.0;
+  E->Imag().ExchangeFaceNbrData();
+  B->Imag().ExchangeFaceNbrData();
+  Vector D, d;
+  D.UseDevice(true);
+  d.UseDevice(true);
+  std::vector<double> dots;
+  for (std::size_t i = 0; i < n; i++)
+  {
+    E->Real().SetFromTrueDofs(V[i]);
+    B->Real().SetFromTrueDofs(W[i]);
+    E->Real().ExchangeFaceNbrData();
+    B->Real().ExchangeFaceNbrData();
+
+    dots.clear();
+    for (const auto &p : proj)
+    {
+      D.SetSize(p.M->Height());
+      d.SetSize(p.U->ParFESpace()->GetTrueVSize());
+      p.M->Mult(*p.U, D);
+      p.U->ParFESpace()->GetProlongationMatrix()->MultTranspose(D, d);
+      for (std::size_t j = 0; j <= i; j++)
+      {
+        dots.push_back(linalg::LocalDot((*p.W)[j], d));
+      }
+    }
+    for (const auto &[idx, port] : lumped_port_op)
+    {
+      dots.push_back(port.GetLocalVoltage(*E).real());
+      dots.push_back(port.GetLocalSParameter(*E).real());
+    }
+    for (const auto &[idx, flux] : data.flux)
+    {
+      dots.push_back(surf_post_op.GetLocalSurfaceFlux(idx, E.get(), B.get()).real());
+    }
+    Mpi::GlobalSum(dots.size(), dots.data(), GetComm());
+    auto it = dots.begin();
+    for (const auto &p : proj)
+    {
+      for (std::size_t j = 0; j <= i; j++)
+      {
+        (*p.Mr)(i, j) = (*p.Mr)(j, i) = *it++;
+      }
+    }
+    for (auto &[idx, vs] : data.lumped_port_vs)
+    {
+      vs.first(i) = *it++;
+      vs.second(i) = *it++;
+    }
+    for (auto &[idx, flux] : data.flux)
+    {
+      flux(i) = *it++;
+    }
+    if (probes)
+    {
+      interp_op.AddProbeFieldLocal(E->Real(), data.probe_E.col(i).data());
+      interp_op.AddProbeFieldLocal(B->Real(), data.probe_B.col(i).data());
+    }
+  }
+  if (probes)
   {
-    MFEM_VERIFY(E, "PostOperator is not configured for electric field energy calculation!");
-    return dom_post_op.GetElectricFieldEnergy(*E);
+    // The probe matrices are projected onto the basis with a single reduction.
+    Mpi::GlobalSum(data.probe_E.size(), data.probe_E.data(), GetComm());
+    Mpi::GlobalSum(data.probe_B.size(), data.probe_B.data(), GetComm());
   }
+  lumped_port_init = wave_port_init = energy_init = measurement_init = false;
+  return true;
 }
 
-double PostOperator::GetHFieldEnergy() const
+void PostOperator::SetReducedSolution(const Eigen::VectorXcd &y, double omega)
 {
-  if (A)
+  MFEM_VERIFY(reduced && y.size() == reduced->y.size(),
+              "Incorrect usage of PostOperator::SetReducedSolution!");
+  MFEM_VERIFY(omega > 0.0, "Reduced-order postprocessing requires nonzero frequency!");
+  reduced->y = y;
+  reduced->omega = omega;
+  reduced_init = true;
+  lumped_port_init = wave_port_init = false;
+}
+
+double PostOperator::GetReducedEnergy(const Eigen::MatrixXd &Mr, double coeff) const
+{
+  // For E = V y with real-valued V, 1/2 (Eᵣᵀ M Eᵣ + Eᵢᵀ M Eᵢ) = 1/2 yᴴ (Vᵀ M V) y.
+  if (Mr.size() == 0)
   {
-    return dom_post_op.GetMagneticFieldEnergy(*A);
+    return 0.0;
   }
-  else
+  const auto &y = reduced->y;
+  return 0.5 * coeff * std::real(y.dot(Mr.cast<std::complex<double>>() * y));
+}
+
+void PostOperator::InitializeEnergies() const
+{
+  // Compute the total electric and magnetic field energies, reduced across processes
+  // together.
+  if (energy_init)
+  {
+    return;
+  }
+  const GridFunction *U_elec = V ? V.get() : E.get();
+  const GridFunction *U_mag = A ? A.get() : B.get();
+  double dot[2] = {0.0, 0.0};
+  if (dom_post_op.M_elec && U_elec)
+  {
+    dot[0] = dom_post_op.GetLocalElectricFieldEnergy(*U_elec);
+  }
+  if (dom_post_op.M_mag && U_mag)
   {
-    MFEM_VERIFY(B, "PostOperator is not configured for magnetic field energy calculation!");
-    return dom_post_op.GetMagneticFieldEnergy(*B);
+    dot[1] = dom_post_op.GetLocalMagneticFieldEnergy(*U_mag);
   }
+  Mpi::GlobalSum(2, dot, GetComm());
+  measurements.E_elec = dot[0];
+  measurements.E_mag = dot[1];
+  energy_init = true;
 }
 
-double PostOperator::GetEFieldEnergy(int idx) const
+void PostOperator::InitializeMeasurements() const
 {
-  if (V)
+  // Compute the domain field energies and the surface flux and interface dielectric energy
+  // integrals for all configured postprocessing indices, reduced across processes together.
+  if (measurement_init)
+  {
+    return;
+  }
+  const GridFunction *U_elec = V ? V.get() : E.get();
+  const GridFunction *U_mag = A ? A.get() : B.get();
+  std::vector<double> dots;
+  dots.reserve(2 * (dom_post_op.M_i.size() + surf_post_op.flux_surfs.size()) +
+               surf_post_op.eps_surfs.size());
+  for (const auto &[idx, M] : dom_post_op.M_i)
   {
-    return dom_post_op.GetDomainElectricFieldEnergy(idx, *V);
+    dots.push_back(U_elec ? dom_post_op.GetLocalDomainElectricFieldEnergy(idx, *U_elec)
+                          : 0.0);
+    dots.push_back(U_mag ? dom_post_op.GetLocalDomainMagneticFieldEnergy(idx, *U_mag)
+                         : 0.0);
   }
-  else
+  for (const auto &[idx, data] : surf_post_op.flux_surfs)
   {
-    MFEM_VERIFY(E, "PostOperator is not configured for electric field energy calculation!");
-    return dom_post_op.GetDomainElectricFieldEnergy(idx, *E);
+    const auto dot = surf_post_op.GetLocalSurfaceFlux(idx, E.get(), B.get());
+    dots.push_back(dot.real());
+    dots.push_back(dot.imag());
   }
+  for (const auto &[idx, data] : surf_post_op.eps_surfs)
+  {
+    dots.push_back(E ? surf_post_op.GetLocalInterfaceElectricFieldEnergy(idx, *E) : 0.0);
+  }
+  Mpi::GlobalSum(dots.size(), dots.data(), GetComm());
+  auto it = dots.begin();
+  for (const auto &[idx, M] : dom_post_op.M_i)
+  {
+    auto &E_i = measurements.E_i[idx];
+    E_i.first = *it++;
+    E_i.second = *it++;
+  }
+  for (const auto &[idx, data] : surf_post_op.flux_surfs)
+  {
+    auto &flux = measurements.flux[idx];
+    flux.real(*it++);
+    flux.imag(*it++);
+  }
+  for (const auto &[idx, data] : surf_post_op.eps_surfs)
+  {
+    measurements.E_eps[idx] = *it++;
+  }
+  measurement_init = true;
 }
 
-double PostOperator::GetHFieldEnergy(int idx) const
+double PostOperator::GetEFieldEnergy() const
 {
-  if (A)
+  if (reduced_init)
   {
-    return dom_post_op.GetDomainMagneticFieldEnergy(idx, *A);
+    return GetReducedEnergy(reduced->M_elec, 1.0);
   }
-  else
+  MFEM_VERIFY(V || E,
+              "PostOperator is not configured for electric field energy calculation!");
+  MFEM_VERIFY(
+      dom_post_op.M_elec,
+      "Domain postprocessing is not configured for electric field energy calculation!");
+  InitializeEnergies();
+  return measurements.E_elec;
+}
+
+double PostOperator::GetHFieldEnergy() const
+{
+  if (reduced_init)
+  {
+    // B = -1/(iω) ∇ x E.
+    return GetReducedEnergy(reduced->M_mag, 1.0 / (reduced->omega * reduced->omega));
+  }
+  MFEM_VERIFY(A || B,
+              "PostOperator is not configured for magnetic field energy calculation!");
+  MFEM_VERIFY(
+      dom_post_op.M_mag,
+      "Domain postprocessing is not configured for magnetic field energy calculation!");
+  InitializeEnergies();
+  return measurements.E_mag;
+}
+
+double PostOperator::GetEFieldEnergy(int idx) const
+{
+  if (reduced_init)
+  {
+    auto it = reduced->M_i.find(idx);
+    MFEM_VERIFY(it != reduced->M_i.end(),
+                "Invalid domain index when postprocessing domain electric field energy!");
+    return GetReducedEnergy(it->second.first, 1.0);
+  }
+  MFEM_VERIFY(V || E,
+              "PostOperator is not configured for electric field energy calculation!");
+  InitializeMeasurements();
+  auto it = measurements.E_i.find(idx);
+  MFEM_VERIFY(it != measurements.E_i.end(),
+              "Invalid domain index when postprocessing domain electric field energy!");
+  return it->second.first;
+}
+
+double PostOperator::GetHFieldEnergy(int idx) const
+{
+  if (reduced_init)
   {
-    MFEM_VERIFY(B, "PostOperator is not configured for magnetic field energy calculation!");
-    return dom_post_op.GetDomainMagneticFieldEnergy(idx, *B);
+    auto it = reduced->M_i.find(idx);
+    MFEM_VERIFY(it != reduced->M_i.end(),
+                "Invalid domain index when postprocessing domain magnetic field energy!");
+    return GetReducedEnergy(it->second.second,
+                            1.0 / (reduced->omega * reduced->omega));
   }
+  MFEM_VERIFY(A || B,
+              "PostOperator is not configured for magnetic field energy calculation!");
+  InitializeMeasurements();
+  auto it = measurements.E_i.find(idx);
+  MFEM_VERIFY(it != measurements.E_i.end(),
+              "Invalid domain index when postprocessing domain magnetic field energy!");
+  return it->second.second;
 }
 
 std::complex<double> PostOperator::GetSurfaceFlux(int idx) const
@@ -413,7 +671,23 @@ std::complex<double> PostOperator::GetSurfaceFlux(int idx) const
   // Compute the flux through a surface as Φ_j = ∫ F ⋅ n_j dS, with F = B, F = ε D, or F =
   // E x H. The special coefficient is used to avoid issues evaluating MFEM GridFunctions
   // which are discontinuous at interior boundary elements.
-  return surf_post_op.GetSurfaceFlux(idx, E.get(), B.get());
+  if (reduced_init)
+  {
+    auto it = reduced->flux.find(idx);
+    MFEM_VERIFY(it != reduced->flux.end(),
+                "Unknown surface flux postprocessing index requested!");
+    std::complex<double> dot = it->second.cast<std::complex<double>>().dot(reduced->y);
+    if (surf_post_op.flux_surfs.at(idx).type == SurfaceFluxType::MAGNETIC)
+    {
+      dot *= 1i / reduced->omega;
+    }
+    return dot;
+  }
+  InitializeMeasurements();
+  auto it = measurements.flux.find(idx);
+  MFEM_VERIFY(it != measurements.flux.end(),
+              "Unknown surface flux postprocessing index requested!");
+  return it->second;
 }
 
 double PostOperator::GetInterfaceParticipation(int idx, double E_m) const
@@ -424,70 +698,125 @@ double PostOperator::GetInterfaceParticipation(int idx, double E_m) const
   // with:
   //          p_mj = 1/2 t_j Re{∫_{Γ_j} (ε_j E_m)ᴴ E_m dS} /(E_elec + E_cap).
   MFEM_VERIFY(E, "Surface Q not defined, no electric field solution found!");
-  return surf_post_op.GetInterfaceElectricFieldEnergy(idx, *E) / E_m;
+  MFEM_VERIFY(!reduced_init, "Interface dielectric participation is not available for a "
+                             "reduced-order solution!");
+  InitializeMeasurements();
+  auto it = measurements.E_eps.find(idx);
+  MFEM_VERIFY(it != measurements.E_eps.end(),
+              "Unknown interface dielectric postprocessing index requested!");
+  return it->second / E_m;
 }
 
-void PostOperator::UpdatePorts(const LumpedPortOperator &lumped_port_op, double omega)
+void PostOperator::UpdatePorts(const LumpedPortOperator *lumped_port_op,
+                               const WavePortOperator *wave_port_op, double omega)
 {
   MFEM_VERIFY(E && B, "Incorrect usage of PostOperator::UpdatePorts!");
-  if (lumped_port_init)
+  MFEM_VERIFY(!wave_port_op || HasImag(), "Incorrect usage of PostOperator::UpdatePorts!");
+  MFEM_VERIFY(!wave_port_op || !reduced_init || wave_port_op->Size() == 0,
+              "Wave port postprocessing is not available for a reduced-order solution!");
+  const bool update_lumped = lumped_port_op && !lumped_port_init;
+  const bool update_wave = wave_port_op && !wave_port_init;
+  if (!update_lumped && !update_wave)
   {
     return;
   }
-  for (const auto &[idx, data] : lumped_port_op)
+
+  // Compute the contributions of the local process to the port powers, voltages, and
+  // S-parameters for all ports, and reduce them across processes together.
+  std::vector<std::complex<double>> dots;
+  if (update_lumped && !reduced_init)
   {
-    auto &vi = lumped_port_vi[idx];
-    vi.P = data.GetPower(*E, *B);
-    vi.V = data.GetVoltage(*E);
-    if (HasImag())
+    for (const auto &[idx, data] : *lumped_port_op)
     {
-      // Compute current from the port impedance, separate contributions for R, L, C
-      // branches.
-      MFEM_VERIFY(
-          omega > 0.0,
-          "Frequency domain lumped port postprocessing requires nonzero frequency!");
-      vi.I[0] =
-          (std::abs(data.R) > 0.0)
-              ? vi.V / data.GetCharacteristicImpedance(omega, LumpedPortData::Branch::R)
-              : 0.0;
-      vi.I[1] =
-          (std::abs(data.L) > 0.0)
-              ? vi.V / data.GetCharacteristicImpedance(omega, LumpedPortData::Branch::L)
-              : 0.0;
-      vi.I[2] =
-          (std::abs(data.C) > 0.0)
-              ? vi.V / data.GetCharacteristicImpedance(omega, LumpedPortData::Branch::C)
-              : 0.0;
-      vi.S = data.GetSParameter(*E);
+      dots.push_back(data.GetLocalPower(*E, *B));
+      dots.push_back(data.GetLocalVoltage(*E));
+      if (HasImag())
+      {
+        dots.push_back(data.GetLocalSParameter(*E));
+      }
     }
-    else
+  }
+  if (update_wave)
+  {
+    for (const auto &[idx, data] : *wave_port_op)
     {
-      // Compute current from P = V I⋆ (no scattering parameter output).
-      vi.I[0] = (std::abs(vi.V) > 0.0) ? std::conj(vi.P / vi.V) : 0.0;
-      vi.I[1] = vi.I[2] = vi.S = 0.0;
+      MFEM_VERIFY(omega > 0.0,
+                  "Frequency domain wave port postprocessing requires nonzero frequency!");
+      dots.push_back(data.GetLocalPower(*E, *B));
+      dots.push_back(data.GetLocalSParameter(*E));
     }
   }
-  lumped_port_init = true;
-}
+  if (!dots.empty())
+  {
+    Mpi::GlobalSum(dots.size(), dots.data(), GetComm());
+  }
+  auto it = dots.begin();
 
-void PostOperator::UpdatePorts(const WavePortOperator &wave_port_op, double omega)
-{
-  MFEM_VERIFY(HasImag() && E && B, "Incorrect usage of PostOperator::UpdatePorts!");
-  if (wave_port_init)
+  if (update_lumped)
   {
-    return;
+    for (const auto &[idx, data] : *lumped_port_op)
+    {
+      auto &vi = lumped_port_vi[idx];
+      if (reduced_init)
+      {
+        // The port power is quadratic in the fields and its projection onto the
+        // reduced-order basis is not computed, so it is not available from the
+        // reduced-order solution.
+        const auto &vs = reduced->lumped_port_vs.at(idx);
+        vi.P = {std::numeric_limits<double>::quiet_NaN(),
+                std::numeric_limits<double>::quiet_NaN()};
+        vi.V = vs.first.cast<std::complex<double>>().dot(reduced->y);
+      }
+      else
+      {
+        vi.P = *it++;
+        vi.V = *it++;
+      }
+      if (HasImag())
+      {
+        // Compute current from the port impedance, separate contributions for R, L, C
+        // branches.
+        MFEM_VERIFY(
+            omega > 0.0,
+            "Frequency domain lumped port postprocessing requires nonzero frequency!");
+        vi.I[0] =
+            (std::abs(data.R) > 0.0)
+                ? vi.V / data.GetCharacteristicImpedance(omega, LumpedPortData::Branch::R)
+                : 0.0;
+        vi.I[1] =
+            (std::abs(data.L) > 0.0)
+                ? vi.V / data.GetCharacteristicImpedance(omega, LumpedPortData::Branch::L)
+                : 0.0;
+        vi.I[2] =
+            (std::abs(data.C) > 0.0)
+                ? vi.V / data.GetCharacteristicImpedance(omega, LumpedPortData::Branch::C)
+                : 0.0;
+        vi.S = reduced_init ? reduced->lumped_port_vs.at(idx)
+                                  .second.cast<std::complex<double>>()
+                                  .dot(reduced->y)
+                            : *it++;
+      }
+      else
+      {
+        // Compute current from P = V I⋆ (no scattering parameter output).
+        vi.I[0] = (std::abs(vi.V) > 0.0) ? std::conj(vi.P / vi.V) : 0.0;
+        vi.I[1] = vi.I[2] = vi.S = 0.0;
+      }
+    }
+    lumped_port_init = true;
   }
-  for (const auto &[idx, data] : wave_port_op)
+  if (update_wave)
   {
-    MFEM_VERIFY(omega > 0.0,
-                "Frequency domain wave port postprocessing requires nonzero frequency!");
-    auto &vi = wave_port_vi[idx];
-    vi.P = data.GetPower(*E, *B);
-    vi.S = data.GetSParameter(*E);
-    vi.V = vi.I[0] = vi.I[1] = vi.I[2] = 0.0;  // Not yet implemented
-                                               // (Z = V² / P, I = V / Z)
+    for (const auto &[idx, data] : *wave_port_op)
+    {
+      auto &vi = wave_port_vi[idx];
+      vi.P = *it++;
+      vi.S = *it++;
+      vi.V = vi.I[0] = vi.I[1] = vi.I[2] = 0.0;  // Not yet implemented
+                                                 // (Z = V² / P, I = V / Z)
+    }
+    wave_port_init = true;
   }
-  wave_port_init = true;
 }
 
 double PostOperator::GetLumpedInductorEnergy(const LumpedPortOperator &lumped_port_op) const
@@ -582,6 +911,11 @@ std::complex<double> PostOperator::GetPortPower(const LumpedPortOperator &lumped
   const auto it = lumped_port_vi.find(idx);
   MFEM_VERIFY(it != lumped_port_vi.end(),
               "Could not find lumped port when calculating lumped port power!");
+  if (reduced_init)
+  {
+    Mpi::Warning(GetComm(), "Lumped port power is not available for a reduced-order "
+                            "solution, returning NaN!\n");
+  }
   return it->second.P;
 }
 
@@ -675,69 +1009,16 @@ double PostOperator::GetExternalKappa(const LumpedPortOperator &lumped_port_op,
                        I_mj.real());  // mean(I²) = (I_r² + I_i²) / 2
 }
 
-namespace
-{
-
-template <typename T>
-void ScaleGridFunctions(double L, int dim, bool imag, T &E, T &B, T &V, T &A)
-{
-  // For fields on H(curl) and H(div) spaces, we "undo" the effect of redimensionalizing
-  // the mesh which would carry into the fields during the mapping from reference to
-  // physical space through the element Jacobians. No transformation for V is needed (H1
-  // interpolation). Because the coefficients are always evaluating E, B in neighboring
-  // elements, the Jacobian scaling is the same for the domain and boundary data
-  // collections (instead of being different for B due to the dim - 1 evaluation). Wave
-  // port fields also do not require rescaling since their submesh object where they are
-  // evaluated remains nondimensionalized.
-  if (E)
-  {
-    // Piola transform: J^-T
-    E->Real() *= L;
-    E->Real().FaceNbrData() *= L;
-    if (imag)
-    {
-      E->Imag() *= L;
-      E->Imag().FaceNbrData() *= L;
-    }
-  }
-  if (B)
-  {
-    // Piola transform: J / |J|
-    const auto Ld = std::pow(L, dim - 1);
-    B->Real() *= Ld;
-    B->Real().FaceNbrData() *= Ld;
-    if (imag)
-    {
-      B->Imag() *= Ld;
-      B->Imag().FaceNbrData() *= Ld;
-    }
-  }
-  if (A)
-  {
-    // Piola transform: J^-T
-    A->Real() *= L;
-    A->Real().FaceNbrData() *= L;
-  }
-}
-
-}  // namespace
-
 void PostOperator::WriteFields(int step, double time) const
 {
   // Given the electric field and magnetic flux density, write the fields to disk for
-  // visualization. Write the mesh coordinates in the same units as originally input.
-  mfem::ParMesh &mesh =
-      HasE() ? *E->ParFESpace()->GetParMesh() : *B->ParFESpace()->GetParMesh();
-  mesh::DimensionalizeMesh(mesh, mesh_Lc0);
-  ScaleGridFunctions(mesh_Lc0, mesh.Dimension(), HasImag(), E, B, V, A);
-  paraview.SetCycle(step);
-  paraview.SetTime(time);
-  paraview_bdr.SetCycle(step);
-  paraview_bdr.SetTime(time);
-  paraview.Save();
-  paraview_bdr.Save();
-  mesh::NondimensionalizeMesh(mesh, mesh_Lc0);
-  ScaleGridFunctions(1.0 / mesh_Lc0, mesh.Dimension(), HasImag(), E, B, V, A);
+  // visualization. The field values are copied and the output is written asynchronously
+  // if enabled.
+  if (!paraview)
+  {
+    return;
+  }
+  paraview->Write(step, time);
 }
 
 void PostOperator::WriteFieldsFinal(const ErrorIndicator *indicator) const
@@ -746,84 +1027,80 @@ void PostOperator::WriteFieldsFinal(const ErrorIndicator *indicator) const
   // need for these to be parallel objects, since the data is local to each process and
   // there isn't a need to ever access the element neighbors. We set the time to some
   // non-used value to make the step identifiable within the data collection.
-  mfem::ParMesh &mesh =
-      HasE() ? *E->ParFESpace()->GetParMesh() : *B->ParFESpace()->GetParMesh();
-  mesh::DimensionalizeMesh(mesh, mesh_Lc0);
-  paraview.SetCycle(paraview.GetCycle() + 1);
-  if (paraview.GetTime() < 1.0)
-  {
-    paraview.SetTime(99.0);
-  }
-  else
+  if (!paraview)
   {
-    // 1 -> 99, 10 -> 999, etc.
-    paraview.SetTime(
-        std::pow(10.0, 2.0 + static_cast<int>(std::log10(paraview.GetTime()))) - 1.0);
-  }
-  mfem::DataCollection::FieldMapType field_map(paraview.GetFieldMap());  // Copy
-  for (const auto &[name, gf] : field_map)
-  {
-    paraview.DeregisterField(name);
+    return;
   }
-  //mfem::DataCollection::CoeffFieldMapType coeff_field_map(paraview.GetCoeffFieldMap());
-  //for (const auto &[name, gf] : coeff_field_map)
+  double time = paraview->GetLastTime();
+  if (time < 1.0)
   {
-    //paraview.DeregisterField(name);
+    time = 99.0;
   }
-  //mfem::DataCollection::VCoeffFieldMapType vcoeff_field_map(paraview.GetVCoeffFieldMap());
-  //for (const auto &[name, gf] : vcoeff_field_map)
+  else
   {
-    //paraview.DeregisterVCoeffField(name);
+    // 1 -> 99, 10 -> 999, etc.
+    time = std::pow(10.0, 2.0 + static_cast<int>(std::log10(time))) - 1.0;
   }
-  mfem::L2_FECollection pwconst_fec(0, mesh.Dimension());
-  mfem::FiniteElementSpace pwconst_fespace(&mesh, &pwconst_fec);
-  std::unique_ptr<mfem::GridFunction> rank, eta;
+  const mfem::ParMesh &mesh =
+      HasE() ? *E->ParFESpace()->GetParMesh() : *B->ParFESpace()->GetParMesh();
+  std::map<std::string, mfem::Vector> data;
   {
-    rank = std::make_unique<mfem::GridFunction>(&pwconst_fespace);
-    *rank = mesh.GetMyRank() + 1;
-    paraview.RegisterField("Rank", rank.get());
+    auto &rank = data["Rank"];
+    rank.SetSize(mesh.GetNE());
+    rank = mesh.GetMyRank() + 1;
   }
   if (indicator)
   {
-    eta = std::make_unique<mfem::GridFunction>(&pwconst_fespace);
-    MFEM_VERIFY(eta->Size() == indicator->Local().Size(),
+    MFEM_VERIFY(indicator->Local().Size() == mesh.GetNE(),
                 "Size mismatch for provided ErrorIndicator for postprocessing!");
-    *eta = indicator->Local();
-    paraview.RegisterField("Indicator", eta.get());
-  }
-  paraview.Save();
-  if (rank)
-  {
-    paraview.DeregisterField("Rank");
-  }
-  if (eta)
-  {
-    paraview.DeregisterField("Indicator");
+    data["Indicator"] = indicator->Local();
   }
-  //for (const auto &[name, gf] : field_map)
+  paraview->WriteElementFields(time, data);
+}
+
+void PostOperator::ProbeFields(std::vector<std::complex<double>> &vE,
+                               std::vector<std::complex<double>> &vB) const
+{
+  if (reduced_init)
   {
-    //paraview.RegisterField(name, gf);
+    vE = E ? ProbeEField() : std::vector<std::complex<double>>();
+    vB = B ? ProbeBField() : std::vector<std::complex<double>>();
+    return;
   }
-  //for (const auto &[name, gf] : coeff_field_map)
+  std::vector<const GridFunction *> U;
+  if (E)
   {
-    //paraview.RegisterField(name, gf);
+    U.push_back(E.get());
   }
-  //for (const auto &[name, gf] : vcoeff_field_map)
+  if (B)
   {
-    //paraview.RegisterField(name, gf);
+    U.push_back(B.get());
   }
-  mesh::NondimensionalizeMesh(mesh, mesh_Lc0);
+  auto vals = interp_op.ProbeFields(U);
+  vE = E ? std::move(vals.front()) : std::vector<std::complex<double>>();
+  vB = B ? std::move(vals.back()) : std::vector<std::complex<double>>();
 }
 
 std::vector<std::complex<double>> PostOperator::ProbeEField() const
 {
   MFEM_VERIFY(E, "PostOperator is not configured for electric field probes!");
+  if (reduced_init)
+  {
+    const Eigen::VectorXcd v = reduced->probe_E.cast<std::complex<double>>() * reduced->y;
+    return std::vector<std::complex<double>>(v.data(), v.data() + v.size());
+  }
   return interp_op.ProbeField(*E);
 }
 
 std::vector<std::complex<double>> PostOperator::ProbeBField() const
 {
   MFEM_VERIFY(B, "PostOperator is not configured for magnetic flux density probes!");
+  if (reduced_init)
+  {
+    const Eigen::VectorXcd v = (1i / reduced->omega) *
+                               (reduced->probe_B.cast<std::complex<double>>() * reduced->y);
+    return std::vector<std::complex<double>>(v.data(), v.data() + v.size());
+  }
   return interp_op.ProbeField(*B);
 }
 
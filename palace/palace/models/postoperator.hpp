@@ -9,6 +9,7 @@
 #include <memory>
 #include <string>
 #include <vector>
+#include <Eigen/Dense>
 #include <mfem.hpp>
 #include "fem/gridfunction.hpp"
 #include "fem/interpolator.hpp"
@@ -17,6 +18,7 @@
 #include "models/domainpostoperator.hpp"
 #include "models/lumpedportoperator.hpp"
 #include "models/surfacepostoperator.hpp"
+#include "utils/fieldwriter.hpp"
 
 namespace palace
 {
@@ -64,11 +66,46 @@ private:
   std::map<int, PortPostData> lumped_port_vi, wave_port_vi;
   bool lumped_port_init, wave_port_init;
 
-  // Data collection for writing fields to disk for visualization and sampling points.
-  mutable mfem::ParaViewDataCollection paraview, paraview_bdr;
+  // Total and domain field energies and surface integrals postprocessed from the grid
+  // functions. The contributions of the local process to all of the quantities in a group
+  // are computed and then reduced across processes with a single communication when any of
+  // them is first requested after the grid functions are set.
+  struct MeasurementData
+  {
+    double E_elec, E_mag;
+    std::map<int, std::pair<double, double>> E_i;
+    std::map<int, std::complex<double>> flux;
+    std::map<int, double> E_eps;
+  };
+  mutable MeasurementData measurements;
+  mutable bool energy_init, measurement_init;
+  void InitializeEnergies() const;
+  void InitializeMeasurements() const;
+  void UpdatePorts(const LumpedPortOperator *lumped_port_op,
+                   const WavePortOperator *wave_port_op, double omega);
+
+  // Projections of the postprocessed quantities onto a real-valued reduced-order basis V,
+  // for evaluation from the reduced-order model solution E = V y, B = -1/(iω) ∇ x V y
+  // without expanding the fields. Quadratic quantities are stored as the projected
+  // matrices Vᵀ M V and linear ones as their values for each basis vector.
+  struct ReducedPostData
+  {
+    Eigen::MatrixXd M_elec, M_mag;
+    std::map<int, std::pair<Eigen::MatrixXd, Eigen::MatrixXd>> M_i;
+    std::map<int, std::pair<Eigen::VectorXd, Eigen::VectorXd>> lumped_port_vs;
+    std::map<int, Eigen::VectorXd> flux;
+    Eigen::MatrixXd probe_E, probe_B;
+    Eigen::VectorXcd y;
+    double omega;
+  };
+  std::unique_ptr<ReducedPostData> reduced;
+  bool reduced_init;
+  double GetReducedEnergy(const Eigen::MatrixXd &Mr, double coeff) const;
+
+  // Writer for fields to disk for visualization and sampling points.
+  std::unique_ptr<FieldWriter> paraview;
   mutable InterpolationOperator interp_op;
-  double mesh_Lc0;
-  void InitializeDataCollection(const IoData &iodata);
+  void InitializeDataCollection(const IoData &iodata, const std::string &name);
 
 public:
   PostOperator(const IoData &iodata, SpaceOperator &space_op, const std::string &name);
@@ -96,6 +133,21 @@ public:
   void SetVGridFunction(const Vector &v, bool exchange_face_nbr_data = true);
   void SetAGridFunction(const Vector &a, bool exchange_face_nbr_data = true);
 
+  // Precompute the projections of the postprocessing quantities onto the first n columns of
+  // the real-valued reduced-order basis V. This overwrites the internal E- and B-field grid
+  // functions. The return value indicates whether or not all configured postprocessing
+  // quantities can be evaluated from the reduced-order solution (wave ports, power flux
+  // surfaces, and interface dielectric participation require the expanded fields).
+  bool SetReducedBasis(const std::vector<Vector> &V, std::size_t n, const Operator &Curl,
+                       const LumpedPortOperator &lumped_port_op,
+                       const WavePortOperator &wave_port_op);
+
+  // Set the reduced-order solution coefficients y at frequency ω, used for all subsequent
+  // postprocessing in place of the internal grid functions until either of the E- or
+  // B-field grid functions is set.
+  void SetReducedSolution(const Eigen::VectorXcd &y, double omega);
+  bool HasReducedSolution() const { return reduced_init; }
+
   // Access grid functions for field solutions.
   auto &GetEGridFunction()
   {
@@ -136,15 +188,22 @@ public:
   // electric field mode.
   double GetInterfaceParticipation(int idx, double E_m) const;
 
-  // Update cached port voltages and currents for lumped and wave port operators.
+  // Update cached port voltages and currents for lumped and wave port operators. The port
+  // quantities for both operators are reduced across processes with a single
+  // communication.
   void UpdatePorts(const LumpedPortOperator &lumped_port_op,
                    const WavePortOperator &wave_port_op, double omega = 0.0)
   {
-    UpdatePorts(lumped_port_op, omega);
-    UpdatePorts(wave_port_op, omega);
+    UpdatePorts(&lumped_port_op, &wave_port_op, omega);
+  }
+  void UpdatePorts(const LumpedPortOperator &lumped_port_op, double omega = 0.0)
+  {
+    UpdatePorts(&lumped_port_op, nullptr, omega);
+  }
+  void UpdatePorts(const WavePortOperator &wave_port_op, double omega = 0.0)
+  {
+    UpdatePorts(nullptr, &wave_port_op, omega);
   }
-  void UpdatePorts(const LumpedPortOperator &lumped_port_op, double omega = 0.0);
-  void UpdatePorts(const WavePortOperator &wave_port_op, double omega = 0.0);
 
   // Postprocess the energy in lumped capacitor or inductor port boundaries with index in
   // the provided set.
@@ -182,7 +241,8 @@ public:
 
   // Write to disk the E- and B-fields extracted from the solution vectors. Note that fields
   // are not redimensionalized, to do so one needs to compute: B <= B * (μ₀ H₀), E <= E *
-  // (Z₀ H₀), V <= V * (Z₀ H₀ L₀), etc.
+  // (Z₀ H₀), V <= V * (Z₀ H₀ L₀), etc. If asynchronous output is enabled, the fields are
+  // written in the background and the grid functions can be modified after returning.
   void WriteFields(int step, double time) const;
   void WriteFieldsFinal(const ErrorIndicator *indicator = nullptr) const;
 
@@ -195,6 +255,11 @@ public:
   std::vector<std::complex<double>> ProbeEField() const;
   std::vector<std::complex<double>> ProbeBField() const;
 
+  // Probe both of the E- and B-fields (if available, otherwise the corresponding output is
+  // empty) with a single global reduction.
+  void ProbeFields(std::vector<std::complex<double>> &vE,
+                   std::vector<std::complex<double>> &vB) const;
+
   // Get the associated MPI communicator.
   MPI_Comm GetComm() const
   {
@@ -3,11 +3,17 @@
 
 #include "romoperator.hpp"
 
+#include <algorithm>
+#include <fstream>
 #include <Eigen/SVD>
 #include <mfem.hpp>
+#include "fem/errorindicator.hpp"
 #include "linalg/orthog.hpp"
+#include "models/postoperator.hpp"
 #include "models/spaceoperator.hpp"
+#include "utils/checkpoint.hpp"
 #include "utils/communication.hpp"
+#include "utils/filesystem.hpp"
 #include "utils/iodata.hpp"
 #include "utils/timer.hpp"
 
@@ -46,11 +52,81 @@ inline void OrthogonalizeColumn(GmresSolverBase::OrthogType type, MPI_Comm comm,
       linalg::OrthogonalizeColumnCGS(comm, V, w, Rj, j);
       break;
     case GmresSolverBase::OrthogType::CGS2:
+    case GmresSolverBase::OrthogType::DCGS2:
       linalg::OrthogonalizeColumnCGS(comm, V, w, Rj, j, true);
       break;
   }
 }
 
+inline std::size_t OrthonormalizeBlockCGS2(MPI_Comm comm, std::vector<Vector> &V,
+                                           std::size_t n0, std::size_t n)
+{
+  // Orthonormalize the columns V[n0:n] against the orthonormal columns V[0:n0] and each
+  // other using block classical Gram-Schmidt with reorthogonalization (CGS2). The
+  // projections onto V[0:n0] of all of the new columns are computed with a single global
+  // reduction for each of the two passes. Columns which are numerically linearly dependent
+  // are removed, and the new number of columns is returned.
+  const std::size_t m = n - n0;
+  std::vector<double> norms(m);
+  for (std::size_t k = 0; k < m; k++)
+  {
+    norms[k] = V[n0 + k] * V[n0 + k];  // Local inner product
+  }
+  Mpi::GlobalSum(m, norms.data(), comm);
+  if (n0 > 0 && m > 0)
+  {
+    Eigen::MatrixXd H(n0, m);
+    for (int pass = 0; pass < 2; pass++)
+    {
+      for (std::size_t k = 0; k < m; k++)
+      {
+        for (std::size_t i = 0; i < n0; i++)
+        {
+          H(i, k) = V[n0 + k] * V[i];  // Local inner product
+        }
+      }
+      Mpi::GlobalSum(H.size(), H.data(), comm);
+      for (std::size_t k = 0; k < m; k++)
+      {
+        for (std::size_t i = 0; i < n0; i++)
+        {
+          V[n0 + k].Add(-H(i, k), V[i]);
+        }
+      }
+    }
+  }
+
+  // Orthonormalize within the block.
+  std::size_t j = n0;
+  std::vector<double> h(m);
+  for (std::size_t k = 0; k < m; k++)
+  {
+    if (j < n0 + k)
+    {
+      V[j].Swap(V[n0 + k]);
+    }
+    for (int pass = 0; pass < 2 && j > n0; pass++)
+    {
+      for (std::size_t i = n0; i < j; i++)
+      {
+        h[i - n0] = V[j] * V[i];  // Local inner product
+      }
+      Mpi::GlobalSum(j - n0, h.data(), comm);
+      for (std::size_t i = n0; i < j; i++)
+      {
+        V[j].Add(-h[i - n0], V[i]);
+      }
+    }
+    const double norm = linalg::Norml2(comm, V[j]);
+    if (norm > ORTHOG_TOL * std::sqrt(norms[k]))
+    {
+      V[j] *= 1.0 / norm;
+      j++;
+    }
+  }
+  return j;
+}
+
 inline void ProjectMatInternal(MPI_Comm comm, const std::vector<Vector> &V,
                                const ComplexOperator &A, Eigen::MatrixXcd &Ar,
                                ComplexVector &r, int n0)
@@ -184,6 +260,14 @@ inline void ProlongatePROMSolution(std::size_t n, const std::vector<Vector> &V,
   }
 }
 
+constexpr std::uint64_t CHECKPOINT_MAGIC = 0x314d4f52504c4150;  // "PALPROM1"
+constexpr std::int64_t CHECKPOINT_VERSION = 1;
+constexpr auto CHECKPOINT_TOL = 1.0e-12;
+
+using checkpoint::GetMeshHash;
+using checkpoint::ReadBinary;
+using checkpoint::WriteBinary;
+
 }  // namespace
 
 RomOperator::RomOperator(const IoData &iodata, SpaceOperator &space_op, int max_size)
@@ -234,6 +318,7 @@ RomOperator::RomOperator(const IoData &iodata, SpaceOperator &space_op, int max_
       orthog_type = GmresSolverBase::OrthogType::CGS;
       break;
     case config::LinearSolverData::OrthogType::CGS2:
+    case config::LinearSolverData::OrthogType::DCGS2:
       orthog_type = GmresSolverBase::OrthogType::CGS2;
       break;
   }
@@ -242,7 +327,8 @@ RomOperator::RomOperator(const IoData &iodata, SpaceOperator &space_op, int max_
 void RomOperator::SolveHDM(double omega, ComplexVector &u)
 {
   // Compute HDM solution at the given frequency. The system matrix, A = K + iω C - ω² M +
-  // A2(ω) is built by summing the underlying operator contributions.
+  // A2(ω) is built by summing the underlying operator contributions, and the preconditioner
+  // is constructed at the same frequency.
   A2 = space_op.GetExtraSystemMatrix<ComplexOperator>(omega, Operator::DIAG_ZERO);
   has_A2 = (A2 != nullptr);
   auto A = space_op.GetSystemMatrix(std::complex<double>(1.0, 0.0), 1i * omega,
@@ -272,73 +358,85 @@ void RomOperator::SolveHDM(double omega, ComplexVector &u)
 }
 
 void RomOperator::UpdatePROM(double omega, const ComplexVector &u)
+{
+  UpdatePROM(std::vector<double>{omega}, std::vector<const ComplexVector *>{&u});
+}
+
+void RomOperator::UpdatePROM(const std::vector<double> &omega,
+                             const std::vector<const ComplexVector *> &u)
 {
   // Update V. The basis is always real (each complex solution adds two basis vectors if it
-  // has a nonzero real and imaginary parts).
+  // has a nonzero real and imaginary parts). All of the new vectors are orthogonalized into
+  // the basis together.
   BlockTimer bt(Timer::CONSTRUCT_PROM);
   MPI_Comm comm = space_op.GetComm();
-  const double normr = linalg::Norml2(comm, u.Real());
-  const double normi = linalg::Norml2(comm, u.Imag());
-  const bool has_real = (normr > ORTHOG_TOL * std::sqrt(normr * normr + normi * normi));
-  const bool has_imag = (normi > ORTHOG_TOL * std::sqrt(normr * normr + normi * normi));
-  MFEM_VERIFY(dim_V + has_real + has_imag <= V.size(),
-              "Unable to increase basis storage size, increase maximum number of vectors!");
+  MFEM_VERIFY(omega.size() == u.size(), "Invalid batch of HDM solutions for PROM update!");
   const std::size_t dim_V0 = dim_V;
-  std::vector<double> H(dim_V + has_real + has_imag);
-  if (has_real)
+  for (const auto *uk : u)
   {
-    V[dim_V] = u.Real();
-    OrthogonalizeColumn(orthog_type, comm, V, V[dim_V], H.data(), dim_V);
-    H[dim_V] = linalg::Norml2(comm, V[dim_V]);
-    V[dim_V] *= 1.0 / H[dim_V];
-    dim_V++;
-  }
-  if (has_imag)
-  {
-    V[dim_V] = u.Imag();
-    OrthogonalizeColumn(orthog_type, comm, V, V[dim_V], H.data(), dim_V);
-    H[dim_V] = linalg::Norml2(comm, V[dim_V]);
-    V[dim_V] *= 1.0 / H[dim_V];
-    dim_V++;
+    const double normr = linalg::Norml2(comm, uk->Real());
+    const double normi = linalg::Norml2(comm, uk->Imag());
+    const bool has_real = (normr > ORTHOG_TOL * std::sqrt(normr * normr + normi * normi));
+    const bool has_imag = (normi > ORTHOG_TOL * std::sqrt(normr * normr + normi * normi));
+    MFEM_VERIFY(dim_V + has_real + has_imag <= V.size(),
+                "Unable to increase basis storage size, increase maximum number of "
+                "vectors!");
+    if (has_real)
+    {
+      V[dim_V++] = uk->Real();
+    }
+    if (has_imag)
+    {
+      V[dim_V++] = uk->Imag();
+    }
   }
+  dim_V = OrthonormalizeBlockCGS2(comm, V, dim_V0, dim_V);
 
   // Update reduced-order operators. Resize preserves the upper dim0 x dim0 block of each
   // matrix and first dim0 entries of each vector and the projection uses the values
   // computed for the unchanged basis vectors.
-  Kr.conservativeResize(dim_V, dim_V);
-  ProjectMatInternal(comm, V, *K, Kr, r, dim_V0);
-  if (C)
-  {
-    Cr.conservativeResize(dim_V, dim_V);
-    ProjectMatInternal(comm, V, *C, Cr, r, dim_V0);
-  }
-  Mr.conservativeResize(dim_V, dim_V);
-  ProjectMatInternal(comm, V, *M, Mr, r, dim_V0);
-  Ar.resize(dim_V, dim_V);
-  if (RHS1.Size())
+  if (dim_V > dim_V0)
   {
-    RHS1r.conservativeResize(dim_V);
-    ProjectVecInternal(comm, V, RHS1, RHS1r, dim_V0);
+    Kr.conservativeResize(dim_V, dim_V);
+    ProjectMatInternal(comm, V, *K, Kr, r, dim_V0);
+    if (C)
+    {
+      Cr.conservativeResize(dim_V, dim_V);
+      ProjectMatInternal(comm, V, *C, Cr, r, dim_V0);
+    }
+    Mr.conservativeResize(dim_V, dim_V);
+    ProjectMatInternal(comm, V, *M, Mr, r, dim_V0);
+    Ar.resize(dim_V, dim_V);
+    if (RHS1.Size())
+    {
+      RHS1r.conservativeResize(dim_V);
+      ProjectVecInternal(comm, V, RHS1, RHS1r, dim_V0);
+    }
+    RHSr.resize(dim_V);
   }
-  RHSr.resize(dim_V);
 
   // Compute the coefficients for the minimal rational interpolation of the state u used
   // as an error indicator. The complex-valued snapshot matrix U = [{u_i, (iω) u_i}] is
   // stored by its QR decomposition.
-  MFEM_VERIFY(dim_Q + 1 <= Q.size(),
-              "Unable to increase basis storage size, increase maximum number of vectors!");
-  R.conservativeResizeLike(Eigen::MatrixXd::Zero(dim_Q + 1, dim_Q + 1));
-  {
-    std::vector<const ComplexVector *> blocks = {&u, &u};
-    std::vector<std::complex<double>> s = {1.0, 1i * omega};
-    Q[dim_Q].SetSize(2 * u.Size());
-    Q[dim_Q].UseDevice(true);
-    Q[dim_Q].SetBlocks(blocks, s);
-  }
-  OrthogonalizeColumn(orthog_type, comm, Q, Q[dim_Q], R.col(dim_Q).data(), dim_Q);
-  R(dim_Q, dim_Q) = linalg::Norml2(comm, Q[dim_Q]);
-  Q[dim_Q] *= 1.0 / R(dim_Q, dim_Q);
-  dim_Q++;
+  for (std::size_t k = 0; k < u.size(); k++)
+  {
+    MFEM_VERIFY(dim_Q + 1 <= Q.size(),
+                "Unable to increase basis storage size, increase maximum number of "
+                "vectors!");
+    R.conservativeResizeLike(Eigen::MatrixXd::Zero(dim_Q + 1, dim_Q + 1));
+    {
+      std::vector<const ComplexVector *> blocks = {u[k], u[k]};
+      std::vector<std::complex<double>> s = {1.0, 1i * omega[k]};
+      Q[dim_Q].SetSize(2 * u[k]->Size());
+      Q[dim_Q].UseDevice(true);
+      Q[dim_Q].SetBlocks(blocks, s);
+    }
+    OrthogonalizeColumn(orthog_type, comm, Q, Q[dim_Q], R.col(dim_Q).data(), dim_Q);
+    R(dim_Q, dim_Q) = linalg::Norml2(comm, Q[dim_Q]);
+    Q[dim_Q] *= 1.0 / R(dim_Q, dim_Q);
+    dim_Q++;
+    z.push_back(omega[k]);
+  }
   ComputeMRI(R, q);
   // if (Mpi::Root(comm))
   // {
@@ -346,10 +444,19 @@ void RomOperator::UpdatePROM(double omega, const ComplexVector &u)
   //   std::cout << "R =\n" << R << "\n";
   //   std::cout << "q =\n" << q << "\n";
   // }
-  z.push_back(omega);
 }
 
 void RomOperator::SolvePROM(double omega, ComplexVector &u)
+{
+  // Compute PROM solution at the given frequency and expand into high-dimensional space.
+  // The PROM is solved on every process so the matrix-vector product for vector expansion
+  // does not require communication.
+  SolvePROM(omega, RHSr);
+  BlockTimer bt(Timer::SOLVE_PROM);
+  ProlongatePROMSolution(dim_V, V, RHSr, u);
+}
+
+void RomOperator::SolvePROM(double omega, Eigen::VectorXcd &y)
 {
   // Assemble the PROM linear system at the given frequency. The PROM system is defined by
   // the matrix Aᵣ(ω) = Kᵣ + iω Cᵣ - ω² Mᵣ + Vᴴ A2 V(ω) and source vector RHSᵣ(ω) =
@@ -385,22 +492,212 @@ void RomOperator::SolvePROM(double omega, ComplexVector &u)
     RHSr += (1i * omega) * RHS1r;
   }
 
-  // Compute PROM solution at the given frequency and expand into high-dimensional space.
-  // The PROM is solved on every process so the matrix-vector product for vector expansion
-  // does not require communication.
+  // Compute PROM solution at the given frequency.
   BlockTimer bt(Timer::SOLVE_PROM);
   if constexpr (false)
   {
     // LDLT solve
-    RHSr = Ar.ldlt().solve(RHSr);
-    RHSr = Ar.selfadjointView<Eigen::Lower>().ldlt().solve(RHSr);
+    y = Ar.ldlt().solve(RHSr);
+    y = Ar.selfadjointView<Eigen::Lower>().ldlt().solve(RHSr);
   }
   else
   {
     // LU solve
-    RHSr = Ar.partialPivLu().solve(RHSr);
+    y = Ar.partialPivLu().solve(RHSr);
   }
-  ProlongatePROMSolution(dim_V, V, RHSr, u);
+}
+
+bool RomOperator::InitializePostOperator(PostOperator &post_op) const
+{
+  BlockTimer bt(Timer::CONSTRUCT_PROM);
+  return post_op.SetReducedBasis(V, dim_V, space_op.GetCurlMatrix(),
+                                 space_op.GetLumpedPortOp(), space_op.GetWavePortOp());
+}
+
+RomOperator::CheckpointHeader RomOperator::GetCheckpointHeader()
+{
+  MPI_Comm comm = space_op.GetComm();
+  const auto &mesh = space_op.GetNDSpace().GetParMesh();
+  CheckpointHeader header = {};
+  header.magic = CHECKPOINT_MAGIC;
+  header.mesh_hash = GetMeshHash(mesh);
+  header.version = CHECKPOINT_VERSION;
+  header.size = Mpi::Size(comm);
+  header.rank = Mpi::Rank(comm);
+  header.local_size = K->Width();
+  header.global_size = space_op.GlobalTrueVSize();
+  header.num_elem = mesh.GetNE();
+  header.has_C = (C != nullptr);
+  header.has_RHS1 = has_RHS1;
+
+  // The test vector is deterministic given the partitioning, which is already part of the
+  // checkpoint key.
+  ComplexVector x(K->Width());
+  x.UseDevice(true);
+  {
+    auto *xr = x.Real().HostWrite();
+    for (int i = 0; i < x.Size(); i++)
+    {
+      xr[i] = std::sin(1.0 + i);
+    }
+    x.Imag() = 0.0;
+  }
+  const ComplexOperator *ops[3] = {K.get(), C.get(), M.get()};
+  for (int i = 0; i < 3; i++)
+  {
+    if (ops[i])
+    {
+      ops[i]->Mult(x, r);
+      header.fingerprint[i] = linalg::Dot(comm, r, x);
+    }
+  }
+  if (has_RHS1)
+  {
+    header.fingerprint[3] = linalg::Dot(comm, RHS1, x);
+  }
+  return header;
+}
+
+void RomOperator::SaveCheckpoint(const std::string &path, const ErrorIndicator &indicator)
+{
+  // Each process writes its local part of the basis vectors and MRI snapshots, as well as
+  // a copy of the PROM matrices (replicated on every process), to its own file.
+  BlockTimer bt(Timer::IO);
+  MPI_Comm comm = space_op.GetComm();
+  if (Mpi::Root(comm) && !std::filesystem::exists(path))
+  {
+    std::filesystem::create_directories(path);
+  }
+  Mpi::Barrier(comm);
+  auto header = GetCheckpointHeader();
+  header.dim_V = dim_V;
+  header.dim_Q = dim_Q;
+  header.indicator_samples =
+      (indicator.Local().Size() == header.num_elem) ? indicator.Samples() : 0;
+  const std::string filename =
+      mfem::MakeParFilename(path + "/prom.", Mpi::Rank(comm), ".bin");
+  std::ofstream fo(filename, std::ios::binary);
+  WriteBinary(fo, &header, 1);
+  for (std::size_t j = 0; j < dim_V; j++)
+  {
+    WriteBinary(fo, V[j].HostRead(), V[j].Size());
+  }
+  for (std::size_t j = 0; j < dim_Q; j++)
+  {
+    WriteBinary(fo, Q[j].Real().HostRead(), Q[j].Size());
+    WriteBinary(fo, Q[j].Imag().HostRead(), Q[j].Size());
+  }
+  WriteBinary(fo, Kr.data(), Kr.size());
+  WriteBinary(fo, Mr.data(), Mr.size());
+  if (C)
+  {
+    WriteBinary(fo, Cr.data(), Cr.size());
+  }
+  if (has_RHS1)
+  {
+    WriteBinary(fo, RHS1r.data(), RHS1r.size());
+  }
+  WriteBinary(fo, R.data(), R.size());
+  WriteBinary(fo, q.data(), q.size());
+  WriteBinary(fo, z.data(), z.size());
+  if (header.indicator_samples > 0)
+  {
+    WriteBinary(fo, indicator.Local().HostRead(), indicator.Local().Size());
+  }
+  bool good = fo.good();
+  Mpi::GlobalAnd(1, &good, comm);
+  MFEM_VERIFY(good, "Failed to write PROM checkpoint to " << path << "!");
+}
+
+bool RomOperator::LoadCheckpoint(const std::string &path, ErrorIndicator &indicator)
+{
+  // Read the header and check that the checkpoint was written for the same problem on
+  // every process before reading the data.
+  BlockTimer bt(Timer::IO);
+  MPI_Comm comm = space_op.GetComm();
+  const auto key = GetCheckpointHeader();
+  const std::string filename =
+      mfem::MakeParFilename(path + "/prom.", Mpi::Rank(comm), ".bin");
+  std::ifstream fi(filename, std::ios::binary);
+  CheckpointHeader header = {};
+  bool valid = fi.good();
+  if (valid)
+  {
+    ReadBinary(fi, &header, 1);
+    valid = fi.good() && header.magic == key.magic && header.version == key.version &&
+            header.mesh_hash == key.mesh_hash && header.size == key.size &&
+            header.rank == key.rank && header.local_size == key.local_size &&
+            header.global_size == key.global_size && header.num_elem == key.num_elem &&
+            header.has_C == key.has_C && header.has_RHS1 == key.has_RHS1 &&
+            header.dim_V > 0 && header.dim_Q >= 2;
+    for (int i = 0; i < 4; i++)
+    {
+      valid = valid && (std::abs(header.fingerprint[i] - key.fingerprint[i]) <=
+                        CHECKPOINT_TOL * std::abs(key.fingerprint[i]));
+    }
+  }
+  Mpi::GlobalAnd(1, &valid, comm);
+  if (!valid)
+  {
+    return false;
+  }
+
+  // Increase the basis storage if required to hold the loaded PROM.
+  dim_V = header.dim_V;
+  dim_Q = header.dim_Q;
+  if (V.size() < dim_V)
+  {
+    V.resize(dim_V, Vector());
+  }
+  if (Q.size() < dim_Q)
+  {
+    Q.resize(dim_Q, ComplexVector());
+  }
+  for (std::size_t j = 0; j < dim_V; j++)
+  {
+    V[j].SetSize(header.local_size);
+    V[j].UseDevice(true);
+    ReadBinary(fi, V[j].HostWrite(), V[j].Size());
+  }
+  for (std::size_t j = 0; j < dim_Q; j++)
+  {
+    Q[j].SetSize(2 * header.local_size);
+    Q[j].UseDevice(true);
+    ReadBinary(fi, Q[j].Real().HostWrite(), Q[j].Size());
+    ReadBinary(fi, Q[j].Imag().HostWrite(), Q[j].Size());
+  }
+  Kr.resize(dim_V, dim_V);
+  ReadBinary(fi, Kr.data(), Kr.size());
+  Mr.resize(dim_V, dim_V);
+  ReadBinary(fi, Mr.data(), Mr.size());
+  if (C)
+  {
+    Cr.resize(dim_V, dim_V);
+    ReadBinary(fi, Cr.data(), Cr.size());
+  }
+  if (has_RHS1)
+  {
+    RHS1r.resize(dim_V);
+    ReadBinary(fi, RHS1r.data(), RHS1r.size());
+  }
+  Ar.resize(dim_V, dim_V);
+  RHSr.resize(dim_V);
+  R.resize(dim_Q, dim_Q);
+  ReadBinary(fi, R.data(), R.size());
+  q.resize(dim_Q);
+  ReadBinary(fi, q.data(), q.size());
+  z.resize(dim_Q);
+  ReadBinary(fi, z.data(), z.size());
+  if (header.indicator_samples > 0)
+  {
+    Vector local(header.num_elem);
+    ReadBinary(fi, local.HostWrite(), local.Size());
+    indicator = ErrorIndicator(std::move(local), header.indicator_samples);
+  }
+  valid = fi.good();
+  Mpi::GlobalAnd(1, &valid, comm);
+  MFEM_VERIFY(valid, "Failed to read PROM checkpoint from " << path << "!");
+  return true;
 }
 
 std::vector<double> RomOperator::FindMaxError(int N) const
@@ -409,6 +706,10 @@ std::vector<double> RomOperator::FindMaxError(int N) const
   // sum_i q_z / (z - z_i) (denominator of the barycentric interpolation of u). The roots of
   // Q are given analytically as the solution to an S + 1 dimensional eigenvalue problem.
   BlockTimer bt(Timer::CONSTRUCT_PROM);
+  if (N <= 0)
+  {
+    return {};
+  }
   const auto S = dim_Q;
   MFEM_VERIFY(S >= 2, "Maximum error can only be found once two sample points have been "
                       "added to the PROM to define the parameter domain!");
@@ -459,32 +760,38 @@ std::vector<double> RomOperator::FindMaxError(int N) const
   //   }
   // }
 
-  // Fall back to sampling Q on discrete points if no roots exist in [start, end].
-  if (std::abs(z_star[0]) == 0.0)
+  // Fall back to sampling Q on discrete points if no roots exist in [start, end]. When
+  // more than one point is requested, the candidates are the distinct local minima of |Q|
+  // (one per interval between existing samples, approximately) rather than neighboring
+  // points of the same minimum.
+  if (N > 0 && std::abs(z_star[0]) == 0.0)
   {
     const auto delta = (end - start) / 1.0e6;
-    std::vector<double> Q_star(N, mfem::infinity());
-    while (start <= end)
+    auto EvalQ = [&](double x)
+    {
+      return std::abs((q.array() / (z_map.array() - x)).sum());
+    };
+    std::vector<std::pair<double, double>> minima;
+    double Q_prev = mfem::infinity(), Q_curr = EvalQ(start), x = start;
+    while (x <= end)
     {
-      const double Q = std::abs((q.array() / (z_map.array() - start)).sum());
-      for (int i = 0; i < N; i++)
+      const double Q_next = (x + delta <= end) ? EvalQ(x + delta) : mfem::infinity();
+      if (Q_curr <= Q_prev && Q_curr < Q_next)
       {
-        if (Q < Q_star[i])
-        {
-          for (int j = i + 1; j < N; j++)
-          {
-            z_star[j] = z_star[j - 1];
-            Q_star[j] = Q_star[j - 1];
-          }
-          z_star[i] = start;
-          Q_star[i] = Q;
-        }
+        minima.emplace_back(Q_curr, x);
       }
-      start += delta;
+      Q_prev = Q_curr;
+      Q_curr = Q_next;
+      x += delta;
+    }
+    MFEM_VERIFY(!minima.empty(), "Could not locate a maximum error in the range ["
+                                     << start << ", " << end << "]!");
+    std::sort(minima.begin(), minima.end());
+    z_star.resize(std::min(static_cast<std::size_t>(N), minima.size()));
+    for (std::size_t i = 0; i < z_star.size(); i++)
+    {
+      z_star[i] = minima[i].second;
     }
-    MFEM_VERIFY(N == 0 || std::abs(z_star[0]) > 0.0,
-                "Could not locate a maximum error in the range [" << start << ", " << end
-                                                                  << "]!");
   }
   std::vector<double> vals(z_star.size());
   std::transform(z_star.begin(), z_star.end(), vals.begin(),
@@ -5,7 +5,9 @@
 #define PALACE_MODELS_ROM_OPERATOR_HPP
 
 #include <complex>
+#include <cstdint>
 #include <memory>
+#include <string>
 #include <vector>
 #include <Eigen/Dense>
 #include "linalg/ksp.hpp"
@@ -15,7 +17,9 @@
 namespace palace
 {
 
+class ErrorIndicator;
 class IoData;
+class PostOperator;
 class SpaceOperator;
 
 //
@@ -54,6 +58,18 @@ private:
   Eigen::VectorXcd q;
   std::vector<double> z;
 
+  // Header for binary PROM checkpoint files, identifying the mesh and its partitioning as
+  // well as the HDM operators (material and boundary configuration) using fingerprints
+  // xᴴ A x for a fixed test vector x.
+  struct CheckpointHeader
+  {
+    std::uint64_t magic, mesh_hash;
+    std::int64_t version, size, rank, local_size, global_size, num_elem;
+    std::int64_t has_C, has_RHS1, dim_V, dim_Q, indicator_samples;
+    std::complex<double> fingerprint[4];
+  };
+  CheckpointHeader GetCheckpointHeader();
+
 public:
   RomOperator(const IoData &iodata, SpaceOperator &space_op, int max_size);
 
@@ -69,17 +85,38 @@ public:
   // Assemble and solve the HDM at the specified frequency.
   void SolveHDM(double omega, ComplexVector &u);
 
-  // Add the solution vector to the reduced-order basis and update the PROM.
+  // Add the solution vector(s) to the reduced-order basis and update the PROM.
   void UpdatePROM(double omega, const ComplexVector &u);
+  void UpdatePROM(const std::vector<double> &omega,
+                  const std::vector<const ComplexVector *> &u);
 
   // Assemble and solve the PROM at the specified frequency, expanding the solution back
   // into the high-dimensional space.
   void SolvePROM(double omega, ComplexVector &u);
 
+  // Assemble and solve the PROM at the specified frequency, returning the solution
+  // coefficients in the reduced-order basis without expanding them.
+  void SolvePROM(double omega, Eigen::VectorXcd &y);
+
+  // Precompute the projections of the postprocessing quantities onto the reduced-order
+  // basis, for postprocessing directly from the PROM solution coefficients. Returns whether
+  // or not all configured postprocessing quantities are available in the reduced space.
+  bool InitializePostOperator(PostOperator &post_op) const;
+
   // Compute the location(s) of the maximum error in the range of the previously sampled
-  // parameter points.
+  // parameter points. Returns at most N points, and none if N is not positive.
   std::vector<double> FindMaxError(int N = 1) const;
 
+  // Save the PROM (reduced-order basis, projected matrices, and MRI data) and the error
+  // indicator from the HDM samples to a binary checkpoint with one file per process in the
+  // given directory.
+  void SaveCheckpoint(const std::string &path, const ErrorIndicator &indicator);
+
+  // Initialize the PROM and error indicator from a checkpoint. The checkpoint is only
+  // loaded if it was written for the same mesh, partitioning, and HDM operators, and the
+  // return value indicates whether or not it was successfully loaded.
+  bool LoadCheckpoint(const std::string &path, ErrorIndicator &indicator);
+
   // Compute eigenvalue estimates for the current PROM system.
   std::vector<std::complex<double>> ComputeEigenvalueEstimates() const;
 };
@@ -3,6 +3,7 @@
 
 #include "spaceoperator.hpp"
 
+#include <algorithm>
 #include <set>
 #include <type_traits>
 #include "fem/bilinearform.hpp"
@@ -25,7 +26,9 @@ using namespace std::complex_literals;
 SpaceOperator::SpaceOperator(const IoData &iodata,
                              const std::vector<std::unique_ptr<Mesh>> &mesh)
   : pc_mat_real(iodata.solver.linear.pc_mat_real),
-    pc_mat_shifted(iodata.solver.linear.pc_mat_shifted), print_hdr(true),
+    pc_mat_shifted(iodata.solver.linear.pc_mat_shifted),
+    mg_single(iodata.solver.linear.mg_single_precision),
+    pc_mat_cache(iodata.solver.linear.pc_mat_cache), print_hdr(true),
     print_prec_hdr(true), dbc_attr(SetUpBoundaryProperties(iodata, *mesh.back())),
     nd_fecs(fem::ConstructFECollections<mfem::ND_FECollection>(
         iodata.solver.order, mesh.back()->Dimension(), iodata.solver.linear.mg_max_levels,
@@ -294,6 +297,60 @@ auto AssembleAuxOperators(const FiniteElementSpaceHierarchy &fespaces,
   return a.Assemble(fespaces, skip_zeros, l0);
 }
 
+auto AssembleFullOperator(const FiniteElementSpace &fespace,
+                          const MaterialPropertyCoefficient *df,
+                          const MaterialPropertyCoefficient *f,
+                          const MaterialPropertyCoefficient *dfb,
+                          const MaterialPropertyCoefficient *fb, bool skip_zeros = false)
+{
+  BilinearForm a(fespace);
+  AddIntegrators(a, df, f, dfb, fb);
+  return a.FullAssemble(skip_zeros);
+}
+
+auto AssembleFullAuxOperator(const FiniteElementSpace &fespace,
+                             const MaterialPropertyCoefficient *f,
+                             const MaterialPropertyCoefficient *fb, bool skip_zeros = false)
+{
+  BilinearForm a(fespace);
+  AddAuxIntegrators(a, f, fb);
+  return a.FullAssemble(skip_zeros);
+}
+
+// Returns the number of levels, starting from the coarsest, of the multigrid hierarchy
+// which are fully assembled (see BilinearForm::Assemble).
+std::size_t GetNumFullAssemblyLevels(const FiniteElementSpaceHierarchy &fespaces)
+{
+  std::size_t l = 1;
+  while (l < fespaces.GetNumLevels() &&
+         fespaces.GetFESpaceAtLevel(l).GetFEColl().GetOrder() <
+             BilinearForm::pa_order_threshold)
+  {
+    l++;
+  }
+  return l;
+}
+
+// Forms the linear combination of the cached terms of an operator and adds an additional
+// matrix contribution. Either may be empty. The sum is formed in storage reused across
+// calls, and copied into the returned matrix since each preconditioner owns its level
+// operators and more than one may be in use at a time.
+std::unique_ptr<Operator> SumCachedOperator(hypre::HypreCSRMatrixSum *sum,
+                                            const std::vector<double> &coeffs,
+                                            std::unique_ptr<hypre::HypreCSRMatrix> &&b)
+{
+  if (!sum)
+  {
+    return std::move(b);
+  }
+  const auto &b_sum = sum->Sum(coeffs);
+  if (!b)
+  {
+    return std::make_unique<hypre::HypreCSRMatrix>(hypre_CSRMatrixClone(b_sum, 1));
+  }
+  return std::make_unique<hypre::HypreCSRMatrix>(hypre_CSRMatrixAdd(1.0, b_sum, 1.0, *b));
+}
+
 }  // namespace
 
 template <typename OperType>
@@ -708,7 +765,86 @@ std::unique_ptr<OperType> SpaceOperator::GetPreconditionerMatrix(double a0, doub
   std::vector<std::unique_ptr<Operator>> br_vec(n_levels), bi_vec(n_levels),
       br_aux_vec(n_levels), bi_aux_vec(n_levels);
   constexpr bool skip_zeros = false, assemble_q_data = false;
-  if (std::is_same<OperType, ComplexOperator>::value && !pc_mat_real)
+  const bool complex = std::is_same<OperType, ComplexOperator>::value && !pc_mat_real;
+  const double a2s = pc_mat_shifted ? std::abs(a2) : a2;
+
+  // When enabled, the fully assembled (coarse) levels are formed from the cached terms of
+  // the affine decomposition, so only the frequency-dependent boundary contribution A2(a3)
+  // needs to be assembled at each call. The remaining levels are assembled below.
+  if (pc_mat_cache && (!pc_mat_terms || pc_mat_terms->complex != complex))
+  {
+    InitializePreconditionerMatrixCache(complex);
+  }
+  const std::size_t l0 = pc_mat_terms ? pc_mat_terms->b.size() : 0,
+                    l0_aux = pc_mat_terms ? pc_mat_terms->b_aux.size() : 0;
+  if (pc_mat_terms)
+  {
+    MaterialPropertyCoefficient dfbr(mat_op.MaxCeedBdrAttribute()),
+        dfbi(mat_op.MaxCeedBdrAttribute()), fbr(mat_op.MaxCeedBdrAttribute()),
+        fbi(mat_op.MaxCeedBdrAttribute());
+    if (complex)
+    {
+      AddExtraSystemBdrCoefficients(a3, dfbr, dfbi, fbr, fbi);
+    }
+    else
+    {
+      AddExtraSystemBdrCoefficients(a3, dfbr, dfbr, fbr, fbr);
+    }
+    int empty[4] = {(dfbr.empty() && fbr.empty()), (dfbi.empty() && fbi.empty()),
+                    fbr.empty(), fbi.empty()};
+    Mpi::GlobalMin(4, empty, GetComm());
+    const std::array<std::vector<double>, 2> coeffs = {
+        complex ? std::vector<double>{a0, a2s} : std::vector<double>{a0, a1, a2s},
+        complex ? std::vector<double>{a1, a2} : std::vector<double>{}};
+    const std::array<const MaterialPropertyCoefficient *, 2> dfb = {&dfbr, &dfbi},
+                                                             fb = {&fbr, &fbi};
+    for (int i = 0; i < (complex ? 2 : 1); i++)
+    {
+      for (std::size_t l = 0; l < l0; l++)
+      {
+        auto &b_l = (i == 0) ? br_vec[l] : bi_vec[l];
+        b_l = SumCachedOperator(
+            pc_mat_terms->b[l][i].get(), coeffs[i],
+            empty[i] ? nullptr
+                     : AssembleFullOperator(GetNDSpaces().GetFESpaceAtLevel(l), nullptr,
+                                            nullptr, dfb[i], fb[i], skip_zeros));
+      }
+      for (std::size_t l = 0; l < l0_aux; l++)
+      {
+        auto &b_l = (i == 0) ? br_aux_vec[l] : bi_aux_vec[l];
+        b_l = SumCachedOperator(
+            pc_mat_terms->b_aux[l][i].get(), coeffs[i],
+            empty[2 + i] ? nullptr
+                         : AssembleFullAuxOperator(GetH1Spaces().GetFESpaceAtLevel(l),
+                                                   nullptr, fb[i], skip_zeros));
+      }
+    }
+  }
+  auto AssemblePartialLevels = [&](const MaterialPropertyCoefficient &df,
+                                   const MaterialPropertyCoefficient &f,
+                                   const MaterialPropertyCoefficient &dfb,
+                                   const MaterialPropertyCoefficient &fb,
+                                   std::vector<std::unique_ptr<Operator>> &b_vec,
+                                   std::vector<std::unique_ptr<Operator>> &b_aux_vec)
+  {
+    if (l0 < n_levels)
+    {
+      auto b_pa_vec = AssembleOperators(GetNDSpaces(), &df, &f, &dfb, &fb, skip_zeros,
+                                        assemble_q_data, l0);
+      std::move(b_pa_vec.begin(), b_pa_vec.end(), b_vec.begin() + l0);
+    }
+    if (l0_aux < n_levels)
+    {
+      auto b_pa_vec = AssembleAuxOperators(GetH1Spaces(), &f, &fb, skip_zeros,
+                                           assemble_q_data, l0_aux);
+      std::move(b_pa_vec.begin(), b_pa_vec.end(), b_aux_vec.begin() + l0_aux);
+    }
+  };
+  if (l0 == n_levels && l0_aux == n_levels)
+  {
+    // All levels are fully assembled.
+  }
+  else if (complex)
   {
     MaterialPropertyCoefficient dfr(mat_op.MaxCeedAttribute()),
         dfi(mat_op.MaxCeedAttribute()), fr(mat_op.MaxCeedAttribute()),
@@ -719,8 +855,8 @@ std::unique_ptr<OperType> SpaceOperator::GetPreconditionerMatrix(double a0, doub
     AddStiffnessBdrCoefficients(a0, fbr);
     AddDampingCoefficients(a1, fi);
     AddDampingBdrCoefficients(a1, fbi);
-    AddRealMassCoefficients(pc_mat_shifted ? std::abs(a2) : a2, fr);
-    AddRealMassBdrCoefficients(pc_mat_shifted ? std::abs(a2) : a2, fbr);
+    AddRealMassCoefficients(a2s, fr);
+    AddRealMassBdrCoefficients(a2s, fbr);
     AddImagMassCoefficients(a2, fi);
     AddExtraSystemBdrCoefficients(a3, dfbr, dfbi, fbr, fbi);
     int empty[2] = {(dfr.empty() && fr.empty() && dfbr.empty() && fbr.empty()),
@@ -728,17 +864,11 @@ std::unique_ptr<OperType> SpaceOperator::GetPreconditionerMatrix(double a0, doub
     Mpi::GlobalMin(2, empty, GetComm());
     if (!empty[0])
     {
-      br_vec = AssembleOperators(GetNDSpaces(), &dfr, &fr, &dfbr, &fbr, skip_zeros,
-                                 assemble_q_data);
-      br_aux_vec =
-          AssembleAuxOperators(GetH1Spaces(), &fr, &fbr, skip_zeros, assemble_q_data);
+      AssemblePartialLevels(dfr, fr, dfbr, fbr, br_vec, br_aux_vec);
     }
     if (!empty[1])
     {
-      bi_vec = AssembleOperators(GetNDSpaces(), &dfi, &fi, &dfbi, &fbi, skip_zeros,
-                                 assemble_q_data);
-      bi_aux_vec =
-          AssembleAuxOperators(GetH1Spaces(), &fi, &fbi, skip_zeros, assemble_q_data);
+      AssemblePartialLevels(dfi, fi, dfbi, fbi, bi_vec, bi_aux_vec);
     }
   }
   else
@@ -750,17 +880,14 @@ std::unique_ptr<OperType> SpaceOperator::GetPreconditionerMatrix(double a0, doub
     AddStiffnessBdrCoefficients(a0, fbr);
     AddDampingCoefficients(a1, fr);
     AddDampingBdrCoefficients(a1, fbr);
-    AddAbsMassCoefficients(pc_mat_shifted ? std::abs(a2) : a2, fr);
-    AddRealMassBdrCoefficients(pc_mat_shifted ? std::abs(a2) : a2, fbr);
+    AddAbsMassCoefficients(a2s, fr);
+    AddRealMassBdrCoefficients(a2s, fbr);
     AddExtraSystemBdrCoefficients(a3, dfbr, dfbr, fbr, fbr);
     int empty = (dfr.empty() && fr.empty() && dfbr.empty() && fbr.empty());
     Mpi::GlobalMin(1, &empty, GetComm());
     if (!empty)
     {
-      br_vec = AssembleOperators(GetNDSpaces(), &dfr, &fr, &dfbr, &fbr, skip_zeros,
-                                 assemble_q_data);
-      br_aux_vec =
-          AssembleAuxOperators(GetH1Spaces(), &fr, &fbr, skip_zeros, assemble_q_data);
+      AssemblePartialLevels(dfr, fr, dfbr, fbr, br_vec, br_aux_vec);
     }
   }
 
@@ -794,6 +921,11 @@ std::unique_ptr<OperType> SpaceOperator::GetPreconditionerMatrix(double a0, doub
           Mpi::Print("\n");
         }
       }
+      if (mg_single && l > 0)
+      {
+        br_l = hypre::ToSinglePrecision(std::move(br_l));
+        bi_l = hypre::ToSinglePrecision(std::move(bi_l));
+      }
       auto B_l =
           BuildLevelParOperator<OperType>(std::move(br_l), std::move(bi_l), fespace_l);
       B_l->SetEssentialTrueDofs(dbc_tdof_lists_l, Operator::DiagonalPolicy::DIAG_ONE);
@@ -812,6 +944,96 @@ std::unique_ptr<OperType> SpaceOperator::GetPreconditionerMatrix(double a0, doub
   return B;
 }
 
+void SpaceOperator::InitializePreconditionerMatrixCache(bool complex)
+{
+  // Assemble each term of the affine decomposition of the preconditioner matrix with unit
+  // coefficient on the fully assembled levels of the hierarchy. For a complex-valued
+  // preconditioner matrix, B = a0 K + a2 Mr + i (a1 C + a2 Mi), otherwise
+  // B = a0 K + a1 C + a2 |M|. The nonaffine contribution A2(a3) is not cached.
+  constexpr bool skip_zeros = false;
+  const auto n_levels = GetNumFullAssemblyLevels(GetNDSpaces());
+  const auto n_aux_levels = GetNumFullAssemblyLevels(GetH1Spaces());
+  using TermVector = std::vector<std::unique_ptr<hypre::HypreCSRMatrix>>;
+  std::vector<std::array<TermVector, 2>> b(n_levels), b_aux(n_aux_levels);
+  auto AddTerm = [&](int i, auto &&AddCoefficients)
+  {
+    MaterialPropertyCoefficient df(mat_op.MaxCeedAttribute()), f(mat_op.MaxCeedAttribute()),
+        fb(mat_op.MaxCeedBdrAttribute());
+    AddCoefficients(df, f, fb);
+    int empty[2] = {(df.empty() && f.empty() && fb.empty()), (f.empty() && fb.empty())};
+    Mpi::GlobalMin(2, empty, GetComm());
+    for (std::size_t l = 0; l < n_levels; l++)
+    {
+      b[l][i].push_back(empty[0] ? nullptr
+                                 : AssembleFullOperator(GetNDSpaces().GetFESpaceAtLevel(l),
+                                                        &df, &f, nullptr, &fb, skip_zeros));
+    }
+    for (std::size_t l = 0; l < n_aux_levels; l++)
+    {
+      b_aux[l][i].push_back(
+          empty[1] ? nullptr
+                   : AssembleFullAuxOperator(GetH1Spaces().GetFESpaceAtLevel(l), &f, &fb,
+                                             skip_zeros));
+    }
+  };
+  auto AddStiffness = [this](auto &df, auto &f, auto &fb)
+  {
+    AddStiffnessCoefficients(1.0, df, f);
+    AddStiffnessBdrCoefficients(1.0, fb);
+  };
+  auto AddDamping = [this](auto &, auto &f, auto &fb)
+  {
+    AddDampingCoefficients(1.0, f);
+    AddDampingBdrCoefficients(1.0, fb);
+  };
+  if (complex)
+  {
+    AddTerm(0, AddStiffness);
+    AddTerm(0,
+            [this](auto &, auto &f, auto &fb)
+            {
+              AddRealMassCoefficients(1.0, f);
+              AddRealMassBdrCoefficients(1.0, fb);
+            });
+    AddTerm(1, AddDamping);
+    AddTerm(1, [this](auto &, auto &f, auto &) { AddImagMassCoefficients(1.0, f); });
+  }
+  else
+  {
+    AddTerm(0, AddStiffness);
+    AddTerm(0, AddDamping);
+    AddTerm(0,
+            [this](auto &, auto &f, auto &fb)
+            {
+              AddAbsMassCoefficients(1.0, f);
+              AddRealMassBdrCoefficients(1.0, fb);
+            });
+  }
+
+  // Compute the merged sparsity patterns for each level.
+  auto BuildSums = [](std::vector<std::array<TermVector, 2>> &b_terms)
+  {
+    std::vector<std::array<std::unique_ptr<hypre::HypreCSRMatrixSum>, 2>> b_sums(
+        b_terms.size());
+    for (std::size_t l = 0; l < b_terms.size(); l++)
+    {
+      for (int i = 0; i < 2; i++)
+      {
+        auto &terms = b_terms[l][i];
+        if (std::any_of(terms.begin(), terms.end(), [](const auto &t) { return !!t; }))
+        {
+          b_sums[l][i] = std::make_unique<hypre::HypreCSRMatrixSum>(std::move(terms));
+        }
+      }
+    }
+    return b_sums;
+  };
+  pc_mat_terms = std::make_unique<PreconditionerMatrixCache>();
+  pc_mat_terms->complex = complex;
+  pc_mat_terms->b = BuildSums(b);
+  pc_mat_terms->b_aux = BuildSums(b_aux);
+}
+
 void SpaceOperator::AddStiffnessCoefficients(double coeff, MaterialPropertyCoefficient &df,
                                              MaterialPropertyCoefficient &f)
 {
@@ -938,6 +1160,64 @@ bool SpaceOperator::GetExcitationVector2(double omega, ComplexVector &RHS2)
   return nnz2;
 }
 
+namespace
+{
+
+void AddBdrExcitationVector(FiniteElementSpace &fespace, SumVectorCoefficient &fb,
+                            Vector &RHS)
+{
+  mfem::LinearForm rhs(&fespace.Get());
+  rhs.AddBoundaryIntegrator(new VectorFEBoundaryLFIntegrator(fb));
+  rhs.UseFastAssembly(false);
+  rhs.UseDevice(false);
+  rhs.Assemble();
+  rhs.UseDevice(true);
+  fespace.GetProlongationMatrix()->AddMultTranspose(rhs, RHS);
+}
+
+}  // namespace
+
+bool SpaceOperator::GetLumpedPortExcitationVector(int idx, double omega,
+                                                  ComplexVector &RHS)
+{
+  // Frequency domain excitation vector for a single lumped port: RHS = iω RHS1.
+  RHS.SetSize(GetNDSpace().GetTrueVSize());
+  RHS.UseDevice(true);
+  RHS = 0.0;
+  SumVectorCoefficient fb(GetMesh().SpaceDimension());
+  lumped_port_op.AddExcitationBdrCoefficients(idx, fb);
+  int empty = (fb.empty());
+  Mpi::GlobalMin(1, &empty, GetComm());
+  if (empty)
+  {
+    return false;
+  }
+  AddBdrExcitationVector(GetNDSpace(), fb, RHS.Real());
+  RHS *= 1i * omega;
+  linalg::SetSubVector(RHS, nd_dbc_tdof_lists.back(), 0.0);
+  return true;
+}
+
+bool SpaceOperator::GetWavePortExcitationVector(int idx, double omega, ComplexVector &RHS)
+{
+  // Frequency domain excitation vector for a single wave port: RHS = RHS2(ω).
+  RHS.SetSize(GetNDSpace().GetTrueVSize());
+  RHS.UseDevice(true);
+  RHS = 0.0;
+  SumVectorCoefficient fbr(GetMesh().SpaceDimension()), fbi(GetMesh().SpaceDimension());
+  wave_port_op.AddExcitationBdrCoefficients(idx, omega, fbr, fbi);
+  int empty = (fbr.empty() && fbi.empty());
+  Mpi::GlobalMin(1, &empty, GetComm());
+  if (empty)
+  {
+    return false;
+  }
+  AddBdrExcitationVector(GetNDSpace(), fbr, RHS.Real());
+  AddBdrExcitationVector(GetNDSpace(), fbi, RHS.Imag());
+  linalg::SetSubVector(RHS, nd_dbc_tdof_lists.back(), 0.0);
+  return true;
+}
+
 bool SpaceOperator::AddExcitationVector1Internal(Vector &RHS1)
 {
   // Assemble the time domain excitation -g'(t) J or frequency domain excitation -iω J.
@@ -954,13 +1234,7 @@ bool SpaceOperator::AddExcitationVector1Internal(Vector &RHS1)
   {
     return false;
   }
-  mfem::LinearForm rhs1(&GetNDSpace().Get());
-  rhs1.AddBoundaryIntegrator(new VectorFEBoundaryLFIntegrator(fb));
-  rhs1.UseFastAssembly(false);
-  rhs1.UseDevice(false);
-  rhs1.Assemble();
-  rhs1.UseDevice(true);
-  GetNDSpace().GetProlongationMatrix()->AddMultTranspose(rhs1, RHS1);
+  AddBdrExcitationVector(GetNDSpace(), fb, RHS1);
   return true;
 }
 
@@ -978,24 +1252,8 @@ bool SpaceOperator::AddExcitationVector2Internal(double omega, ComplexVector &RH
   {
     return false;
   }
-  {
-    mfem::LinearForm rhs2(&GetNDSpace().Get());
-    rhs2.AddBoundaryIntegrator(new VectorFEBoundaryLFIntegrator(fbr));
-    rhs2.UseFastAssembly(false);
-    rhs2.UseDevice(false);
-    rhs2.Assemble();
-    rhs2.UseDevice(true);
-    GetNDSpace().GetProlongationMatrix()->AddMultTranspose(rhs2, RHS2.Real());
-  }
-  {
-    mfem::LinearForm rhs2(&GetNDSpace().Get());
-    rhs2.AddBoundaryIntegrator(new VectorFEBoundaryLFIntegrator(fbi));
-    rhs2.UseFastAssembly(false);
-    rhs2.UseDevice(false);
-    rhs2.Assemble();
-    rhs2.UseDevice(true);
-    GetNDSpace().GetProlongationMatrix()->AddMultTranspose(rhs2, RHS2.Imag());
-  }
+  AddBdrExcitationVector(GetNDSpace(), fbr, RHS2.Real());
+  AddBdrExcitationVector(GetNDSpace(), fbi, RHS2.Imag());
   return true;
 }
 
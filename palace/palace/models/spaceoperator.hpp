@@ -4,11 +4,13 @@
 #ifndef PALACE_MODELS_SPACE_OPERATOR_HPP
 #define PALACE_MODELS_SPACE_OPERATOR_HPP
 
+#include <array>
 #include <complex>
 #include <memory>
 #include <vector>
 #include <mfem.hpp>
 #include "fem/fespace.hpp"
+#include "linalg/hypre.hpp"
 #include "linalg/operator.hpp"
 #include "linalg/vector.hpp"
 #include "models/farfieldboundaryoperator.hpp"
@@ -33,6 +35,8 @@ class SpaceOperator
 private:
   const bool pc_mat_real;     // Use real-valued matrix for preconditioner
   const bool pc_mat_shifted;  // Use shifted mass matrix for preconditioner
+  const bool mg_single;       // Use single precision multigrid level operators
+  const bool pc_mat_cache;    // Cache fully assembled preconditioner matrix terms
 
   // Helper variables for log file printing.
   bool print_hdr, print_prec_hdr;
@@ -83,6 +87,19 @@ private:
   bool AddExcitationVector1Internal(Vector &RHS);
   bool AddExcitationVector2Internal(double omega, ComplexVector &RHS);
 
+  // Cached terms of the affine decomposition of the preconditioner matrix on the fully
+  // assembled (coarse) levels of the multigrid hierarchy, for which only the coefficients
+  // change between calls to GetPreconditionerMatrix. Index 0 is the real part and index 1
+  // the imaginary part. Each term is stored along with the merged pattern of their sum, so
+  // the cache costs up to four (real) or six (complex) matrix copies on each level.
+  struct PreconditionerMatrixCache
+  {
+    bool complex;
+    std::vector<std::array<std::unique_ptr<hypre::HypreCSRMatrixSum>, 2>> b, b_aux;
+  };
+  std::unique_ptr<PreconditionerMatrixCache> pc_mat_terms;
+  void InitializePreconditionerMatrixCache(bool complex);
+
 public:
   SpaceOperator(const IoData &iodata, const std::vector<std::unique_ptr<Mesh>> &mesh);
 
@@ -198,6 +215,13 @@ public:
   bool GetExcitationVector1(ComplexVector &RHS1);
   bool GetExcitationVector2(double omega, ComplexVector &RHS2);
 
+  // Assemble the frequency domain right-hand side source term vector for only a single
+  // excited lumped or wave port, used when solving for each port excitation separately.
+  // Lumped and wave port indices are not unique with respect to one another, hence the
+  // separate methods.
+  bool GetLumpedPortExcitationVector(int idx, double omega, ComplexVector &RHS);
+  bool GetWavePortExcitationVector(int idx, double omega, ComplexVector &RHS);
+
   // Construct a constant or randomly initialized vector which satisfies the PEC essential
   // boundary conditions.
   void GetRandomInitialVector(ComplexVector &v);
@@ -3,6 +3,7 @@
 
 #include "surfacepostoperator.hpp"
 
+#include <algorithm>
 #include <complex>
 #include <set>
 #include "fem/gridfunction.hpp"
@@ -12,6 +13,7 @@
 #include "utils/communication.hpp"
 #include "utils/geodata.hpp"
 #include "utils/iodata.hpp"
+#include "utils/omp.hpp"
 #include "utils/prettyprint.hpp"
 
 namespace palace
@@ -54,6 +56,39 @@ mfem::Array<int> SetUpBoundaryProperties(const T &data,
   return attr_list;
 }
 
+template <typename Body>
+void ForAllQuadraturePoints(mfem::ParMesh &mesh, const mfem::Array<int> &attr_list,
+                            Body &&body)
+{
+  // Loop over the quadrature points of all boundary elements making up the surface, with
+  // the same quadrature rule as for boundary linear form integrators. The neighboring
+  // element transformations are configured at each point.
+  int bdr_attr_max = mesh.bdr_attributes.Size() ? mesh.bdr_attributes.Max() : 0;
+  mfem::Array<int> attr_marker = mesh::AttrToMarker(bdr_attr_max, attr_list);
+  mfem::FaceElementTransformations FET;
+  mfem::IsoparametricTransformation T1, T2;
+  int q = 0;
+  for (int i = 0; i < mesh.GetNBE(); i++)
+  {
+    if (!attr_marker[mesh.GetBdrAttribute(i) - 1])
+    {
+      continue;
+    }
+    mfem::ElementTransformation &T = *mesh.GetBdrElementTransformation(i);
+    const int q_order = fem::DefaultIntegrationOrder::Get(T);
+    const mfem::IntegrationRule &ir =
+        mfem::IntRules.Get(mesh.GetBdrElementGeometry(i), q_order);
+    for (int j = 0; j < ir.GetNPoints(); j++)
+    {
+      const mfem::IntegrationPoint &ip = ir.IntPoint(j);
+      T.SetIntPoint(&ip);
+      bool ori = BdrGridFunctionCoefficient::GetBdrElementNeighborTransformations(
+          i, mesh, FET, T1, T2, &ip);
+      body(q++, T, FET, ori);
+    }
+  }
+}
+
 }  // namespace
 
 SurfacePostOperator::SurfaceFluxData::SurfaceFluxData(
@@ -102,29 +137,6 @@ SurfacePostOperator::SurfaceFluxData::SurfaceFluxData(
   }
 }
 
-std::unique_ptr<mfem::Coefficient>
-SurfacePostOperator::SurfaceFluxData::GetCoefficient(const mfem::ParGridFunction *E,
-                                                     const mfem::ParGridFunction *B,
-                                                     const MaterialOperator &mat_op) const
-{
-  switch (type)
-  {
-    case SurfaceFluxType::ELECTRIC:
-      return std::make_unique<
-          RestrictedCoefficient<BdrSurfaceFluxCoefficient<SurfaceFluxType::ELECTRIC>>>(
-          attr_list, E, nullptr, mat_op, two_sided, center);
-    case SurfaceFluxType::MAGNETIC:
-      return std::make_unique<
-          RestrictedCoefficient<BdrSurfaceFluxCoefficient<SurfaceFluxType::MAGNETIC>>>(
-          attr_list, nullptr, B, mat_op, two_sided, center);
-    case SurfaceFluxType::POWER:
-      return std::make_unique<
-          RestrictedCoefficient<BdrSurfaceFluxCoefficient<SurfaceFluxType::POWER>>>(
-          attr_list, E, B, mat_op, two_sided, center);
-  }
-  return {};
-}
-
 SurfacePostOperator::InterfaceDielectricData::InterfaceDielectricData(
     const config::InterfaceDielectricData &data, const mfem::ParMesh &mesh,
     const mfem::Array<int> &bdr_attr_marker)
@@ -162,32 +174,6 @@ SurfacePostOperator::InterfaceDielectricData::InterfaceDielectricData(
   side_n_min = (data.side == config::InterfaceDielectricData::Side::SMALLER_REF_INDEX);
 }
 
-std::unique_ptr<mfem::Coefficient>
-SurfacePostOperator::InterfaceDielectricData::GetCoefficient(
-    const GridFunction &E, const MaterialOperator &mat_op) const
-{
-  switch (type)
-  {
-    case InterfaceDielectricType::DEFAULT:
-      return std::make_unique<RestrictedCoefficient<
-          InterfaceDielectricCoefficient<InterfaceDielectricType::DEFAULT>>>(
-          attr_list, E, mat_op, t, epsilon, side_n_min);
-    case InterfaceDielectricType::MA:
-      return std::make_unique<RestrictedCoefficient<
-          InterfaceDielectricCoefficient<InterfaceDielectricType::MA>>>(
-          attr_list, E, mat_op, t, epsilon, side_n_min);
-    case InterfaceDielectricType::MS:
-      return std::make_unique<RestrictedCoefficient<
-          InterfaceDielectricCoefficient<InterfaceDielectricType::MS>>>(
-          attr_list, E, mat_op, t, epsilon, side_n_min);
-    case InterfaceDielectricType::SA:
-      return std::make_unique<RestrictedCoefficient<
-          InterfaceDielectricCoefficient<InterfaceDielectricType::SA>>>(
-          attr_list, E, mat_op, t, epsilon, side_n_min);
-  }
-  return {};  // For compiler warning
-}
-
 SurfacePostOperator::SurfacePostOperator(const IoData &iodata,
                                          const MaterialOperator &mat_op,
                                          mfem::ParFiniteElementSpace &h1_fespace)
@@ -236,22 +222,104 @@ SurfacePostOperator::SurfacePostOperator(const IoData &iodata,
 std::complex<double> SurfacePostOperator::GetSurfaceFlux(int idx, const GridFunction *E,
                                                          const GridFunction *B) const
 {
-  // For complex-valued fields, output the separate real and imaginary parts for the time-
-  // harmonic quantity. For power flux (Poynting vector), output only the stationary real
-  // part and not the part which has double the frequency.
+  std::complex<double> dot = GetLocalSurfaceFlux(idx, E, B);
+  Mpi::GlobalSum(1, &dot, (E) ? E->GetComm() : B->GetComm());
+  return dot;
+}
+
+std::complex<double> SurfacePostOperator::GetLocalSurfaceFlux(int idx,
+                                                              const GridFunction *E,
+                                                              const GridFunction *B) const
+{
   auto it = flux_surfs.find(idx);
   MFEM_VERIFY(it != flux_surfs.end(),
               "Unknown surface flux postprocessing index requested!");
+  const auto &data = it->second;
+  const auto &qdata = GetQuadratureData(data);
+  const int nq = static_cast<int>(qdata.w.size());
+  const int sdim = mat_op.SpaceDimension();
+  const bool use_E = (data.type != SurfaceFluxType::MAGNETIC);
+  const bool use_B = (data.type != SurfaceFluxType::ELECTRIC);
+  MFEM_VERIFY((!use_E || E) && (!use_B || B),
+              "Missing E or B field grid function for surface flux calculation!");
   const bool has_imag = (E) ? E->HasImag() : B->HasImag();
-  auto f =
-      it->second.GetCoefficient(E ? &E->Real() : nullptr, B ? &B->Real() : nullptr, mat_op);
-  std::complex<double> dot(GetLocalSurfaceIntegral(*f, it->second.attr_list), 0.0);
+  auto Integrate = [&](const double *e, const double *b)
+  {
+    // Compute F ⋅ n with F = ε E, B, or E x μ⁻¹ B at each point. For interior faces, the
+    // flux is either the average or the sum of contributions from opposite sides with
+    // opposite normals.
+    auto GetLocalFlux = [&](int attr, int k, double *V)
+    {
+      switch (data.type)
+      {
+        case SurfaceFluxType::ELECTRIC:
+          mat_op.GetPermittivityReal(attr).Mult(e + k, V);
+          break;
+        case SurfaceFluxType::MAGNETIC:
+          std::copy(b + k, b + k + sdim, V);
+          break;
+        case SurfaceFluxType::POWER:
+          {
+            double W[3];
+            mat_op.GetInvPermeability(attr).Mult(b + k, W);
+            V[0] = e[k + 1] * W[2] - e[k + 2] * W[1];
+            V[1] = e[k + 2] * W[0] - e[k] * W[2];
+            V[2] = e[k] * W[1] - e[k + 1] * W[0];
+          }
+          break;
+      }
+    };
+    double dot = 0.0;
+    PalacePragmaOmp(parallel for reduction(+ : dot) schedule(static))
+    for (int q = 0; q < nq; q++)
+    {
+      double VU[3], VL[3];
+      GetLocalFlux(qdata.attr1[q], q * sdim, VU);
+      if (qdata.attr2[q] >= 0)
+      {
+        // Double-sided, not a true boundary.
+        GetLocalFlux(qdata.attr2[q], (nq + q) * sdim, VL);
+        for (int d = 0; d < sdim; d++)
+        {
+          VU[d] = data.two_sided ? VU[d] - VL[d] : 0.5 * (VU[d] + VL[d]);
+        }
+      }
+      // Dot with normal direction and assign appropriate sign. The normal is oriented to
+      // point into element 1.
+      const double *normal = qdata.normal.data() + q * sdim;
+      double flux = 0.0;
+      for (int d = 0; d < sdim; d++)
+      {
+        flux += VU[d] * normal[d];
+      }
+      if (!data.two_sided)
+      {
+        // Orient outward from the surface with the given center.
+        double xn = 0.0;
+        for (int d = 0; d < sdim; d++)
+        {
+          xn += (qdata.x[q * sdim + d] - data.center(d)) * normal[d];
+        }
+        flux = (xn < 0.0) ? -flux : flux;
+      }
+      dot += qdata.w[q] * flux;
+    }
+    return dot;
+  };
+
+  // For complex-valued fields, output the separate real and imaginary parts for the time-
+  // harmonic quantity. For power flux (Poynting vector), output only the stationary real
+  // part and not the part which has double the frequency.
+  Vector Vr, Vi, Wr, Wi;
+  std::complex<double> dot(
+      Integrate(use_E ? InterpolateField(data, E->Real(), Vr) : nullptr,
+                use_B ? InterpolateField(data, B->Real(), Wr) : nullptr),
+      0.0);
   if (has_imag)
   {
-    f = it->second.GetCoefficient(E ? &E->Imag() : nullptr, B ? &B->Imag() : nullptr,
-                                  mat_op);
-    double doti = GetLocalSurfaceIntegral(*f, it->second.attr_list);
-    if (it->second.type == SurfaceFluxType::POWER)
+    double doti = Integrate(use_E ? InterpolateField(data, E->Imag(), Vi) : nullptr,
+                            use_B ? InterpolateField(data, B->Imag(), Wi) : nullptr);
+    if (data.type == SurfaceFluxType::POWER)
     {
       dot += doti;
     }
@@ -260,7 +328,6 @@ std::complex<double> SurfacePostOperator::GetSurfaceFlux(int idx, const GridFunc
       dot.imag(doti);
     }
   }
-  Mpi::GlobalSum(1, &dot, (E) ? E->GetComm() : B->GetComm());
   return dot;
 }
 
@@ -274,30 +341,224 @@ double SurfacePostOperator::GetInterfaceLossTangent(int idx) const
 
 double SurfacePostOperator::GetInterfaceElectricFieldEnergy(int idx,
                                                             const GridFunction &E) const
+{
+  double dot = GetLocalInterfaceElectricFieldEnergy(idx, E);
+  Mpi::GlobalSum(1, &dot, E.GetComm());
+  return dot;
+}
+
+double
+SurfacePostOperator::GetLocalInterfaceElectricFieldEnergy(int idx,
+                                                          const GridFunction &E) const
 {
   auto it = eps_surfs.find(idx);
   MFEM_VERIFY(it != eps_surfs.end(),
               "Unknown interface dielectric postprocessing index requested!");
-  auto f = it->second.GetCoefficient(E, mat_op);
-  double dot = GetLocalSurfaceIntegral(*f, it->second.attr_list);
-  Mpi::GlobalSum(1, &dot, E.GetComm());
+  const auto &data = it->second;
+  const auto &qdata = GetQuadratureData(data);
+  const int nq = static_cast<int>(qdata.w.size());
+  const int sdim = mat_op.SpaceDimension();
+  Vector Vr, Vi;
+  const double *er = InterpolateField(data, E.Real(), Vr);
+  const double *ei = E.HasImag() ? InterpolateField(data, E.Imag(), Vi) : nullptr;
+
+  // Use the neighbor element on the user specified side to compute a single-sided value for
+  // potentially discontinuous solutions on an interior boundary element. When there is no
+  // way to distinguish the sides, take the side with the larger solution (in most cases,
+  // one might be zero).
+  auto GetSide = [&](int q, const double *u)
+  {
+    const int attr1 = qdata.attr1[q], attr2 = qdata.attr2[q];
+    if (attr2 < 0)
+    {
+      return 0;
+    }
+    const double c1 = mat_op.GetLightSpeedMax(attr1), c2 = mat_op.GetLightSpeedMax(attr2);
+    if (c1 == c2)
+    {
+      double u1 = 0.0, u2 = 0.0;
+      for (int d = 0; d < sdim; d++)
+      {
+        u1 += u[q * sdim + d] * u[q * sdim + d];
+        u2 += u[(nq + q) * sdim + d] * u[(nq + q) * sdim + d];
+      }
+      return (u1 < u2) ? 1 : 0;
+    }
+    return ((data.side_n_min && c2 > c1) || (!data.side_n_min && c2 < c1)) ? 1 : 0;
+  };
+  double dot = 0.0;
+  PalacePragmaOmp(parallel for reduction(+ : dot) schedule(static))
+  for (int q = 0; q < nq; q++)
+  {
+    const double *normal = qdata.normal.data() + q * sdim;
+    const int side = GetSide(q, er);
+    const int attr = (side == 0) ? qdata.attr1[q] : qdata.attr2[q];
+    double V2 = 0.0, Vn2 = 0.0, Vt2 = 0.0;
+    for (const double *u : {er, ei})
+    {
+      if (!u)
+      {
+        continue;
+      }
+      double V[3];
+      const int side_u = (u == er) ? side : GetSide(q, u);
+      std::copy_n(u + (side_u * nq + q) * sdim, sdim, V);
+      if (data.type == InterfaceDielectricType::MS)
+      {
+        // The metal-substrate interface uses the substrate permittivity, on the side chosen
+        // for the real part.
+        double W[3];
+        mat_op.GetPermittivityReal(attr).Mult(V, W);
+        std::copy_n(W, sdim, V);
+      }
+      double Vn = 0.0;
+      for (int d = 0; d < sdim; d++)
+      {
+        V2 += V[d] * V[d];
+        Vn += V[d] * normal[d];
+      }
+      Vn2 += Vn * Vn;
+      for (int d = 0; d < sdim; d++)
+      {
+        Vt2 += (V[d] - Vn * normal[d]) * (V[d] - Vn * normal[d]);
+      }
+    }
+    double f = 0.0;
+    switch (data.type)
+    {
+      case InterfaceDielectricType::DEFAULT:
+        // No specific interface, use full field evaluation: 0.5 * t * ε * |E|² .
+        f = 0.5 * data.t * data.epsilon * V2;
+        break;
+      case InterfaceDielectricType::MA:
+        // Metal-air interface: 0.5 * t / ε_MA * |E_n|² .
+        f = 0.5 * (data.t / data.epsilon) * Vn2;
+        break;
+      case InterfaceDielectricType::MS:
+        // Metal-substrate interface: 0.5 * t / ε_MS * |(ε_S E)_n|² .
+        f = 0.5 * (data.t / data.epsilon) * Vn2;
+        break;
+      case InterfaceDielectricType::SA:
+        // Substrate-air interface: 0.5 * t * (ε_SA * |E_t|² + 1 / ε_SA * |E_n|²) .
+        f = 0.5 * data.t * ((data.epsilon * Vt2) + (Vn2 / data.epsilon));
+        break;
+    }
+    dot += qdata.w[q] * f;
+  }
   return dot;
 }
 
-double SurfacePostOperator::GetLocalSurfaceIntegral(mfem::Coefficient &f,
-                                                    const mfem::Array<int> &attr_list) const
+const SurfacePostOperator::SurfaceQuadratureData &
+SurfacePostOperator::GetQuadratureData(const SurfaceData &data) const
 {
-  // Integrate the coefficient over the boundary attributes making up this surface index.
-  const auto &mesh = *h1_fespace.GetParMesh();
-  int bdr_attr_max = mesh.bdr_attributes.Size() ? mesh.bdr_attributes.Max() : 0;
-  mfem::Array<int> attr_marker = mesh::AttrToMarker(bdr_attr_max, attr_list);
-  mfem::LinearForm s(&h1_fespace);
-  s.AddBoundaryIntegrator(new BoundaryLFIntegrator(f), attr_marker);
-  s.UseFastAssembly(false);
-  s.UseDevice(false);
-  s.Assemble();
-  s.UseDevice(true);
-  return linalg::LocalSum(s);
+  if (data.qdata)
+  {
+    return *data.qdata;
+  }
+  auto &mesh = *h1_fespace.GetParMesh();
+  mesh.ExchangeFaceNbrData();
+  const int sdim = mesh.SpaceDimension();
+  data.qdata = std::make_unique<SurfaceQuadratureData>();
+  auto &qdata = *data.qdata;
+  double normal_data[3];
+  mfem::Vector normal(normal_data, sdim), x;
+  ForAllQuadraturePoints(
+      mesh, data.attr_list,
+      [&](int, mfem::ElementTransformation &T, mfem::FaceElementTransformations &FET,
+          bool ori)
+      {
+        qdata.w.push_back(T.GetIntPoint().weight * T.Weight());
+        T.Transform(T.GetIntPoint(), x);
+        qdata.x.insert(qdata.x.end(), x.begin(), x.end());
+        BdrGridFunctionCoefficient::GetNormal(T, normal, ori);
+        qdata.normal.insert(qdata.normal.end(), normal.begin(), normal.end());
+        qdata.attr1.push_back(FET.Elem1->Attribute);
+        qdata.attr2.push_back(FET.Elem2 ? FET.Elem2->Attribute : -1);
+      });
+  return qdata;
+}
+
+const double *SurfacePostOperator::InterpolateField(const SurfaceData &data,
+                                                    const mfem::ParGridFunction &U,
+                                                    Vector &V) const
+{
+  // Construct the interpolation matrices for this finite element space on first use. The
+  // element degree of freedom transformation and orientation are applied so that the rows
+  // act directly on the local degrees of freedom of the grid function.
+  const auto &qdata = GetQuadratureData(data);
+  auto &fespace = *U.ParFESpace();
+  auto &interp = data.qdata->interp[&fespace];
+  const int nq = static_cast<int>(qdata.w.size());
+  const int sdim = mat_op.SpaceDimension();
+  if (!interp.P || interp.P->Width() != fespace.GetVSize())
+  {
+    MFEM_VERIFY(fespace.FEColl()->GetRangeType(fespace.GetMesh()->Dimension()) ==
+                    mfem::FiniteElement::VECTOR,
+                "Surface postprocessing expects a vector finite element space!");
+    fespace.ExchangeFaceNbrData();
+    const int ne = fespace.GetMesh()->GetNE();
+    interp.P = std::make_unique<mfem::SparseMatrix>(2 * nq * sdim, fespace.GetVSize());
+    interp.P_nbr =
+        std::make_unique<mfem::SparseMatrix>(2 * nq * sdim, fespace.GetFaceNbrVSize());
+    mfem::DenseMatrix vshape;
+    mfem::Vector col;
+    mfem::Array<int> vdofs;
+    ForAllQuadraturePoints(
+        *fespace.GetParMesh(), data.attr_list,
+        [&](int q, mfem::ElementTransformation &, mfem::FaceElementTransformations &FET,
+            bool)
+        {
+          for (int side = 0; side < 2; side++)
+          {
+            mfem::ElementTransformation *Te = (side == 0) ? FET.Elem1 : FET.Elem2;
+            if (!Te)
+            {
+              continue;
+            }
+            const int e = Te->ElementNo;
+            const bool nbr = (e >= ne);
+            const mfem::FiniteElement &fe =
+                nbr ? *fespace.GetFaceNbrFE(e - ne) : *fespace.GetFE(e);
+            const mfem::DofTransformation *dof_trans =
+                nbr ? fespace.GetFaceNbrElementVDofs(e - ne, vdofs)
+                    : fespace.GetElementVDofs(e, vdofs);
+            auto &P = nbr ? *interp.P_nbr : *interp.P;
+            vshape.SetSize(fe.GetDof(), sdim);
+            fe.CalcVShape(*Te, vshape);
+            for (int d = 0; d < sdim; d++)
+            {
+              vshape.GetColumnReference(d, col);
+              if (dof_trans)
+              {
+                dof_trans->TransformDual(col);
+              }
+              const int row = (side * nq + q) * sdim + d;
+              for (int j = 0; j < fe.GetDof(); j++)
+              {
+                if (vdofs[j] >= 0)
+                {
+                  P.Add(row, vdofs[j], col(j));
+                }
+                else
+                {
+                  P.Add(row, -1 - vdofs[j], -col(j));
+                }
+              }
+            }
+          }
+        });
+    interp.P->Finalize();
+    interp.P_nbr->Finalize();
+  }
+  V.SetSize(2 * nq * sdim);
+  V.UseDevice(true);
+  V = 0.0;
+  interp.P->AddMult(U, V);
+  if (interp.P_nbr->Width() > 0)
+  {
+    interp.P_nbr->AddMult(U.FaceNbrData(), V);
+  }
+  return V.HostRead();
 }
 
 }  // namespace palace
@@ -9,6 +9,7 @@
 #include <vector>
 #include <mfem.hpp>
 #include "fem/coefficient.hpp"
+#include "linalg/vector.hpp"
 
 namespace palace
 {
@@ -31,11 +32,33 @@ struct InterfaceDielectricData;
 class SurfacePostOperator
 {
 private:
+  // Surface integrals are computed by evaluating the fields at the quadrature points of the
+  // boundary elements making up the surface, on both sides for internal boundaries, using
+  // sparse interpolation matrices from the local degrees of freedom which are constructed
+  // once. The integrand is then evaluated pointwise.
+  struct SurfaceQuadratureData
+  {
+    // Quadrature weights (including the Jacobian determinant), physical coordinates, and
+    // unit normals (pointing into element 1) at each point, and the attributes of the
+    // neighboring elements (-1 for a one-sided boundary without element 2).
+    std::vector<double> w, x, normal;
+    std::vector<int> attr1, attr2;
+
+    // Interpolation matrices from the local and face neighbor degrees of freedom to the
+    // vector field values, with rows ordered by side, then point, then component.
+    struct Interpolator
+    {
+      std::unique_ptr<mfem::SparseMatrix> P, P_nbr;
+    };
+    std::map<const mfem::ParFiniteElementSpace *, Interpolator> interp;
+  };
+
   // Mapping from surface index to data structure containing surface postprocessing
   // information for surface flux or interface dielectric participation.
   struct SurfaceData
   {
     mfem::Array<int> attr_list;
+    mutable std::unique_ptr<SurfaceQuadratureData> qdata;
 
     virtual ~SurfaceData() = default;
   };
@@ -47,10 +70,6 @@ private:
 
     SurfaceFluxData(const config::SurfaceFluxData &data, const mfem::ParMesh &mesh,
                     const mfem::Array<int> &bdr_attr_marker);
-
-    std::unique_ptr<mfem::Coefficient> GetCoefficient(const mfem::ParGridFunction *E,
-                                                      const mfem::ParGridFunction *B,
-                                                      const MaterialOperator &mat_op) const;
   };
   struct InterfaceDielectricData : public SurfaceData
   {
@@ -61,20 +80,20 @@ private:
     InterfaceDielectricData(const config::InterfaceDielectricData &data,
                             const mfem::ParMesh &mesh,
                             const mfem::Array<int> &bdr_attr_marker);
-
-    std::unique_ptr<mfem::Coefficient> GetCoefficient(const GridFunction &E,
-                                                      const MaterialOperator &mat_op) const;
   };
 
   // Reference to material property operator (not owned).
   const MaterialOperator &mat_op;
 
-  // Reference to scalar finite element space used for computing surface integrals (not
-  // owned).
+  // Reference to scalar finite element space, used for access to the mesh for computing
+  // surface integrals (not owned).
   mfem::ParFiniteElementSpace &h1_fespace;
 
-  double GetLocalSurfaceIntegral(mfem::Coefficient &f,
-                                 const mfem::Array<int> &attr_list) const;
+  // Return the quadrature data for a surface, and interpolate a field to the quadrature
+  // points of the surface (returns a pointer to the values on the host).
+  const SurfaceQuadratureData &GetQuadratureData(const SurfaceData &data) const;
+  const double *InterpolateField(const SurfaceData &data, const mfem::ParGridFunction &U,
+                                 Vector &V) const;
 
 public:
   // Data structures for postprocessing the surface with the given type.
@@ -91,6 +110,12 @@ public:
   // Get surface integrals computing interface dielectric energy.
   double GetInterfaceLossTangent(int idx) const;
   double GetInterfaceElectricFieldEnergy(int idx, const GridFunction &E) const;
+
+  // Get the contributions of the local process to the above surface integrals, without the
+  // global reduction across processes.
+  std::complex<double> GetLocalSurfaceFlux(int idx, const GridFunction *E,
+                                           const GridFunction *B) const;
+  double GetLocalInterfaceElectricFieldEnergy(int idx, const GridFunction &E) const;
 };
 
 }  // namespace palace
@@ -3,14 +3,24 @@
 
 #include "timeoperator.hpp"
 
+#include <algorithm>
+#include <cmath>
+#include <fstream>
 #include <limits>
 #include <vector>
+#include "fem/errorindicator.hpp"
+#include "linalg/hypre.hpp"
 #include "linalg/iterative.hpp"
 #include "linalg/jacobi.hpp"
+#include "linalg/rap.hpp"
 #include "linalg/solver.hpp"
+#include "models/materialoperator.hpp"
 #include "models/spaceoperator.hpp"
+#include "utils/checkpoint.hpp"
 #include "utils/communication.hpp"
+#include "utils/filesystem.hpp"
 #include "utils/iodata.hpp"
+#include "utils/timer.hpp"
 
 namespace palace
 {
@@ -18,6 +28,48 @@ namespace palace
 namespace
 {
 
+// Range of step size levels k for adaptive time step control, Δt = 2ᵏ Δt₀, and number of
+// linear solvers for different step sizes kept for reuse.
+constexpr int ADAPT_LEVEL_MIN = -8;
+constexpr int ADAPT_LEVEL_MAX = 4;
+constexpr std::size_t ADAPT_KSP_CACHE = 4;
+
+int GetLevelIncrement(double ratio)
+{
+  // Change in the step size level from the usual controller Δt (0.9 (tol / err)^(1/3)),
+  // rounded down to a power of two and limited to between a quarter and double.
+  if (ratio <= 0.0)
+  {
+    return 1;
+  }
+  return std::clamp(static_cast<int>(std::floor(std::log2(0.9 / std::cbrt(ratio)))), -2,
+                    1);
+}
+
+Vector GetLumpedMatrix(const Operator &A)
+{
+  // Lumped diagonal approximation given by the row sums of the absolute values of the
+  // entries of the assembled matrix, D = diag(Σⱼ |Aᵢⱼ|). For symmetric A, D - A is
+  // diagonally dominant with nonnegative diagonal, so D ≥ A.
+  const auto *PtAP = dynamic_cast<const ParOperator *>(&A);
+  MFEM_VERIFY(PtAP, "Mass lumping requires a ParOperator matrix!");
+  return hypre::GetAbsRowSums(*PtAP->StealParallelAssemble());
+}
+
+bool IsLumpingConsistent(const mfem::ParMesh &mesh, int order)
+{
+  // Row sum lumping of the Nédélec mass matrix is equivalent to a nodal quadrature, and
+  // thus consistent, only for lowest order elements on hexahedral (quadrilateral) meshes.
+  bool consistent = (order == 1);
+  for (int e = 0; consistent && e < mesh.GetNE(); e++)
+  {
+    const auto geom = mesh.GetElementGeometry(e);
+    consistent = (geom == mfem::Geometry::CUBE || geom == mfem::Geometry::SQUARE);
+  }
+  Mpi::GlobalAnd(1, &consistent, mesh.GetComm());
+  return consistent;
+}
+
 class TimeDependentCurlCurlOperator : public mfem::SecondOrderTimeDependentOperator
 {
 public:
@@ -32,15 +84,35 @@ public:
   // returns g'(t).
   std::function<double(double)> &dJ_coef;
 
-  // Internal objects for solution of linear systems during time stepping.
+  // Internal objects for solution of linear systems during time stepping. The linear
+  // solvers for the most recently used coefficients are cached, most recent first, so that
+  // they can be reused when the time step size changes. Solvers for time step sizes which
+  // are not expected to recur use a separate entry, so they do not evict any cached ones.
+  struct SolverCacheEntry
+  {
+    double a0, a1;
+    std::unique_ptr<Operator> A, B;
+    std::unique_ptr<KspSolver> ksp;
+  };
+  std::vector<SolverCacheEntry> ksp_cache;
+  SolverCacheEntry ksp_uncached;
+  std::size_t max_ksp_cache;
+  bool use_ksp_cache;
   double a0_, a1_;
-  std::unique_ptr<KspSolver> kspM, kspA;
-  std::unique_ptr<Operator> A, B;
+  std::unique_ptr<KspSolver> kspM;
+  KspSolver *kspA;
   mutable Vector RHS;
 
+  // Lumped diagonal approximations of the mass and damping matrices for explicit time
+  // integration, and the inverse of the lumped matrix M + a1 C for the last a1.
+  Vector dM, dC;
+  mutable Vector dinv, res;
+  mutable double a1_lumped;
+  int lumped_it;
+
   // Bindings to SpaceOperator functions to get the system matrix and preconditioner, and
   // construct the linear solver.
-  std::function<void(double a0, double a1)> ConfigureLinearSolver;
+  std::function<void(SolverCacheEntry &entry)> ConfigureLinearSolver;
 
 public:
   TimeDependentCurlCurlOperator(const IoData &iodata, SpaceOperator &space_op,
@@ -48,7 +120,7 @@ public:
                                 mfem::TimeDependentOperator::Type type)
     : mfem::SecondOrderTimeDependentOperator(space_op.GetNDSpace().GetTrueVSize(), t0,
                                              type),
-      comm(space_op.GetComm()), dJ_coef(dJ_coef)
+      comm(space_op.GetComm()), dJ_coef(dJ_coef), use_ksp_cache(true), kspA(nullptr)
   {
     // Construct the system matrices defining the linear operator. PEC boundaries are
     // handled simply by setting diagonal entries of the mass matrix for the corresponding
@@ -64,7 +136,40 @@ public:
     RHS.SetSize(NegJ.Size());
     RHS.UseDevice(true);
 
-    // Set up linear solvers.
+    // For explicit time integration with mass lumping, the linear solves are replaced with
+    // the application of the inverse of the lumped matrices.
+    lumped_it = -1;
+    if (iodata.solver.transient.mass_lumping &&
+        type == mfem::TimeDependentOperator::EXPLICIT)
+    {
+      dM = GetLumpedMatrix(*M);
+      if (C)
+      {
+        dC = GetLumpedMatrix(*C);
+      }
+      dinv.SetSize(dM.Size());
+      dinv.UseDevice(true);
+      res.SetSize(dM.Size());
+      res.UseDevice(true);
+      a1_lumped = -1.0;
+      lumped_it = iodata.solver.transient.mass_lumping_it;
+      if (lumped_it == 0 &&
+          !IsLumpingConsistent(space_op.GetMesh().Get(), iodata.solver.order))
+      {
+        Mpi::Warning("Mass lumping without correction iterations is only consistent for "
+                     "first-order hexahedral meshes, and the solution may be inaccurate!\n"
+                     "Consider setting config[\"Solver\"][\"Transient\"]"
+                     "[\"MassLumpingIts\"] > 0!\n");
+      }
+      return;
+    }
+
+    // Set up linear solvers. Multiple solvers are only kept for adaptive time steps.
+    max_ksp_cache = (iodata.solver.transient.adapt_tol > 0.0 &&
+                     type == mfem::TimeDependentOperator::IMPLICIT)
+                        ? ADAPT_KSP_CACHE
+                        : 1;
+    ksp_cache.reserve(max_ksp_cache);
     {
       auto pcg = std::make_unique<CgSolver<Operator>>(comm, 0);
       pcg->SetInitialGuess(iodata.solver.linear.initial_guess);
@@ -79,20 +184,21 @@ public:
       // For explicit schemes, recommended to just use cheaper preconditioners. Otherwise,
       // use AMS or a direct solver. The system matrix is formed as a sequence of matrix
       // vector products, and is only assembled for preconditioning.
-      ConfigureLinearSolver = [this, &iodata, &space_op](double a0, double a1)
+      ConfigureLinearSolver = [this, &iodata, &space_op](SolverCacheEntry &entry)
       {
         // Configure the system matrix and also the matrix (matrices) from which the
         // preconditioner will be constructed.
-        A = space_op.GetSystemMatrix(a0, a1, 1.0, K.get(), C.get(), M.get());
-        B = space_op.GetPreconditionerMatrix<Operator>(a0, a1, 1.0, 0.0);
+        entry.A =
+            space_op.GetSystemMatrix(entry.a0, entry.a1, 1.0, K.get(), C.get(), M.get());
+        entry.B = space_op.GetPreconditionerMatrix<Operator>(entry.a0, entry.a1, 1.0, 0.0);
 
         // Configure the solver.
-        if (!kspA)
+        if (!entry.ksp)
         {
-          kspA = std::make_unique<KspSolver>(iodata, space_op.GetNDSpaces(),
-                                             &space_op.GetH1Spaces());
+          entry.ksp = std::make_unique<KspSolver>(iodata, space_op.GetNDSpaces(),
+                                                  &space_op.GetH1Spaces());
         }
-        kspA->SetOperators(*A, *B);
+        entry.ksp->SetOperators(*entry.A, *entry.B);
       };
     }
   }
@@ -108,9 +214,84 @@ public:
     linalg::AXPBYPCZ(-1.0, rhs, dJ_coef(t), NegJ, 0.0, rhs);
   }
 
+  bool IsLumped() const { return lumped_it >= 0; }
+
+  // Enable or disable adding linear solvers for new coefficients to the cache.
+  void SetUseLinearSolverCache(bool use) { use_ksp_cache = use; }
+
+  KspSolver *GetLinearSolver(const double a0, const double a1)
+  {
+    // Look up the linear solver for the given coefficients and move it to the front of the
+    // cache. If not found, the least recently used solver is reconfigured when the cache is
+    // full, otherwise a new one is constructed. When the cache is disabled, a solver which
+    // is not found is configured in the separate uncached entry instead.
+    auto it = std::find_if(ksp_cache.begin(), ksp_cache.end(), [a0, a1](const auto &entry)
+                           { return entry.a0 == a0 && entry.a1 == a1; });
+    if (it == ksp_cache.end() && !use_ksp_cache && !ksp_cache.empty())
+    {
+      if (!ksp_uncached.ksp || ksp_uncached.a0 != a0 || ksp_uncached.a1 != a1)
+      {
+        ksp_uncached.a0 = a0;
+        ksp_uncached.a1 = a1;
+        ConfigureLinearSolver(ksp_uncached);
+      }
+      return ksp_uncached.ksp.get();
+    }
+    if (it == ksp_cache.end())
+    {
+      if (ksp_cache.size() < max_ksp_cache)
+      {
+        ksp_cache.emplace_back();
+      }
+      it = std::prev(ksp_cache.end());
+      it->a0 = a0;
+      it->a1 = a1;
+      ConfigureLinearSolver(*it);
+    }
+    std::rotate(ksp_cache.begin(), it, std::next(it));
+    return ksp_cache.front().ksp.get();
+  }
+
+  void LumpedSolve(const double a1, const Vector &rhs, Vector &k) const
+  {
+    // Apply the inverse of the lumped matrix D for M + a1 C, followed by the correction
+    // iterations k += D⁻¹ (rhs - (M + a1 C) k).
+    if (a1 != a1_lumped)
+    {
+      if (C && a1 != 0.0)
+      {
+        linalg::AXPBYPCZ(1.0, dM, a1, dC, 0.0, dinv);
+      }
+      else
+      {
+        dinv = dM;
+      }
+      dinv.Reciprocal();
+      a1_lumped = a1;
+    }
+    const DiagonalOperator Dinv(dinv);
+    Dinv.Mult(rhs, k);
+    for (int it = 0; it < lumped_it; it++)
+    {
+      M->Mult(k, res);
+      if (C && a1 != 0.0)
+      {
+        C->AddMult(k, res, a1);
+      }
+      linalg::AXPBY(1.0, rhs, -1.0, res);
+      Dinv.AddMult(res, k, 1.0);
+    }
+  }
+
   void Mult(const Vector &u, const Vector &du, Vector &ddu) const override
   {
     // Solve: M ddu = -(K u + C du) - g'(t) J.
+    if (IsLumped())
+    {
+      FormRHS(u, du, RHS);
+      LumpedSolve(0.0, RHS, ddu);
+      return;
+    }
     if (kspM->NumTotalMult() == 0)
     {
       // Operators have already been set in constructor.
@@ -126,11 +307,18 @@ public:
     // Solve: (a0 K + a1 C + M) k = -(K u + C du) - g'(t) J, where a0 may be 0 in the
     // explicit case. At first iteration, construct the solver. Also don't print a newline
     // if already done by the mass matrix solve at the first iteration.
+    if (IsLumped() && a0 == 0.0)
+    {
+      FormRHS(u, du, RHS);
+      LumpedSolve(a1, RHS, k);
+      return;
+    }
     if (!kspA || a0 != a0_ || a1 != a1_)
     {
       // Configure the linear solver, including the system matrix and also the matrix
-      // (matrices) from which the preconditioner will be constructed.
-      ConfigureLinearSolver(a0, a1);
+      // (matrices) from which the preconditioner will be constructed, or reuse a cached
+      // one.
+      kspA = GetLinearSolver(a0, a1);
       a0_ = a0;
       a1_ = a1;
       k = 0.0;
@@ -141,6 +329,32 @@ public:
   }
 };
 
+// Operator applying the approximate inverse of the mass matrix used for explicit time
+// integration with mass lumping, including any correction iterations.
+class LumpedMassInverseOperator : public Operator
+{
+private:
+  const TimeDependentCurlCurlOperator &op;
+
+public:
+  LumpedMassInverseOperator(const TimeDependentCurlCurlOperator &op)
+    : Operator(op.Height()), op(op)
+  {
+  }
+
+  void Mult(const Vector &x, Vector &y) const override { op.LumpedSolve(0.0, x, y); }
+};
+
+constexpr std::uint64_t CHECKPOINT_MAGIC = 0x314e4152544c4150;  // "PALTRAN1"
+constexpr std::int64_t CHECKPOINT_VERSION = 3;
+constexpr auto CHECKPOINT_TOL = 1.0e-12;
+
+std::string GetCheckpointFilename(const std::string &path, int slot, int rank)
+{
+  return mfem::MakeParFilename(path + "/transient." + std::to_string(slot) + ".", rank,
+                               ".bin");
+}
+
 }  // namespace
 
 TimeOperator::TimeOperator(const IoData &iodata, SpaceOperator &space_op,
@@ -186,17 +400,90 @@ TimeOperator::TimeOperator(const IoData &iodata, SpaceOperator &space_op,
       break;
   }
 
+  if (iodata.solver.transient.mass_lumping &&
+      type != mfem::TimeDependentOperator::EXPLICIT)
+  {
+    Mpi::Warning("Mass lumping is only used for explicit time integration and will be "
+                 "ignored!\n");
+  }
+
+  // Adaptive time step control is only used for the implicit schemes, with step sizes
+  // relative to the configured time step.
+  adapt_tol = iodata.solver.transient.adapt_tol;
+  adapt_dt = iodata.solver.transient.delta_t;
+  adapt_t_max = iodata.solver.transient.max_t;
+  adapt_E_max = 0.0;
+  has_ddE = false;
+  if (adapt_tol > 0.0 && type != mfem::TimeDependentOperator::IMPLICIT)
+  {
+    Mpi::Warning("Adaptive time step control is only used for implicit time integration "
+                 "and will be ignored!\n");
+    adapt_tol = 0.0;
+  }
+  if (adapt_tol > 0.0)
+  {
+    for (Vector *x : {&E0, &dE0, &ddE, &ddE0})
+    {
+      x->SetSize(E.Size());
+      x->UseDevice(true);
+    }
+    B0.SetSize(B.Size());
+    B0.UseDevice(true);
+  }
+
   // Set up time-dependent operator for 2nd-order curl-curl equation for E.
   op =
       std::make_unique<TimeDependentCurlCurlOperator>(iodata, space_op, dJ_coef, 0.0, type);
+
+  // Estimate the CFL time step limit from the minimum element size and the maximum speed of
+  // light in each element, Δt ≤ min hₑ / (cₑ p² √d).
+  {
+    auto &mesh = space_op.GetNDSpace().GetParMesh();
+    const auto &mat_op = space_op.GetMaterialOp();
+    const int p = space_op.GetNDSpace().GetMaxElementOrder();
+    const double scale = p * p * std::sqrt(static_cast<double>(mesh.Dimension()));
+    dt_cfl = mfem::infinity();
+    for (int e = 0; e < mesh.GetNE(); e++)
+    {
+      const double h = mesh.GetElementSize(e, 1);  // Minimum size
+      const double c = mat_op.GetLightSpeedMax(mesh.GetAttribute(e));
+      dt_cfl = std::min(dt_cfl, h / (c * scale));
+    }
+    Mpi::GlobalMin(1, &dt_cfl, space_op.GetComm());
+  }
+
+  // Key for identifying checkpoints for this problem.
+  MPI_Comm comm = space_op.GetComm();
+  const auto &mesh = space_op.GetNDSpace().GetParMesh();
+  checkpoint_key = {};
+  checkpoint_key.magic = CHECKPOINT_MAGIC;
+  checkpoint_key.mesh_hash = checkpoint::GetMeshHash(mesh);
+  checkpoint_key.version = CHECKPOINT_VERSION;
+  checkpoint_key.size = Mpi::Size(comm);
+  checkpoint_key.rank = Mpi::Rank(comm);
+  checkpoint_key.local_size = E.Size();
+  checkpoint_key.b_size = B.Size();
+  checkpoint_key.global_size = space_op.GlobalTrueVSize();
+  checkpoint_key.num_elem = mesh.GetNE();
+  checkpoint_key.type =
+      static_cast<std::int64_t>((iodata.solver.transient.type ==
+                                 config::TransientSolverData::Type::DEFAULT)
+                                    ? config::TransientSolverData::Type::GEN_ALPHA
+                                    : iodata.solver.transient.type);
+  checkpoint_key.delta_t = iodata.solver.transient.delta_t;
+  checkpoint_slot = 0;
 }
 
-const KspSolver &TimeOperator::GetLinearSolver() const
+const KspSolver *TimeOperator::GetLinearSolver() const
 {
   const auto &curlcurl = dynamic_cast<const TimeDependentCurlCurlOperator &>(*op);
+  if (curlcurl.IsLumped())
+  {
+    return nullptr;
+  }
   MFEM_VERIFY(curlcurl.kspA,
               "No linear solver for time-depdendent operator has been constructed!\n");
-  return *curlcurl.kspA;
+  return curlcurl.kspA;
 }
 
 double TimeOperator::GetMaxTimeStep() const
@@ -206,6 +493,19 @@ double TimeOperator::GetMaxTimeStep() const
   const Operator &M = *curlcurl.M;
   const Operator &K = *curlcurl.K;
 
+  // With mass lumping, power iteration for the largest eigenvalue of P K, where P is the
+  // approximate inverse of M which is actually applied, which requires no linear solves.
+  // Without correction iterations P = D⁻¹ with the lumped mass matrix D, and the correction
+  // iterations move P towards M⁻¹, which can increase the largest eigenvalue.
+  if (curlcurl.IsLumped())
+  {
+    LumpedMassInverseOperator Minv(curlcurl);
+    ProductOperator op(Minv, K);
+    double lam = linalg::SpectralNorm(comm, op, true);
+    MFEM_VERIFY(lam > 0.0, "Error during power iteration, λ = " << lam << "!");
+    return 2.0 / std::sqrt(lam);
+  }
+
   // Solver for M⁻¹.
   constexpr double lin_tol = 1.0e-9;
   constexpr int max_lin_it = 10000;
@@ -232,9 +532,11 @@ void TimeOperator::Init()
   dE = 0.0;
   B = 0.0;
   ode->Init(*op);
+  adapt_E_max = 0.0;
+  has_ddE = false;
 }
 
-void TimeOperator::Step(double &t, double &dt)
+void TimeOperator::StepFields(double &t, double dt)
 {
   // Single time step for E-field.
   En = E;
@@ -245,4 +547,222 @@ void TimeOperator::Step(double &t, double &dt)
   Curl->AddMult(En, B, -0.5 * dt);
 }
 
+void TimeOperator::Step(double &t, double &dt)
+{
+  if (!IsAdaptive())
+  {
+    StepFields(t, dt);
+    return;
+  }
+
+  // Adaptive time step control with step sizes Δt = 2ᵏ Δt₀, so that the linear solvers for
+  // previously used step sizes can be reused. For the second-order schemes with β = 1/4,
+  // the local error is estimated as |β - 1/6| Δt² ‖aₙ₊₁ - aₙ‖ with a = d²E/dt², and is
+  // compared to the tolerance relative to the maximum norm of E so far.
+  auto &curlcurl = dynamic_cast<TimeDependentCurlCurlOperator &>(*op);
+  MPI_Comm comm = curlcurl.comm;
+  int level = std::clamp(static_cast<int>(std::lround(std::log2(dt / adapt_dt))),
+                         ADAPT_LEVEL_MIN, ADAPT_LEVEL_MAX);
+  if (!has_ddE)
+  {
+    op->SetTime(t);
+    op->Mult(E, dE, ddE);
+    adapt_E_max = std::max(adapt_E_max, linalg::Norml2(comm, E));
+  }
+
+  // Save the state at the start of the step, in case it is rejected.
+  E0 = E;
+  dE0 = dE;
+  B0 = B;
+  ddE0 = ddE;
+  state0.resize(ode->GetStateSize());
+  for (std::size_t i = 0; i < state0.size(); i++)
+  {
+    state0[i] = ode->GetStateVector(i);
+  }
+  while (true)
+  {
+    // The last step is shortened to end exactly at the final time. Its step size is not on
+    // the grid of step sizes, so its linear solver is not cached.
+    double ts = t;
+    const double dts = std::min(std::ldexp(adapt_dt, level), adapt_t_max - t);
+    curlcurl.SetUseLinearSolverCache(dts == std::ldexp(adapt_dt, level));
+    StepFields(ts, dts);
+    curlcurl.SetUseLinearSolverCache(true);
+    if (ode->GetStateSize() > 0)
+    {
+      ddE = ode->GetStateVector(0);
+    }
+    else
+    {
+      op->SetTime(ts);
+      op->Mult(E, dE, ddE);
+    }
+    linalg::AXPBYPCZ(1.0, ddE, -1.0, ddE0, 0.0, En);
+    const double err = (1.0 / 12.0) * dts * dts * linalg::Norml2(comm, En);
+    const double E_max = std::max(adapt_E_max, linalg::Norml2(comm, E));
+    const double ratio = (E_max > 0.0) ? err / (adapt_tol * E_max) : 0.0;
+    if (ratio <= 1.0 || level == ADAPT_LEVEL_MIN)
+    {
+      // Accept the step and choose the next step size.
+      if (ratio > 1.0)
+      {
+        Mpi::Warning(comm,
+                     "Estimated time step error exceeds the tolerance at the minimum time "
+                     "step size (ratio = {:.3e})!\n",
+                     ratio);
+      }
+      t = ts;
+      dt = std::ldexp(adapt_dt, std::clamp(level + GetLevelIncrement(ratio),
+                                           ADAPT_LEVEL_MIN, ADAPT_LEVEL_MAX));
+      adapt_E_max = E_max;
+      has_ddE = true;
+      return;
+    }
+
+    // Reject the step, restore the state, and retry with a smaller step size.
+    const int dec = std::min(GetLevelIncrement(ratio), -1);
+    Mpi::Print(comm,
+               " Rejected time step with estimated error ratio {:.3e}, reducing time step "
+               "by a factor of {:d}\n",
+               ratio, 1 << -dec);
+    level = std::max(level + dec, ADAPT_LEVEL_MIN);
+    E = E0;
+    dE = dE0;
+    B = B0;
+    ode->Init(*op);
+    for (std::size_t i = 0; i < state0.size(); i++)
+    {
+      ode->SetStateVector(static_cast<int>(i), state0[i]);
+    }
+  }
+}
+
+void TimeOperator::SaveCheckpoint(const std::string &path, int step, double t, double dt,
+                                  const ErrorIndicator &indicator,
+                                  const std::map<std::string, std::int64_t> &outputs)
+{
+  // Each process writes its local part of the solution vectors and time integrator state
+  // to its own file. The magic number is repeated at the end of the file to mark a
+  // completely written checkpoint.
+  BlockTimer bt(Timer::IO);
+  const auto &curlcurl = dynamic_cast<const TimeDependentCurlCurlOperator &>(*op);
+  MPI_Comm comm = curlcurl.comm;
+  if (Mpi::Root(comm) && !std::filesystem::exists(path))
+  {
+    std::filesystem::create_directories(path);
+  }
+  Mpi::Barrier(comm);
+  auto header = checkpoint_key;
+  header.step = step;
+  header.num_state = ode->GetStateSize();
+  header.indicator_samples =
+      (indicator.Local().Size() == header.num_elem) ? indicator.Samples() : 0;
+  header.num_outputs = static_cast<std::int64_t>(outputs.size());
+  header.t = t;
+  header.dt = dt;
+  header.E_max = adapt_E_max;
+  const std::string filename =
+      GetCheckpointFilename(path, checkpoint_slot, Mpi::Rank(comm));
+  std::vector<const mfem::Vector *> state(header.num_state);
+  for (int i = 0; i < header.num_state; i++)
+  {
+    state[i] = &ode->GetStateVector(i);
+  }
+  std::ofstream fo(filename, std::ios::binary);
+  checkpoint::WriteTransient(fo, header, E, dE, B, state, indicator.Local(), outputs);
+  fo.close();
+  bool good = fo.good();
+  Mpi::GlobalAnd(1, &good, comm);
+  MFEM_VERIFY(good, "Failed to write transient checkpoint to " << path << "!");
+  checkpoint_slot = 1 - checkpoint_slot;
+}
+
+bool TimeOperator::LoadCheckpoint(const std::string &path, int &step, double &t,
+                                  double &dt, ErrorIndicator &indicator,
+                                  std::map<std::string, std::int64_t> &outputs)
+{
+  // Check the headers for both checkpoint slots, and then try to read the slot with the
+  // most recent step which is valid for this problem on every process. A checkpoint is only
+  // used if it has been completely written by all processes, otherwise the older one is
+  // used.
+  BlockTimer bt(Timer::IO);
+  const auto &curlcurl = dynamic_cast<const TimeDependentCurlCurlOperator &>(*op);
+  MPI_Comm comm = curlcurl.comm;
+  checkpoint::TransientHeader headers[2] = {};
+  bool valid[2] = {false, false};
+  long long int steps[4] = {-1, -1, -1, -1};
+  for (int slot = 0; slot < 2; slot++)
+  {
+    std::ifstream fi(GetCheckpointFilename(path, slot, Mpi::Rank(comm)), std::ios::binary);
+    if (!fi.good())
+    {
+      continue;
+    }
+    const auto &key = checkpoint_key;
+    auto &header = headers[slot];
+    checkpoint::ReadBinary(fi, &header, 1);
+    valid[slot] = fi.good() && header.magic == key.magic && header.version == key.version &&
+                  header.mesh_hash == key.mesh_hash && header.size == key.size &&
+                  header.rank == key.rank && header.local_size == key.local_size &&
+                  header.b_size == key.b_size && header.global_size == key.global_size &&
+                  header.num_elem == key.num_elem && header.type == key.type &&
+                  std::abs(header.delta_t - key.delta_t) <= CHECKPOINT_TOL * key.delta_t &&
+                  header.step >= 0;
+    steps[slot] = steps[slot + 2] = valid[slot] ? header.step : -1;
+  }
+  Mpi::GlobalAnd(2, valid, comm);
+  Mpi::GlobalMin(2, steps, comm);
+  Mpi::GlobalMax(2, steps + 2, comm);
+  for (int slot = 0; slot < 2; slot++)
+  {
+    valid[slot] = valid[slot] && (steps[slot] == steps[slot + 2]);
+  }
+  int order[2] = {0, 1};
+  if (steps[1] > steps[0])
+  {
+    std::swap(order[0], order[1]);
+  }
+  for (int slot : order)
+  {
+    if (!valid[slot])
+    {
+      continue;
+    }
+    const auto &header = headers[slot];
+    std::ifstream fi(GetCheckpointFilename(path, slot, Mpi::Rank(comm)), std::ios::binary);
+    fi.seekg(sizeof(checkpoint::TransientHeader));
+    checkpoint::TransientData data;
+    bool good = checkpoint::ReadTransient(fi, header, data);
+    Mpi::GlobalAnd(1, &good, comm);
+    if (!good)
+    {
+      continue;
+    }
+
+    // Initialize the time integrator and then restore its state.
+    ode->Init(*op);
+    E = data.E;
+    dE = data.dE;
+    B = data.B;
+    for (int i = 0; i < header.num_state; i++)
+    {
+      ode->SetStateVector(i, data.state[i]);
+    }
+    if (header.indicator_samples > 0)
+    {
+      indicator = ErrorIndicator(std::move(data.indicator), header.indicator_samples);
+    }
+    outputs = std::move(data.outputs);
+    adapt_E_max = header.E_max;
+    has_ddE = false;
+    step = header.step;
+    t = header.t;
+    dt = header.dt;
+    checkpoint_slot = 1 - slot;
+    return true;
+  }
+  return false;
+}
+
 }  // namespace palace
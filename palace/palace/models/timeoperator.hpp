@@ -4,16 +4,22 @@
 #ifndef PALACE_MODELS_TIME_OPERATOR_HPP
 #define PALACE_MODELS_TIME_OPERATOR_HPP
 
+#include <cstdint>
 #include <functional>
+#include <map>
 #include <memory>
+#include <string>
+#include <vector>
 #include <mfem.hpp>
 #include "linalg/ksp.hpp"
 #include "linalg/operator.hpp"
 #include "linalg/vector.hpp"
+#include "utils/checkpoint.hpp"
 
 namespace palace
 {
 
+class ErrorIndicator;
 class IoData;
 class SpaceOperator;
 
@@ -35,6 +41,27 @@ private:
   // Discrete curl for B-field time integration (not owned).
   const Operator *Curl;
 
+  // Estimate of the CFL time step limit from the mesh and material properties.
+  double dt_cfl;
+
+  // Adaptive time step control: relative tolerance for the local error estimate (zero for
+  // uniform time steps), reference time step size, final time, and maximum norm of E so
+  // far. The second time derivative of E at the end of the last step is kept for the
+  // error estimate, and the solution and time integrator state at the start of a step are
+  // restored if the step is rejected.
+  double adapt_tol, adapt_dt, adapt_t_max, adapt_E_max;
+  bool has_ddE;
+  Vector ddE, E0, dE0, B0, ddE0;
+  std::vector<mfem::Vector> state0;
+
+  // Header identifying checkpoints for this problem. Checkpoints alternate between two
+  // slots so that the previous one remains valid if writing a checkpoint is interrupted.
+  checkpoint::TransientHeader checkpoint_key;
+  int checkpoint_slot;
+
+  // Advance the E- and B-fields by a single time step from t -> t + dt.
+  void StepFields(double &t, double dt);
+
 public:
   TimeOperator(const IoData &iodata, SpaceOperator &space_op,
                std::function<double(double)> &dJ_coef);
@@ -44,21 +71,46 @@ public:
   const Vector &GetEdot() const { return dE; }
   const Vector &GetB() const { return B; }
 
-  // Return the linear solver associated with the implicit or explicit time integrator.
-  const KspSolver &GetLinearSolver() const;
+  // Return the linear solver associated with the implicit or explicit time integrator. May
+  // be nullptr for explicit time integration with mass lumping.
+  const KspSolver *GetLinearSolver() const;
 
   // Return if the time integration scheme explicit or implicit.
   bool isExplicit() const { return op->isExplicit(); }
 
+  // Return if the time step size is adaptively controlled.
+  bool IsAdaptive() const { return adapt_tol > 0.0; }
+
   // Estimate the maximum stable time step based on the maximum eigenvalue of the
-  // undamped system matrix M⁻¹ K.
+  // undamped system matrix M⁻¹ K, with M⁻¹ replaced by the approximate inverse applied
+  // with mass lumping.
   double GetMaxTimeStep() const;
 
+  // Return an a priori estimate of the CFL time step limit for explicit time integration,
+  // based on the element sizes and the maximum speed of light in each element.
+  double GetCFLTimeStep() const { return dt_cfl; }
+
   // Initialize time integrators and set 0 initial conditions.
   void Init();
 
-  // Perform time step from t -> t + dt.
+  // Perform time step from t -> t + dt. With adaptive time step control, t is advanced by
+  // the accepted step size, which may be smaller than dt and never passes the final time,
+  // and dt is updated to the step size for the next step.
   void Step(double &t, double &dt);
+
+  // Save the solution vectors and time integrator state after the given step, along with
+  // the error indicator and sizes of postprocessing output files to truncate to on restart,
+  // to a binary checkpoint with one file per process in the given directory.
+  void SaveCheckpoint(const std::string &path, int step, double t, double dt,
+                      const ErrorIndicator &indicator,
+                      const std::map<std::string, std::int64_t> &outputs);
+
+  // Initialize the time integration from the most recent valid checkpoint in the given
+  // directory, returning false if there is none. The checkpoint must have been written for
+  // the same mesh, partitioning, and time integration scheme and configured time step.
+  bool LoadCheckpoint(const std::string &path, int &step, double &t, double &dt,
+                      ErrorIndicator &indicator,
+                      std::map<std::string, std::int64_t> &outputs);
 };
 
 }  // namespace palace
@@ -3,10 +3,13 @@
 
 #include "waveportoperator.hpp"
 
+#include <algorithm>
+#include <iterator>
 #include <tuple>
 #include "fem/bilinearform.hpp"
 #include "fem/coefficient.hpp"
 #include "fem/integrator.hpp"
+#include "fem/surfacepower.hpp"
 #include "linalg/arpack.hpp"
 #include "linalg/iterative.hpp"
 #include "linalg/mumps.hpp"
@@ -516,6 +519,161 @@ public:
 
 }  // namespace
 
+std::size_t WavePortModeCache::FindInterval(double omega) const
+{
+  if (entries.size() < 2 || omega < entries.front().omega || omega > entries.back().omega)
+  {
+    return entries.size();
+  }
+  std::size_t k = 0;
+  while (k + 2 < entries.size() && entries[k + 1].omega <= omega)
+  {
+    k++;
+  }
+  return k;
+}
+
+bool WavePortModeCache::CanBisect(std::size_t k) const
+{
+  // Limit the minimum interval width, beyond which the eigenvalue problem is solved
+  // directly without adding anchors.
+  constexpr double min_width = 1.0e-6;
+  const double wa = entries[k].omega, wb = entries[k + 1].omega;
+  return wb - wa >= min_width * wb;
+}
+
+std::complex<double> WavePortModeCache::Interpolate(std::size_t k, double omega,
+                                                    ComplexVector &e) const
+{
+  // Interpolate linearly in ω² between the anchors k and k + 1: kₙ² is exactly linear in
+  // ω² for homogeneously filled ports, and the mode shape varies slowly with frequency.
+  const auto &a = entries[k], &b = entries[k + 1];
+  const double t =
+      (omega * omega - a.omega * a.omega) / (b.omega * b.omega - a.omega * a.omega);
+  e.AXPBYPCZ(1.0 - t, a.e, t, b.e, 0.0);
+  linalg::Normalize(comm, e);
+  return std::sqrt((1.0 - t) * a.kn * a.kn + t * b.kn * b.kn);
+}
+
+double WavePortModeCache::GetSolveFrequency(double omega) const
+{
+  // Solves are required at the ends of the frequency range, outside of the range of the
+  // anchors, and at the midpoint of the anchor interval containing the frequency until the
+  // interpolation error on the interval has been verified.
+  if (!Enabled())
+  {
+    return omega;
+  }
+  for (const auto &entry : entries)
+  {
+    if (entry.omega == omega)
+    {
+      return 0.0;
+    }
+  }
+  if (omega_min < omega_max && omega >= omega_min && omega <= omega_max)
+  {
+    if (entries.empty() || entries.front().omega > omega_min)
+    {
+      return omega_min;
+    }
+    if (entries.back().omega < omega_max)
+    {
+      return omega_max;
+    }
+  }
+  const auto k = FindInterval(omega);
+  if (k == entries.size())
+  {
+    return omega;
+  }
+  if (entries[k].verified)
+  {
+    return 0.0;
+  }
+  return CanBisect(k) ? 0.5 * (entries[k].omega + entries[k + 1].omega) : omega;
+}
+
+void WavePortModeCache::Insert(double omega, std::complex<double> kn,
+                               const ComplexVector &e)
+{
+  // Add the solution to the cache, with phase consistent with its neighbor (eigenvectors
+  // are only unique up to a complex scaling). A solution at the midpoint of an unverified
+  // interval is used to estimate the interpolation error on the interval. Interpolation
+  // error for the two halves of a verified interval is then smaller still.
+  auto AlignPhase = [this](const ComplexVector &ref, ComplexVector &x)
+  {
+    const auto dot = linalg::Dot(comm, x, ref);
+    if (std::abs(dot) > 0.0)
+    {
+      x *= std::conj(dot) / std::abs(dot);
+    }
+  };
+  const auto k = FindInterval(omega);
+  const bool bisect = (k < entries.size());
+  Entry entry{omega, kn, e, false};
+  if (bisect)
+  {
+    if (!CanBisect(k))
+    {
+      return;
+    }
+    ComplexVector e_interp(e.Size());
+    e_interp.UseDevice(true);
+    const auto kn_interp = Interpolate(k, omega, e_interp);
+    AlignPhase(e_interp, entry.e);
+    linalg::AXPY(-1.0, entry.e, e_interp);
+    const double err = std::max(std::abs(kn - kn_interp) / std::abs(kn),
+                                linalg::Norml2(comm, e_interp));
+    entry.verified = (err <= tol);
+    entries[k].verified = entry.verified;
+  }
+  auto it = std::lower_bound(entries.begin(), entries.end(), omega,
+                             [](const Entry &x, double val) { return x.omega < val; });
+  it = entries.insert(it, std::move(entry));
+  if (it != entries.begin())
+  {
+    AlignPhase(std::prev(it)->e, it->e);
+    std::prev(it)->verified = it->verified;
+  }
+  else if (std::next(it) != entries.end())
+  {
+    AlignPhase(std::next(it)->e, it->e);
+  }
+
+  // Limit the size of the cache by evicting the interior anchors farthest from the new
+  // one, which merges the neighboring intervals. The anchors at the ends are kept so that
+  // the range of frequencies served by interpolation does not shrink.
+  while (entries.size() > max_size)
+  {
+    std::size_t j = 1;
+    for (std::size_t i = 2; i + 1 < entries.size(); i++)
+    {
+      if (std::abs(entries[i].omega - omega) > std::abs(entries[j].omega - omega))
+      {
+        j = i;
+      }
+    }
+    entries[j - 1].verified = false;
+    entries.erase(entries.begin() + j);
+  }
+}
+
+std::complex<double> WavePortModeCache::GetMode(double omega, ComplexVector &e) const
+{
+  auto it = std::find_if(entries.begin(), entries.end(),
+                         [omega](const Entry &entry) { return entry.omega == omega; });
+  if (it != entries.end())
+  {
+    e = it->e;
+    return it->kn;
+  }
+  const auto k = FindInterval(omega);
+  MFEM_VERIFY(k < entries.size(),
+              "Wave port boundary mode is not available for ω = " << omega << "!");
+  return Interpolate(k, omega, e);
+}
+
 WavePortData::WavePortData(const config::WavePortData &data,
                            const config::SolverData &solver, const MaterialOperator &mat_op,
                            mfem::ParFiniteElementSpace &nd_fespace,
@@ -529,6 +687,9 @@ WavePortData::WavePortData(const config::WavePortData &data,
   active = data.active;
   kn0 = 0.0;
   omega0 = 0.0;
+  omega_A = omega_solve = 0.0;
+  lambda_solve = kn_solve = 0.0;
+  has_e_solve = false;
 
   // Construct the SubMesh.
   MFEM_VERIFY(!data.attributes.empty(), "Wave port boundary found with no attributes!");
@@ -536,6 +697,7 @@ WavePortData::WavePortData(const config::WavePortData &data,
   attr_list.Append(data.attributes.data(), data.attributes.size());
   port_mesh = std::make_unique<Mesh>(std::make_unique<mfem::ParSubMesh>(
       mfem::ParSubMesh::CreateFromBoundary(mesh, attr_list)));
+  mode_cache = WavePortModeCache(port_mesh->GetComm(), data.mode_tol);
   port_normal = mesh::GetSurfaceNormal(*port_mesh);
 
   port_nd_fec = std::make_unique<mfem::ND_FECollection>(nd_fespace.GetMaxElementOrder(),
@@ -588,6 +750,8 @@ WavePortData::WavePortData(const config::WavePortData &data,
   GetInitialSpace(*port_nd_fespace, *port_h1_fespace, port_dbc_tdof_list, v0);
   e0.SetSize(port_nd_fespace->GetTrueVSize() + port_h1_fespace->GetTrueVSize());
   e0.UseDevice(true);
+  e_solve.SetSize(e0.Size());
+  e_solve.UseDevice(true);
 
   // The operators for the generalized eigenvalue problem are:
   //                [Aₜₜ  Aₜₙ] [eₜ] = -kₙ² [Bₜₜ  0ₜₙ] [eₜ]
@@ -841,62 +1005,103 @@ WavePortData::~WavePortData()
   }
 }
 
-void WavePortData::Initialize(double omega)
+double WavePortData::GetSolveFrequency(double omega) const
 {
-  if (omega == omega0)
+  // Without the mode cache, the eigenvalue problem is solved at every frequency.
+  if (omega == omega0 || omega == omega_solve)
   {
-    return;
+    return 0.0;
   }
+  return mode_cache.GetSolveFrequency(omega);
+}
 
-  // Construct matrices and solve the generalized eigenvalue problem for the desired wave
-  // port mode. The B matrix is operating frequency-independent and has already been
+void WavePortData::AssembleMode(double omega)
+{
+  // Construct matrices for the generalized eigenvalue problem for the desired wave port
+  // mode. The B matrix is operating frequency-independent and has already been
   // constructed.
-  std::unique_ptr<ComplexOperator> opA;
   const double sigma = -omega * omega * mu_eps_min;
-  {
-    auto [Attr, Atti] = GetAtt(mat_op, *port_nd_fespace, port_normal, omega, sigma);
-    auto [Ar, Ai] =
-        GetSystemMatrixA(Attr.get(), Atti.get(), Atnr.get(), Atni.get(), Antr.get(),
-                         Anti.get(), Annr.get(), Anni.get(), port_dbc_tdof_list);
-    opA = std::make_unique<ComplexWrapperOperator>(std::move(Ar), std::move(Ai));
-  }
+  auto [Attr, Atti] = GetAtt(mat_op, *port_nd_fespace, port_normal, omega, sigma);
+  auto [Ar, Ai] = GetSystemMatrixA(Attr.get(), Atti.get(), Atnr.get(), Atni.get(),
+                                   Antr.get(), Anti.get(), Annr.get(), Anni.get(),
+                                   port_dbc_tdof_list);
+  opA = std::make_unique<ComplexWrapperOperator>(std::move(Ar), std::move(Ai));
+  omega_A = omega;
+}
 
+void WavePortData::SolveMode()
+{
   // Configure and solve the (inverse) eigenvalue problem for the desired boundary mode.
   // Linear solves are preconditioned with the real part of the system matrix (ignore loss
-  // tangent).
-  std::complex<double> lambda;
+  // tangent). The eigenvalue solver is started from the previous mode solution if
+  // available, which reduces the number of iterations required. This involves only the
+  // processes with elements for this port.
+  MFEM_VERIFY(opA, "Wave port boundary mode system matrix has not been assembled!");
   if (port_comm != MPI_COMM_NULL)
   {
     ComplexWrapperOperator opP(opA->Real(), nullptr);  // Non-owning constructor
     ksp->SetOperators(*opA, opP);
     eigen->SetOperators(*opB, *opA, EigenvalueSolver::ScaleType::NONE);
-    eigen->SetInitialSpace(v0);
+    eigen->SetInitialSpace(has_e_solve ? e_solve : v0);
     int num_conv = eigen->Solve();
     MFEM_VERIFY(num_conv >= mode_idx, "Wave port eigensolver did not converge!");
-    lambda = eigen->GetEigenvalue(mode_idx - 1);
+    lambda_solve = eigen->GetEigenvalue(mode_idx - 1);
     // Mpi::Print(port_comm, " ... Wave port eigensolver error = {} (bkwd), {} (abs)\n",
     //            eigen->GetError(mode_idx - 1, EigenvalueSolver::ErrorType::BACKWARD),
     //            eigen->GetError(mode_idx - 1, EigenvalueSolver::ErrorType::ABSOLUTE));
+    eigen->GetEigenvector(mode_idx - 1, e_solve);
   }
-  Mpi::Broadcast(1, &lambda, port_root, port_mesh->GetComm());
+  else
+  {
+    MFEM_ASSERT(e_solve.Size() == 0,
+                "Unexpected non-empty port FE space in wave port boundary mode solve!");
+  }
+}
 
-  // Extract the eigenmode solution and postprocess. The extracted eigenvalue is λ =
+void WavePortData::UpdateMode()
+{
+  // Communicate the eigenvalue from the port processes. The extracted eigenvalue is λ =
   // 1 / (-kₙ² - σ).
-  kn0 = std::sqrt(-sigma - 1.0 / lambda);
+  MPI_Comm comm = port_mesh->GetComm();
+  Mpi::Broadcast(1, &lambda_solve, port_root, comm);
+  const double sigma = -omega_A * omega_A * mu_eps_min;
+  kn_solve = std::sqrt(-sigma - 1.0 / lambda_solve);
+  omega_solve = omega_A;
+  linalg::Normalize(comm, e_solve);
+  has_e_solve = true;
+  opA.reset();
+  if (mode_cache.Enabled())
+  {
+    mode_cache.Insert(omega_solve, kn_solve, e_solve);
+  }
+}
+
+void WavePortData::Initialize(double omega)
+{
+  if (omega == omega0)
+  {
+    return;
+  }
+  MFEM_VERIFY(GetSolveFrequency(omega) == 0.0,
+              "Wave port boundary mode eigenvalue problem has not been solved for ω = "
+                  << omega << "!");
+
+  // Set the boundary mode from the eigenvalue problem solution at this frequency, or by
+  // interpolation from the mode cache.
+  if (omega == omega_solve)
+  {
+    kn0 = kn_solve;
+    e0 = e_solve;
+  }
+  else
+  {
+    kn0 = mode_cache.GetMode(omega, e0);
+  }
   omega0 = omega;
 
   // Separate the computed field out into eₜ and eₙ and and transform back to true
   // electric field variables: Eₜ = eₜ and Eₙ = eₙ / ikₙ.
   {
-    if (port_comm != MPI_COMM_NULL)
-    {
-      eigen->GetEigenvector(mode_idx - 1, e0);
-    }
-    else
-    {
-      MFEM_ASSERT(e0.Size() == 0,
-                  "Unexpected non-empty port FE space in wave port boundary mode solve!");
-    }
     e0.Real().Read();  // Ensure memory is allocated on device before aliasing
     e0.Imag().Read();
     Vector e0tr(e0.Real(), 0, port_nd_fespace->GetTrueVSize());
@@ -989,45 +1194,37 @@ double WavePortData::GetExcitationPower() const
 }
 
 std::complex<double> WavePortData::GetPower(GridFunction &E, GridFunction &B) const
+{
+  std::complex<double> dot = GetLocalPower(E, B);
+  Mpi::GlobalSum(1, &dot, E.GetComm());
+  return dot;
+}
+
+std::complex<double> WavePortData::GetSParameter(GridFunction &E) const
+{
+  std::complex<double> dot = GetLocalSParameter(E);
+  Mpi::GlobalSum(1, &dot, port_nd_fespace->GetComm());
+  return dot;
+}
+
+std::complex<double> WavePortData::GetLocalPower(GridFunction &E, GridFunction &B) const
 {
   // Compute port power, (E x H) ⋅ n = E ⋅ (-n x H), integrated over the port surface using
   // the computed E and H = μ⁻¹ B fields, where +n is the direction of propagation (into the
-  // domain). The BdrSurfaceCurrentVectorCoefficient computes -n x H for an outward normal,
-  // so we multiply by -1. The linear form is reconstructed from scratch each time due to
-  // changing H.
+  // domain). The boundary coupling operator is assembled once and reused for every new E
+  // and B.
   MFEM_VERIFY(E.HasImag() && B.HasImag(),
               "Wave ports expect complex-valued E and B fields in port power "
               "calculation!");
-  auto &nd_fespace = *E.ParFESpace();
-  const auto &mesh = *nd_fespace.GetParMesh();
-  BdrSurfaceCurrentVectorCoefficient nxHr_func(B.Real(), mat_op);
-  BdrSurfaceCurrentVectorCoefficient nxHi_func(B.Imag(), mat_op);
-  int bdr_attr_max = mesh.bdr_attributes.Size() ? mesh.bdr_attributes.Max() : 0;
-  mfem::Array<int> attr_marker = mesh::AttrToMarker(bdr_attr_max, attr_list);
-  std::complex<double> dot;
+  if (!port_power)
   {
-    mfem::LinearForm pr(&nd_fespace);
-    pr.AddBoundaryIntegrator(new VectorFEBoundaryLFIntegrator(nxHr_func), attr_marker);
-    pr.UseFastAssembly(false);
-    pr.UseDevice(false);
-    pr.Assemble();
-    pr.UseDevice(true);
-    dot = -(pr * E.Real()) - 1i * (pr * E.Imag());
+    port_power = std::make_unique<SurfacePowerOperator>(*E.ParFESpace(), *B.ParFESpace(),
+                                                        mat_op, attr_list);
   }
-  {
-    mfem::LinearForm pi(&nd_fespace);
-    pi.AddBoundaryIntegrator(new VectorFEBoundaryLFIntegrator(nxHi_func), attr_marker);
-    pi.UseFastAssembly(false);
-    pi.UseDevice(false);
-    pi.Assemble();
-    pi.UseDevice(true);
-    dot += -(pi * E.Imag()) + 1i * (pi * E.Real());
-  }
-  Mpi::GlobalSum(1, &dot, nd_fespace.GetComm());
-  return dot;
+  return port_power->GetLocalPower(E, B);
 }
 
-std::complex<double> WavePortData::GetSParameter(GridFunction &E) const
+std::complex<double> WavePortData::GetLocalSParameter(GridFunction &E) const
 {
   // Compute port S-parameter, or the projection of the field onto the port mode:
   // (E x H_inc⋆) ⋅ n = E ⋅ (-n x H_inc⋆), integrated over the port surface.
@@ -1038,7 +1235,6 @@ std::complex<double> WavePortData::GetSParameter(GridFunction &E) const
   port_nd_transfer->Transfer(E.Imag(), port_E->Imag());
   std::complex<double> dot(-((*port_sr) * port_E->Real()) - ((*port_si) * port_E->Imag()),
                            -((*port_sr) * port_E->Imag()) + ((*port_si) * port_E->Real()));
-  Mpi::GlobalSum(1, &dot, port_nd_fespace->GetComm());
   return dot;
 }
 
@@ -1054,6 +1250,21 @@ WavePortOperator::WavePortOperator(const IoData &iodata, const MaterialOperator
               "Mesh mismatch in WavePortOperator FE spaces!");
   SetUpBoundaryProperties(iodata, mat_op, nd_fespace, h1_fespace);
   PrintBoundaryInfo(iodata, *nd_fespace.GetParMesh());
+
+  // Balance the boundary mode eigenvalue problem solves by solving the largest port
+  // problems first, since the solves for ports on disjoint process groups can overlap.
+  std::vector<std::pair<HYPRE_BigInt, int>> sizes;
+  for (const auto &[idx, data] : ports)
+  {
+    sizes.emplace_back(data.GlobalTrueNDSize() + data.GlobalTrueH1Size(), idx);
+  }
+  std::sort(sizes.begin(), sizes.end(),
+            [](const auto &a, const auto &b)
+            { return a.first > b.first || (a.first == b.first && a.second < b.second); });
+  for (const auto &[size, idx] : sizes)
+  {
+    solve_order.push_back(idx);
+  }
 }
 
 void WavePortOperator::SetUpBoundaryProperties(const IoData &iodata,
@@ -1256,6 +1467,44 @@ void WavePortOperator::Initialize(double omega)
         "\nCalculating boundary modes at wave ports for ω/2π = {:.3e} GHz ({:.3e})\n",
         omega * fc, omega);
   }
+
+  // Solve the boundary mode eigenvalue problems for all ports. The system matrices are
+  // assembled collectively, and then each eigenvalue problem is solved only by the
+  // processes with elements for the port, so the solves for ports on disjoint process
+  // groups run concurrently. All processes loop over the ports in the same order (largest
+  // first) so that processes shared between ports do not deadlock.
+  while (true)
+  {
+    std::map<int, double> solves;
+    for (const auto &[idx, data] : ports)
+    {
+      const double omega_solve = data.GetSolveFrequency(omega);
+      if (omega_solve > 0.0)
+      {
+        solves.emplace(idx, omega_solve);
+      }
+    }
+    if (solves.empty())
+    {
+      break;
+    }
+    for (const auto &[idx, omega_solve] : solves)
+    {
+      ports.at(idx).AssembleMode(omega_solve);
+    }
+    for (auto idx : solve_order)
+    {
+      if (solves.find(idx) != solves.end())
+      {
+        ports.at(idx).SolveMode();
+      }
+    }
+    for (const auto &[idx, omega_solve] : solves)
+    {
+      ports.at(idx).UpdateMode();
+    }
+  }
+
   for (auto &[idx, data] : ports)
   {
     data.Initialize(omega);
@@ -1303,18 +1552,28 @@ void WavePortOperator::AddExtraSystemBdrCoefficients(double omega,
 void WavePortOperator::AddExcitationBdrCoefficients(double omega, SumVectorCoefficient &fbr,
                                                     SumVectorCoefficient &fbi)
 {
-  // Re/Im{-U_inc} = Re/Im{+2 (-iω) n x H_inc}, which is a function of E_inc as computed by
-  // the modal solution (stored as a grid function and coefficient during initialization).
-  Initialize(omega);
   for (const auto &[idx, data] : ports)
   {
     if (!data.excitation)
     {
       continue;
     }
-    fbr.AddCoefficient(data.GetModeExcitationCoefficientImag(), 2.0 * omega);
-    fbi.AddCoefficient(data.GetModeExcitationCoefficientReal(), -2.0 * omega);
+    AddExcitationBdrCoefficients(idx, omega, fbr, fbi);
   }
 }
 
+void WavePortOperator::AddExcitationBdrCoefficients(int idx, double omega,
+                                                    SumVectorCoefficient &fbr,
+                                                    SumVectorCoefficient &fbi)
+{
+  // Re/Im{-U_inc} = Re/Im{+2 (-iω) n x H_inc}, which is a function of E_inc as computed by
+  // the modal solution (stored as a grid function and coefficient during initialization).
+  Initialize(omega);
+  const WavePortData &data = GetPort(idx);
+  MFEM_VERIFY(data.excitation,
+              "Wave port index " << idx << " is not marked for excitation!");
+  fbr.AddCoefficient(data.GetModeExcitationCoefficientImag(), 2.0 * omega);
+  fbi.AddCoefficient(data.GetModeExcitationCoefficientReal(), -2.0 * omega);
+}
+
 }  // namespace palace
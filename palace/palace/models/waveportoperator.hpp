@@ -8,6 +8,7 @@
 #include <map>
 #include <memory>
 #include <unordered_map>
+#include <vector>
 #include <mfem.hpp>
 #include "fem/fespace.hpp"
 #include "fem/gridfunction.hpp"
@@ -24,6 +25,7 @@ class IoData;
 class MaterialOperator;
 class MaterialPropertyCoefficient;
 class SumVectorCoefficient;
+class SurfacePowerOperator;
 
 namespace config
 {
@@ -33,6 +35,68 @@ struct SolverData;
 
 }  // namespace config
 
+//
+// Cache of wave port boundary mode solutions (propagation constant and eigenvector,
+// normalized and with consistent phase) at anchor frequencies, sorted by frequency. The
+// mode at intermediate frequencies is interpolated between neighboring anchors once the
+// interpolation error for the interval has been verified to be below the tolerance. The
+// number of anchors is limited, evicting the interior anchors farthest from the most
+// recent solve.
+//
+class WavePortModeCache
+{
+public:
+  // Maximum number of anchors stored.
+  static constexpr std::size_t max_size = 16;
+
+private:
+  struct Entry
+  {
+    double omega;
+    std::complex<double> kn;
+    ComplexVector e;
+    bool verified;  // Interpolation on [omega, next anchor] is within tolerance
+  };
+  std::vector<Entry> entries;
+  MPI_Comm comm;
+  double tol, omega_min, omega_max;
+
+  // Returns the index of the anchor interval containing the frequency, or the number of
+  // anchors if it is outside of the range of the anchors.
+  std::size_t FindInterval(double omega) const;
+  bool CanBisect(std::size_t k) const;
+  std::complex<double> Interpolate(std::size_t k, double omega, ComplexVector &e) const;
+
+public:
+  WavePortModeCache(MPI_Comm comm = MPI_COMM_NULL, double tol = 0.0)
+    : comm(comm), tol(tol), omega_min(0.0), omega_max(0.0)
+  {
+  }
+
+  bool Enabled() const { return tol > 0.0; }
+  auto Size() const { return entries.size(); }
+
+  // Set the range of frequencies for which the mode will be requested. The first anchors
+  // are placed at the ends of the range, so that all frequencies in the range are served
+  // by interpolation rather than extrapolation.
+  void SetFrequencyRange(double omega_min_, double omega_max_)
+  {
+    omega_min = omega_min_;
+    omega_max = omega_max_;
+  }
+
+  // Returns the frequency at which a solve is required in order to compute the mode at the
+  // given frequency, or zero if the mode is available from the cache.
+  double GetSolveFrequency(double omega) const;
+
+  // Add the mode solution at the given frequency to the cache (collective).
+  void Insert(double omega, std::complex<double> kn, const ComplexVector &e);
+
+  // Get the mode at the given frequency, from an anchor or by interpolation, and return
+  // the propagation constant (collective).
+  std::complex<double> GetMode(double omega, ComplexVector &e) const;
+};
+
 //
 // Helper class for wave port boundaries in a model.
 //
@@ -75,12 +139,26 @@ private:
   std::unique_ptr<EigenvalueSolver> eigen;
   std::unique_ptr<ComplexKspSolver> ksp;
 
+  // System matrix and solution of the most recent boundary mode eigenvalue problem. The
+  // eigenvector is also used as the starting vector for the next eigenvalue solve.
+  std::unique_ptr<ComplexOperator> opA;
+  double omega_A, omega_solve;
+  std::complex<double> lambda_solve, kn_solve;
+  ComplexVector e_solve;
+  bool has_e_solve;
+
+  // Boundary mode solutions at anchor frequencies for interpolation.
+  WavePortModeCache mode_cache;
+
   // Grid functions storing the last computed electric field mode on the port, and stored
   // objects for computing functions of the port modes for use as an excitation or in
   // postprocessing.
   std::unique_ptr<GridFunction> port_E0t, port_E0n, port_S0t, port_E;
   std::unique_ptr<mfem::LinearForm> port_sr, port_si;
 
+  // Boundary coupling operator for postprocessing the port power, constructed on first use.
+  mutable std::unique_ptr<SurfacePowerOperator> port_power;
+
 public:
   WavePortData(const config::WavePortData &data, const config::SolverData &solver,
                const MaterialOperator &mat_op, mfem::ParFiniteElementSpace &nd_fespace,
@@ -89,6 +167,26 @@ public:
 
   const auto &GetAttrList() const { return attr_list; }
 
+  // Set the range of frequencies for the boundary mode interpolation anchors.
+  void SetModeFrequencyRange(double omega_min, double omega_max)
+  {
+    mode_cache.SetFrequencyRange(omega_min, omega_max);
+  }
+
+  // The boundary mode computation is split into stages so that the eigenvalue problem
+  // solves for different ports, each on the processes which own the port boundary, can
+  // run concurrently:
+  //   (1) GetSolveFrequency returns the frequency at which an eigenvalue problem solve is
+  //       required in order to compute the mode at the given frequency (or zero if none).
+  //   (2) AssembleMode constructs the system matrix (collective).
+  //   (3) SolveMode solves the eigenvalue problem (only on the port processes).
+  //   (4) UpdateMode communicates the solution and updates the mode cache (collective).
+  // These are repeated until no more solves are required, after which Initialize sets up
+  // the mode for the given frequency (collective).
+  double GetSolveFrequency(double omega) const;
+  void AssembleMode(double omega);
+  void SolveMode();
+  void UpdateMode();
   void Initialize(double omega);
 
   HYPRE_BigInt GlobalTrueNDSize() const { return port_nd_fespace->GlobalTrueVSize(); }
@@ -120,6 +218,11 @@ public:
     MFEM_ABORT("GetVoltage is not yet implemented for wave port boundaries!");
     return 0.0;
   }
+
+  // Contributions of the local process to the port power and S-parameter, without the
+  // global reduction across processes.
+  std::complex<double> GetLocalPower(GridFunction &E, GridFunction &B) const;
+  std::complex<double> GetLocalSParameter(GridFunction &E) const;
 };
 
 //
@@ -135,6 +238,9 @@ private:
   bool suppress_output;
   double fc, kc;
 
+  // Order in which the boundary mode eigenvalue problems are solved, by decreasing size.
+  std::vector<int> solve_order;
+
   void SetUpBoundaryProperties(const IoData &iodata, const MaterialOperator &mat_op,
                                mfem::ParFiniteElementSpace &nd_fespace,
                                mfem::ParFiniteElementSpace &h1_fespace);
@@ -159,6 +265,16 @@ public:
   // Enable or suppress all outputs (log printing and fields to disk).
   void SetSuppressOutput(bool suppress) { suppress_output = suppress; }
 
+  // Set the range of frequencies of a frequency sweep, used to place the first boundary
+  // mode interpolation anchors for ports with mode interpolation enabled.
+  void SetModeFrequencyRange(double omega_min, double omega_max)
+  {
+    for (auto &[idx, data] : ports)
+    {
+      data.SetModeFrequencyRange(omega_min, omega_max);
+    }
+  }
+
   // Returns array of wave port attributes.
   mfem::Array<int> GetAttrList() const;
 
@@ -167,9 +283,12 @@ public:
                                      MaterialPropertyCoefficient &fbi);
 
   // Add contributions to the right-hand side source term vector for an incident field at
-  // excited port boundaries.
+  // excited port boundaries. The second overload adds only the contribution from the
+  // excited port with the given index.
   void AddExcitationBdrCoefficients(double omega, SumVectorCoefficient &fbr,
                                     SumVectorCoefficient &fbi);
+  void AddExcitationBdrCoefficients(int idx, double omega, SumVectorCoefficient &fbr,
+                                    SumVectorCoefficient &fbi);
 };
 
 }  // namespace palace
@@ -0,0 +1,84 @@
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "checkpoint.hpp"
+
+namespace palace::checkpoint
+{
+
+void WriteTransient(std::ostream &fo, const TransientHeader &header, const mfem::Vector &E,
+                    const mfem::Vector &dE, const mfem::Vector &B,
+                    const std::vector<const mfem::Vector *> &state,
+                    const mfem::Vector &indicator,
+                    const std::map<std::string, std::int64_t> &outputs)
+{
+  MFEM_VERIFY(E.Size() == header.local_size && dE.Size() == header.local_size &&
+                  B.Size() == header.b_size,
+              "Unexpected size for solution vector in checkpoint!");
+  MFEM_VERIFY(static_cast<std::int64_t>(state.size()) == header.num_state &&
+                  static_cast<std::int64_t>(outputs.size()) == header.num_outputs,
+              "Unexpected number of time integrator states or outputs in checkpoint!");
+  WriteBinary(fo, &header, 1);
+  for (const mfem::Vector *x : {&E, &dE, &B})
+  {
+    WriteBinary(fo, x->HostRead(), x->Size());
+  }
+  for (const mfem::Vector *x : state)
+  {
+    MFEM_VERIFY(x->Size() == header.local_size,
+                "Unexpected size for time integrator state vector in checkpoint!");
+    WriteBinary(fo, x->HostRead(), x->Size());
+  }
+  if (header.indicator_samples > 0)
+  {
+    MFEM_VERIFY(indicator.Size() == header.num_elem,
+                "Unexpected size for error indicator in checkpoint!");
+    WriteBinary(fo, indicator.HostRead(), indicator.Size());
+  }
+  for (const auto &[name, size] : outputs)
+  {
+    const std::int64_t n = static_cast<std::int64_t>(name.length());
+    WriteBinary(fo, &n, 1);
+    WriteBinary(fo, name.data(), name.length());
+    WriteBinary(fo, &size, 1);
+  }
+  WriteBinary(fo, &header.magic, 1);
+}
+
+bool ReadTransient(std::istream &fi, const TransientHeader &header, TransientData &data)
+{
+  auto ReadVector = [&fi](mfem::Vector &x, std::int64_t n)
+  {
+    x.SetSize(n);
+    x.UseDevice(true);
+    ReadBinary(fi, x.HostWrite(), x.Size());
+  };
+  ReadVector(data.E, header.local_size);
+  ReadVector(data.dE, header.local_size);
+  ReadVector(data.B, header.b_size);
+  data.state.resize(header.num_state);
+  for (auto &x : data.state)
+  {
+    ReadVector(x, header.local_size);
+  }
+  data.indicator.Destroy();
+  if (header.indicator_samples > 0)
+  {
+    ReadVector(data.indicator, header.num_elem);
+  }
+  data.outputs.clear();
+  for (std::int64_t i = 0; i < header.num_outputs && fi.good(); i++)
+  {
+    std::int64_t n = 0, size = 0;
+    ReadBinary(fi, &n, 1);
+    std::string name((fi.good() && n > 0) ? n : 0, ' ');
+    ReadBinary(fi, name.data(), name.length());
+    ReadBinary(fi, &size, 1);
+    data.outputs.emplace(std::move(name), size);
+  }
+  std::uint64_t magic = 0;
+  ReadBinary(fi, &magic, 1);
+  return fi.good() && magic == header.magic;
+}
+
+}  // namespace palace::checkpoint
@@ -0,0 +1,118 @@
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef PALACE_UTILS_CHECKPOINT_HPP
+#define PALACE_UTILS_CHECKPOINT_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+#include <mfem.hpp>
+
+namespace palace::checkpoint
+{
+
+//
+// Helper functions for binary checkpoint files, written with one file per process.
+//
+
+template <typename T>
+inline void WriteBinary(std::ostream &fo, const T *data, std::size_t n)
+{
+  fo.write(reinterpret_cast<const char *>(data), n * sizeof(T));
+}
+
+template <typename T>
+inline void ReadBinary(std::istream &fi, T *data, std::size_t n)
+{
+  fi.read(reinterpret_cast<char *>(data), n * sizeof(T));
+}
+
+inline std::uint64_t HashBytes(const void *data, std::size_t n, std::uint64_t h)
+{
+  // FNV-1a hash.
+  const auto *bytes = static_cast<const unsigned char *>(data);
+  for (std::size_t i = 0; i < n; i++)
+  {
+    h ^= bytes[i];
+    h *= 1099511628211ULL;
+  }
+  return h;
+}
+
+inline std::uint64_t GetMeshHash(const mfem::ParMesh &mesh)
+{
+  // Hash the local mesh coordinates and element attributes, which identifies both the mesh
+  // and its partitioning.
+  std::uint64_t h = 14695981039346656037ULL;
+  if (mesh.GetNodes())
+  {
+    const auto &nodes = *mesh.GetNodes();
+    h = HashBytes(nodes.HostRead(), nodes.Size() * sizeof(double), h);
+  }
+  else
+  {
+    for (int i = 0; i < mesh.GetNV(); i++)
+    {
+      h = HashBytes(mesh.GetVertex(i), mesh.SpaceDimension() * sizeof(double), h);
+    }
+  }
+  for (int i = 0; i < mesh.GetNE(); i++)
+  {
+    const int attr = mesh.GetAttribute(i);
+    h = HashBytes(&attr, sizeof(int), h);
+  }
+  for (int i = 0; i < mesh.GetNBE(); i++)
+  {
+    const int attr = mesh.GetBdrAttribute(i);
+    h = HashBytes(&attr, sizeof(int), h);
+  }
+  return h;
+}
+
+//
+// Binary checkpoint files for transient simulations.
+//
+
+// Header identifying the mesh and its partitioning and the time integration scheme, as well
+// as the time step at which the checkpoint was saved and the maximum norm of E so far used
+// by adaptive time step control. The local sizes of the E-field (and time integrator state)
+// and the B-field are stored separately, since they belong to different finite element
+// spaces.
+struct TransientHeader
+{
+  std::uint64_t magic, mesh_hash;
+  std::int64_t version, size, rank, local_size, b_size, global_size, num_elem, type;
+  std::int64_t step, num_state, indicator_samples, num_outputs;
+  double delta_t, t, dt, E_max;
+};
+
+// Contents of a checkpoint file following the header.
+struct TransientData
+{
+  mfem::Vector E, dE, B;
+  std::vector<mfem::Vector> state;
+  mfem::Vector indicator;
+  std::map<std::string, std::int64_t> outputs;
+};
+
+// Write a checkpoint file with the given header. The vector sizes must agree with the
+// header, and the error indicator is only written if the header has a positive number of
+// samples. The magic number is repeated at the end of the file to mark a completely written
+// checkpoint.
+void WriteTransient(std::ostream &fo, const TransientHeader &header, const mfem::Vector &E,
+                    const mfem::Vector &dE, const mfem::Vector &B,
+                    const std::vector<const mfem::Vector *> &state,
+                    const mfem::Vector &indicator,
+                    const std::map<std::string, std::int64_t> &outputs);
+
+// Read the contents of a checkpoint file following the given header, which has already
+// been read from the stream. Returns false if the file is incomplete.
+bool ReadTransient(std::istream &fi, const TransientHeader &header, TransientData &data);
+
+}  // namespace palace::checkpoint
+
+#endif  // PALACE_UTILS_CHECKPOINT_HPP
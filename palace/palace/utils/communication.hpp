@@ -269,6 +269,27 @@ public:
     GlobalOp(len, buff, MPI_SUM, comm);
   }
 
+  // Wrapper for MPI_Iallreduce. The buffer should not be accessed until the returned
+  // request has completed.
+  template <typename T>
+  static MPI_Request GlobalOpAsync(int len, T *buff, MPI_Op op, MPI_Comm comm)
+  {
+    MPI_Request req;
+    MPI_Iallreduce(MPI_IN_PLACE, buff, len, mpi::DataType<T>(), op, comm, &req);
+    return req;
+  }
+
+  // Nonblocking global sum (in-place, result is broadcast to all processes once the request
+  // has completed).
+  template <typename T>
+  static MPI_Request GlobalSumAsync(int len, T *buff, MPI_Comm comm)
+  {
+    return GlobalOpAsync(len, buff, MPI_SUM, comm);
+  }
+
+  // Wait for a nonblocking operation to complete.
+  static void Wait(MPI_Request &req) { MPI_Wait(&req, MPI_STATUS_IGNORE); }
+
   // Global minimum with index (in-place, result is broadcast to all processes).
   template <typename T, typename U>
   static void GlobalMinLoc(int len, T *val, U *loc, MPI_Comm comm)
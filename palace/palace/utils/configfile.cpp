@@ -252,6 +252,7 @@ void ProblemData::SetUp(json &config)
   type = problem->at("Type");  // Required
   verbose = problem->value("Verbose", verbose);
   output = problem->value("Output", output);
+  async_output = problem->value("AsyncOutput", async_output);
 
   // Check for provided solver configuration data (not required for electrostatics or
   // magnetostatics since defaults can be used for every option).
@@ -293,6 +294,7 @@ void ProblemData::SetUp(json &config)
   problem->erase("Type");
   problem->erase("Verbose");
   problem->erase("Output");
+  problem->erase("AsyncOutput");
   MFEM_VERIFY(problem->empty(),
               "Found an unsupported configuration file keyword under \"Problem\"!\n"
                   << problem->dump(2));
@@ -303,6 +305,7 @@ void ProblemData::SetUp(json &config)
     std::cout << "Type: " << type << '\n';
     std::cout << "Verbose: " << verbose << '\n';
     std::cout << "Output: " << output << '\n';
+    std::cout << "AsyncOutput: " << async_output << '\n';
   }
 }
 
@@ -1059,6 +1062,7 @@ void WavePortBoundaryData::SetUp(json &boundaries)
                 "\"WavePort\" boundary \"Mode\" must be positive (1-based)!");
     data.d_offset = it->value("Offset", data.d_offset);
     data.eigen_type = it->value("SolverType", data.eigen_type);
+    data.mode_tol = it->value("ModeInterpolationTol", data.mode_tol);
     data.excitation = it->value("Excitation", data.excitation);
     data.active = it->value("Active", data.active);
 
@@ -1068,6 +1072,7 @@ void WavePortBoundaryData::SetUp(json &boundaries)
     it->erase("Mode");
     it->erase("Offset");
     it->erase("SolverType");
+    it->erase("ModeInterpolationTol");
     it->erase("Excitation");
     it->erase("Active");
     MFEM_VERIFY(it->empty(),
@@ -1082,6 +1087,7 @@ void WavePortBoundaryData::SetUp(json &boundaries)
       std::cout << "Mode: " << data.mode_idx << '\n';
       std::cout << "Offset: " << data.d_offset << '\n';
       std::cout << "SolverType: " << data.eigen_type << '\n';
+      std::cout << "ModeInterpolationTol: " << data.mode_tol << '\n';
       std::cout << "Excitation: " << data.excitation << '\n';
       std::cout << "Active: " << data.active << '\n';
     }
@@ -1425,6 +1431,11 @@ void DrivenSolverData::SetUp(json &solver)
   adaptive_tol = driven->value("AdaptiveTol", adaptive_tol);
   adaptive_max_size = driven->value("AdaptiveMaxSamples", adaptive_max_size);
   adaptive_memory = driven->value("AdaptiveConvergenceMemory", adaptive_memory);
+  adaptive_checkpoint = driven->value("AdaptiveCheckpoint", adaptive_checkpoint);
+  adaptive_online_only = driven->value("AdaptiveOnlineOnly", adaptive_online_only);
+  adaptive_batch_size = driven->value("AdaptiveBatchSize", adaptive_batch_size);
+  multi_excitation = driven->value("MultipleExcitations", multi_excitation);
+  freq_groups = driven->value("FrequencyGroups", freq_groups);
 
   // Cleanup
   driven->erase("MinFreq");
@@ -1435,6 +1446,11 @@ void DrivenSolverData::SetUp(json &solver)
   driven->erase("AdaptiveTol");
   driven->erase("AdaptiveMaxSamples");
   driven->erase("AdaptiveConvergenceMemory");
+  driven->erase("AdaptiveCheckpoint");
+  driven->erase("AdaptiveOnlineOnly");
+  driven->erase("AdaptiveBatchSize");
+  driven->erase("MultipleExcitations");
+  driven->erase("FrequencyGroups");
   MFEM_VERIFY(driven->empty(),
               "Found an unsupported configuration file keyword under \"Driven\"!\n"
                   << driven->dump(2));
@@ -1450,6 +1466,11 @@ void DrivenSolverData::SetUp(json &solver)
     std::cout << "AdaptiveTol: " << adaptive_tol << '\n';
     std::cout << "AdaptiveMaxSamples: " << adaptive_max_size << '\n';
     std::cout << "AdaptiveConvergenceMemory: " << adaptive_memory << '\n';
+    std::cout << "AdaptiveCheckpoint: " << adaptive_checkpoint << '\n';
+    std::cout << "AdaptiveOnlineOnly: " << adaptive_online_only << '\n';
+    std::cout << "AdaptiveBatchSize: " << adaptive_batch_size << '\n';
+    std::cout << "MultipleExcitations: " << multi_excitation << '\n';
+    std::cout << "FrequencyGroups: " << freq_groups << '\n';
   }
 }
 
@@ -1464,6 +1485,12 @@ void EigenSolverData::SetUp(json &solver)
                   solver.find("Driven") != solver.end(),
               "Missing \"Eigenmode\" solver \"Target\" in the configuration file!");
   target = eigenmode->value("Target", target);  // Required (only for eigenmode simulations)
+  target_upper = eigenmode->value("TargetUpper", target_upper);
+  n_slice = eigenmode->value("Slices", n_slice);
+  MFEM_VERIFY(n_slice > 0, "config[\"Eigenmode\"][\"Slices\"] must be positive!");
+  MFEM_VERIFY(n_slice == 1 || target_upper > target,
+              "config[\"Eigenmode\"][\"TargetUpper\"] must be greater than the target "
+              "for spectrum slicing!");
   tol = eigenmode->value("Tol", tol);
   max_it = eigenmode->value("MaxIts", max_it);
   max_size = eigenmode->value("MaxSize", max_size);
@@ -1478,6 +1505,8 @@ void EigenSolverData::SetUp(json &solver)
 
   // Cleanup
   eigenmode->erase("Target");
+  eigenmode->erase("TargetUpper");
+  eigenmode->erase("Slices");
   eigenmode->erase("Tol");
   eigenmode->erase("MaxIts");
   eigenmode->erase("MaxSize");
@@ -1497,6 +1526,8 @@ void EigenSolverData::SetUp(json &solver)
   if constexpr (JSON_DEBUG)
   {
     std::cout << "Target: " << target << '\n';
+    std::cout << "TargetUpper: " << target_upper << '\n';
+    std::cout << "Slices: " << n_slice << '\n';
     std::cout << "Tol: " << tol << '\n';
     std::cout << "MaxIts: " << max_it << '\n';
     std::cout << "MaxSize: " << max_size << '\n';
@@ -1592,6 +1623,21 @@ void TransientSolverData::SetUp(json &solver)
   max_t = transient->at("MaxTime");     // Required
   delta_t = transient->at("TimeStep");  // Required
   delta_post = transient->value("SaveStep", delta_post);
+  checkpoint = transient->value("Checkpoint", checkpoint);
+  delta_checkpoint = transient->value("CheckpointStep", delta_checkpoint);
+  restart = transient->value("Restart", restart);
+  MFEM_VERIFY(delta_checkpoint >= 0,
+              "config[\"Solver\"][\"Transient\"][\"CheckpointStep\"] must be "
+              "non-negative!");
+  mass_lumping = transient->value("MassLumping", mass_lumping);
+  mass_lumping_it = transient->value("MassLumpingIts", mass_lumping_it);
+  MFEM_VERIFY(mass_lumping_it >= 0,
+              "config[\"Solver\"][\"Transient\"][\"MassLumpingIts\"] must be "
+              "non-negative!");
+  adapt_tol = transient->value("AdaptiveTol", adapt_tol);
+  MFEM_VERIFY(adapt_tol >= 0.0,
+              "config[\"Solver\"][\"Transient\"][\"AdaptiveTol\"] must be "
+              "non-negative!");
 
   // Cleanup
   transient->erase("Type");
@@ -1601,6 +1647,12 @@ void TransientSolverData::SetUp(json &solver)
   transient->erase("MaxTime");
   transient->erase("TimeStep");
   transient->erase("SaveStep");
+  transient->erase("Checkpoint");
+  transient->erase("CheckpointStep");
+  transient->erase("Restart");
+  transient->erase("MassLumping");
+  transient->erase("MassLumpingIts");
+  transient->erase("AdaptiveTol");
   MFEM_VERIFY(transient->empty(),
               "Found an unsupported configuration file keyword under \"Transient\"!\n"
                   << transient->dump(2));
@@ -1615,6 +1667,12 @@ void TransientSolverData::SetUp(json &solver)
     std::cout << "MaxTime: " << max_t << '\n';
     std::cout << "TimeStep: " << delta_t << '\n';
     std::cout << "SaveStep: " << delta_post << '\n';
+    std::cout << "Checkpoint: " << checkpoint << '\n';
+    std::cout << "CheckpointStep: " << delta_checkpoint << '\n';
+    std::cout << "Restart: " << restart << '\n';
+    std::cout << "MassLumping: " << mass_lumping << '\n';
+    std::cout << "MassLumpingIts: " << mass_lumping_it << '\n';
+    std::cout << "AdaptiveTol: " << adapt_tol << '\n';
   }
 }
 
@@ -1634,9 +1692,11 @@ PALACE_JSON_SERIALIZE_ENUM(LinearSolverData::Type,
 PALACE_JSON_SERIALIZE_ENUM(LinearSolverData::KspType,
                            {{LinearSolverData::KspType::DEFAULT, "Default"},
                             {LinearSolverData::KspType::CG, "CG"},
+                            {LinearSolverData::KspType::PIPECG, "PipeCG"},
                             {LinearSolverData::KspType::MINRES, "MINRES"},
                             {LinearSolverData::KspType::GMRES, "GMRES"},
                             {LinearSolverData::KspType::FGMRES, "FGMRES"},
+                            {LinearSolverData::KspType::GCRODR, "GCRODR"},
                             {LinearSolverData::KspType::BICGSTAB, "BiCGSTAB"}})
 PALACE_JSON_SERIALIZE_ENUM(LinearSolverData::SideType,
                            {{LinearSolverData::SideType::DEFAULT, "Default"},
@@ -1667,7 +1727,8 @@ PALACE_JSON_SERIALIZE_ENUM(LinearSolverData::CompressionType,
 PALACE_JSON_SERIALIZE_ENUM(LinearSolverData::OrthogType,
                            {{LinearSolverData::OrthogType::MGS, "MGS"},
                             {LinearSolverData::OrthogType::CGS, "CGS"},
-                            {LinearSolverData::OrthogType::CGS2, "CGS2"}})
+                            {LinearSolverData::OrthogType::CGS2, "CGS2"},
+                            {LinearSolverData::OrthogType::DCGS2, "DCGS2"}})
 
 void LinearSolverData::SetUp(json &solver)
 {
@@ -1681,6 +1742,7 @@ void LinearSolverData::SetUp(json &solver)
   tol = linear->value("Tol", tol);
   max_it = linear->value("MaxIts", max_it);
   max_size = linear->value("MaxSize", max_size);
+  recycle_size = linear->value("RecycleSize", recycle_size);
   initial_guess = linear->value("InitialGuess", initial_guess);
 
   // Options related to multigrid.
@@ -1694,10 +1756,12 @@ void LinearSolverData::SetUp(json &solver)
   mg_smooth_sf_max = linear->value("MGSmoothEigScaleMax", mg_smooth_sf_max);
   mg_smooth_sf_min = linear->value("MGSmoothEigScaleMin", mg_smooth_sf_min);
   mg_smooth_cheby_4th = linear->value("MGSmoothChebyshev4th", mg_smooth_cheby_4th);
+  mg_single_precision = linear->value("MGSinglePrecision", mg_single_precision);
 
   // Preconditioner-specific options.
   pc_mat_real = linear->value("PCMatReal", pc_mat_real);
   pc_mat_shifted = linear->value("PCMatShifted", pc_mat_shifted);
+  pc_mat_cache = linear->value("PCMatCache", pc_mat_cache);
   pc_side_type = linear->value("PCSide", pc_side_type);
   sym_fact_type = linear->value("ColumnOrdering", sym_fact_type);
   strumpack_compression_type =
@@ -1717,6 +1781,7 @@ void LinearSolverData::SetUp(json &solver)
   estimator_tol = linear->value("EstimatorTol", estimator_tol);
   estimator_max_it = linear->value("EstimatorMaxIts", estimator_max_it);
   estimator_mg = linear->value("EstimatorMG", estimator_mg);
+  estimator_local = linear->value("EstimatorLocal", estimator_local);
   gs_orthog_type = linear->value("GSOrthogonalization", gs_orthog_type);
 
   // Cleanup
@@ -1725,6 +1790,7 @@ void LinearSolverData::SetUp(json &solver)
   linear->erase("Tol");
   linear->erase("MaxIts");
   linear->erase("MaxSize");
+  linear->erase("RecycleSize");
   linear->erase("InitialGuess");
 
   linear->erase("MGMaxLevels");
@@ -1737,9 +1803,11 @@ void LinearSolverData::SetUp(json &solver)
   linear->erase("MGSmoothEigScaleMax");
   linear->erase("MGSmoothEigScaleMin");
   linear->erase("MGSmoothChebyshev4th");
+  linear->erase("MGSinglePrecision");
 
   linear->erase("PCMatReal");
   linear->erase("PCMatShifted");
+  linear->erase("PCMatCache");
   linear->erase("PCSide");
   linear->erase("ColumnOrdering");
   linear->erase("STRUMPACKCompressionType");
@@ -1756,6 +1824,7 @@ void LinearSolverData::SetUp(json &solver)
   linear->erase("EstimatorTol");
   linear->erase("EstimatorMaxIts");
   linear->erase("EstimatorMG");
+  linear->erase("EstimatorLocal");
   linear->erase("GSOrthogonalization");
   MFEM_VERIFY(linear->empty(),
               "Found an unsupported configuration file keyword under \"Linear\"!\n"
@@ -1769,6 +1838,7 @@ void LinearSolverData::SetUp(json &solver)
     std::cout << "Tol: " << tol << '\n';
     std::cout << "MaxIts: " << max_it << '\n';
     std::cout << "MaxSize: " << max_size << '\n';
+    std::cout << "RecycleSize: " << recycle_size << '\n';
     std::cout << "InitialGuess: " << initial_guess << '\n';
 
     std::cout << "MGMaxLevels: " << mg_max_levels << '\n';
@@ -1781,9 +1851,11 @@ void LinearSolverData::SetUp(json &solver)
     std::cout << "MGSmoothEigScaleMax: " << mg_smooth_sf_max << '\n';
     std::cout << "MGSmoothEigScaleMin: " << mg_smooth_sf_min << '\n';
     std::cout << "MGSmoothChebyshev4th: " << mg_smooth_cheby_4th << '\n';
+    std::cout << "MGSinglePrecision: " << mg_single_precision << '\n';
 
     std::cout << "PCMatReal: " << pc_mat_real << '\n';
     std::cout << "PCMatShifted: " << pc_mat_shifted << '\n';
+    std::cout << "PCMatCache: " << pc_mat_cache << '\n';
     std::cout << "PCSide: " << pc_side_type << '\n';
     std::cout << "ColumnOrdering: " << sym_fact_type << '\n';
     std::cout << "STRUMPACKCompressionType: " << strumpack_compression_type << '\n';
@@ -1800,6 +1872,7 @@ void LinearSolverData::SetUp(json &solver)
     std::cout << "EstimatorTol: " << estimator_tol << '\n';
     std::cout << "EstimatorMaxIts: " << estimator_max_it << '\n';
     std::cout << "EstimatorMG: " << estimator_mg << '\n';
+    std::cout << "EstimatorLocal: " << estimator_local << '\n';
     std::cout << "GSOrthogonalization: " << gs_orthog_type << '\n';
   }
 }
@@ -109,6 +109,9 @@ public:
   // Output path for storing results.
   std::string output = "";
 
+  // Write fields to disk on a background thread while the simulation continues.
+  bool async_output = false;
+
   void SetUp(json &config);
 };
 
@@ -473,6 +476,10 @@ public:
   };
   EigenSolverType eigen_type = EigenSolverType::DEFAULT;
 
+  // Relative error tolerance for interpolating the boundary mode between frequencies at
+  // which it has been computed (a value of zero disables interpolation).
+  double mode_tol = 0.0;
+
   // Flag for source term in driven and transient simulations.
   bool excitation = false;
 
@@ -641,6 +648,24 @@ public:
   // Memory required for adaptive sampling convergence.
   int adaptive_memory = 2;
 
+  // Directory for saving the PROM constructed for adaptive frequency sweep, from which it
+  // is reloaded in subsequent simulations of the same problem.
+  std::string adaptive_checkpoint = "";
+
+  // Skip the adaptive sampling (offline phase) when a PROM is loaded from checkpoint.
+  bool adaptive_online_only = false;
+
+  // Number of frequency samples added to the PROM per iteration of the adaptive sampling.
+  int adaptive_batch_size = 1;
+
+  // Solve for each excited port separately at every frequency in order to compute the full
+  // scattering matrix (columns for all excited ports).
+  bool multi_excitation = false;
+
+  // Number of process groups for a parallel-in-frequency sweep, each of which solves for a
+  // strided subset of the frequency steps.
+  int freq_groups = 1;
+
   void SetUp(json &solver);
 };
 
@@ -650,6 +675,13 @@ public:
   // Target for shift-and-invert spectral transformation [GHz].
   double target = 0.0;
 
+  // Upper end of the frequency band for spectrum slicing [GHz].
+  double target_upper = 0.0;
+
+  // Number of spectrum slices, splitting the band between the target and its upper end
+  // into intervals which are solved for separately.
+  int n_slice = 1;
+
   // Eigenvalue solver relative tolerance.
   double tol = 1.0e-6;
 
@@ -743,6 +775,24 @@ public:
   // Step increment for saving fields to disk.
   int delta_post = 0;
 
+  // Directory for saving checkpoints of the time integration state, and step increment for
+  // saving them.
+  std::string checkpoint = "";
+  int delta_checkpoint = 0;
+
+  // Restart the time integration from the most recent checkpoint.
+  bool restart = false;
+
+  // Use a lumped (diagonal) approximation of the mass and damping matrices for explicit
+  // time integration, with optional fixed number of correction iterations with the
+  // consistent matrices.
+  bool mass_lumping = false;
+  int mass_lumping_it = 0;
+
+  // Relative tolerance for the local time integration error estimate used for adaptive
+  // time step control with implicit time integration (zero for uniform time steps).
+  double adapt_tol = 0.0;
+
   void SetUp(json &solver);
 };
 
@@ -768,9 +818,11 @@ public:
   {
     DEFAULT,
     CG,
+    PIPECG,
     MINRES,
     GMRES,
     FGMRES,
+    GCRODR,
     BICGSTAB
   };
   KspType ksp_type = KspType::DEFAULT;
@@ -781,9 +833,13 @@ public:
   // Maximum iterations for iterative solver.
   int max_it = 100;
 
-  // Maximum Krylov space dimension for GMRES/FGMRES iterative solvers.
+  // Maximum Krylov space dimension for GMRES/FGMRES/GCRO-DR iterative solvers.
   int max_size = -1;
 
+  // Dimension of the subspace recycled between restarts and linear solves for the GCRO-DR
+  // iterative solver.
+  int recycle_size = 10;
+
   // Reuse previous solution as initial guess for Krylov solvers.
   int initial_guess = -1;
 
@@ -825,6 +881,10 @@ public:
   // use standard 1st-kind polynomials.
   bool mg_smooth_cheby_4th = true;
 
+  // Store the assembled operators for the geometric multigrid levels finer than the
+  // coarsest in single precision.
+  bool mg_single_precision = false;
+
   // For frequency domain applications, precondition linear systems with a real-valued
   // approximation to the system matrix.
   bool pc_mat_real = false;
@@ -833,6 +893,10 @@ public:
   // (makes the preconditoner matrix SPD).
   int pc_mat_shifted = -1;
 
+  // Cache the terms of the preconditioner matrix on the fully assembled multigrid levels,
+  // to form the matrix for new coefficients without reassembly.
+  bool pc_mat_cache = true;
+
   // Choose left or right preconditioning.
   enum class SideType
   {
@@ -904,13 +968,18 @@ public:
   // of just Jacobi).
   bool estimator_mg = false;
 
-  // Enable different variants of Gram-Schmidt orthogonalization for GMRES/FGMRES iterative
-  // solvers and SLEPc eigenvalue solver.
+  // Use a local element-wise flux recovery with averaging of shared degrees of freedom for
+  // the error estimator, instead of the global L2 projection which requires a linear solve.
+  bool estimator_local = false;
+
+  // Enable different variants of Gram-Schmidt orthogonalization for GMRES/FGMRES/GCRO-DR
+  // iterative solvers and SLEPc eigenvalue solver.
   enum class OrthogType
   {
     MGS,
     CGS,
-    CGS2
+    CGS2,
+    DCGS2
   };
   OrthogType gs_orthog_type = OrthogType::MGS;
 
@@ -0,0 +1,332 @@
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "fieldwriter.hpp"
+
+#include <algorithm>
+#include "utils/communication.hpp"
+#include "utils/filesystem.hpp"
+#include "utils/geodata.hpp"
+
+namespace palace
+{
+
+namespace
+{
+
+// Number of digits in the cycle numbers of the output directories.
+constexpr int pad_digits_cycle = 6;
+
+std::unique_ptr<mfem::Mesh> GetLocalMesh(const mfem::ParMesh &pmesh)
+{
+  // Copy the local elements of the parallel mesh, keeping the vertex and element ordering
+  // as well as the element vertex orderings so that the element degrees of freedom of the
+  // finite element spaces on the copy correspond to those of the parallel mesh. There is
+  // no information about the parallel partitioning or nonconforming interfaces, which is
+  // not required for visualization.
+  auto mesh = std::make_unique<mfem::Mesh>(pmesh.Dimension(), pmesh.GetNV(), pmesh.GetNE(),
+                                           0, pmesh.SpaceDimension());
+  for (int i = 0; i < pmesh.GetNV(); i++)
+  {
+    mesh->AddVertex(pmesh.GetVertex(i));
+  }
+  for (int i = 0; i < pmesh.GetNE(); i++)
+  {
+    mesh->AddElement(pmesh.GetElement(i)->Duplicate(mesh.get()));
+  }
+  mesh->FinalizeTopology(false);
+  mesh->Finalize(false, false);
+  return mesh;
+}
+
+void GetLocalMap(const mfem::FiniteElementSpace &src, const mfem::FiniteElementSpace &dst,
+                 double scale, mfem::Array<int> &map, mfem::Vector &weight)
+{
+  // Construct the mapping from the degrees of freedom of dst to those of src on the same
+  // elements. Negative indices indicate degrees of freedom with flipped orientation, the
+  // element degree of freedom transformations are the same for both spaces.
+  map.SetSize(dst.GetVSize());
+  weight.SetSize(dst.GetVSize());
+  map = 0;
+  weight = 0.0;
+  mfem::Array<int> src_vdofs, dst_vdofs;
+  for (int e = 0; e < dst.GetNE(); e++)
+  {
+    src.GetElementVDofs(e, src_vdofs);
+    dst.GetElementVDofs(e, dst_vdofs);
+    MFEM_VERIFY(src_vdofs.Size() == dst_vdofs.Size(),
+                "Mismatch in element degrees of freedom for field output!");
+    for (int j = 0; j < dst_vdofs.Size(); j++)
+    {
+      const int s = src_vdofs[j], d = dst_vdofs[j];
+      const int k = (d >= 0) ? d : -1 - d;
+      map[k] = (s >= 0) ? s : -1 - s;
+      weight(k) = ((s >= 0) == (d >= 0)) ? scale : -scale;
+    }
+  }
+}
+
+}  // namespace
+
+FieldWriter::FieldWriter(const std::string &path, mfem::ParMesh &pmesh, double L0,
+                         int refine, bool async, int num_buffers)
+  : comm(MPI_COMM_NULL), mesh(GetLocalMesh(pmesh)), paraview(path, mesh.get()),
+    paraview_bdr(path + "_boundary", mesh.get()), last_step(-1), last_time(0.0),
+    stop(false)
+{
+  // Copy the high-order nodes for curved meshes, and redimensionalize the mesh once so that
+  // coordinates are output in the same units as the input mesh.
+  if (const auto *pnodes = pmesh.GetNodes())
+  {
+    const auto &pnodes_fespace = *pnodes->FESpace();
+    nodes_fec = std::unique_ptr<mfem::FiniteElementCollection>(
+        mfem::FiniteElementCollection::New(pnodes_fespace.FEColl()->Name()));
+    nodes_fespace = std::make_unique<mfem::FiniteElementSpace>(
+        mesh.get(), nodes_fec.get(), pnodes_fespace.GetVDim(),
+        pnodes_fespace.GetOrdering());
+    mesh->SetNodalFESpace(nodes_fespace.get());
+    mfem::Array<int> map;
+    mfem::Vector weight;
+    GetLocalMap(pnodes_fespace, *nodes_fespace, 1.0, map, weight);
+    const double *src = pnodes->HostRead();
+    double *dst = mesh->GetNodes()->HostWrite();
+    for (int k = 0; k < map.Size(); k++)
+    {
+      dst[k] = weight(k) * src[map[k]];
+    }
+  }
+  mesh::DimensionalizeMesh(*mesh, L0);
+
+  // Set up the data collections. Each process writes the data for its local mesh. The data
+  // collections use a duplicate of the mesh communicator, which is only used for the
+  // process rank and number of processes since the collections are defined on a serial
+  // mesh. The output directories are created by CreateDirectories on the calling thread,
+  // so that saving the data collections does not make any MPI calls.
+  MPI_Comm_dup(pmesh.GetComm(), &comm);
+  const mfem::VTKFormat format = mfem::VTKFormat::BINARY32;
+#if defined(MFEM_USE_ZLIB)
+  const int compress = -1;  // Default compression level
+#else
+  const int compress = 0;
+#endif
+  const bool use_ho = true;
+  for (auto *dc : {&paraview, &paraview_bdr})
+  {
+    dc->SetMesh(comm, mesh.get());
+    dc->SetCycle(-1);
+    dc->SetPadDigitsCycle(pad_digits_cycle);
+    dc->SetDataFormat(format);
+    dc->SetCompressionLevel(compress);
+    dc->SetHighOrderOutput(use_ho);
+    dc->SetLevelsOfDetail(refine);
+  }
+
+  // Set up the snapshot buffers and start the background thread for writing.
+  buffers.resize(async ? std::max(num_buffers, 1) : 1);
+  for (int k = static_cast<int>(buffers.size()) - 1; k >= 0; k--)
+  {
+    free_buffers.push_back(k);
+  }
+  if (async)
+  {
+    worker = std::thread(&FieldWriter::Run, this);
+  }
+}
+
+FieldWriter::~FieldWriter()
+{
+  // Finish writing all pending output before destruction.
+  {
+    std::lock_guard<std::mutex> lock(mtx);
+    stop = true;
+  }
+  cv.notify_all();
+  if (worker.joinable())
+  {
+    worker.join();
+  }
+  MPI_Comm_free(&comm);
+}
+
+void FieldWriter::RegisterField(const std::string &name, const mfem::ParGridFunction &gf,
+                                double scale)
+{
+  Wait();
+  const auto &fespace = *gf.ParFESpace();
+  auto &data = fields.emplace_back(FieldData{name, gf});
+  data.fec = std::unique_ptr<mfem::FiniteElementCollection>(
+      mfem::FiniteElementCollection::New(fespace.FEColl()->Name()));
+  data.fespace = std::make_unique<mfem::FiniteElementSpace>(
+      mesh.get(), data.fec.get(), fespace.GetVDim(), fespace.GetOrdering());
+  data.out = std::make_unique<mfem::GridFunction>(data.fespace.get());
+  *data.out = 0.0;
+  GetLocalMap(fespace, *data.fespace, scale, data.map, data.weight);
+  paraview.RegisterField(name, data.out.get());
+}
+
+void FieldWriter::Write(int step, double time)
+{
+  // Create the output directories, wait for a free buffer, then copy the fields. These are
+  // the only parts of the output which are done on the calling thread when writing
+  // asynchronously.
+  CreateDirectories(step);
+  int k;
+  {
+    std::unique_lock<std::mutex> lock(mtx);
+    cv.wait(lock, [this] { return !free_buffers.empty(); });
+    CheckError();
+    k = free_buffers.back();
+    free_buffers.pop_back();
+  }
+  auto &snapshot = buffers[k];
+  snapshot.step = last_step = step;
+  snapshot.time = last_time = time;
+  snapshot.data.resize(fields.size());
+  for (std::size_t i = 0; i < fields.size(); i++)
+  {
+    const auto &gf = fields[i].gf;
+    snapshot.data[i].SetSize(gf.Size());
+    std::copy_n(gf.HostRead(), gf.Size(), snapshot.data[i].HostWrite());
+  }
+  if (!worker.joinable())
+  {
+    WriteSnapshot(snapshot);
+    free_buffers.push_back(k);
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(mtx);
+    queue.push_back(k);
+  }
+  cv.notify_all();
+}
+
+void FieldWriter::WriteElementFields(double time,
+                                     const std::map<std::string, mfem::Vector> &data)
+{
+  Wait();
+  last_step++;
+  last_time = time;
+  for (const auto &field : fields)
+  {
+    paraview.DeregisterField(field.name);
+  }
+  mfem::L2_FECollection pwconst_fec(0, mesh->Dimension());
+  mfem::FiniteElementSpace pwconst_fespace(mesh.get(), &pwconst_fec);
+  std::vector<std::unique_ptr<mfem::GridFunction>> gfs;
+  for (const auto &[name, vals] : data)
+  {
+    MFEM_VERIFY(vals.Size() == mesh->GetNE(),
+                "Size mismatch for element field \"" << name << "\" for output!");
+    auto &gf = gfs.emplace_back(std::make_unique<mfem::GridFunction>(&pwconst_fespace));
+    *gf = vals;
+    paraview.RegisterField(name, gf.get());
+  }
+  CreateDirectories(last_step);
+  paraview.SetCycle(last_step);
+  paraview.SetTime(last_time);
+  paraview.Save();
+  for (const auto &[name, vals] : data)
+  {
+    paraview.DeregisterField(name);
+  }
+  for (const auto &field : fields)
+  {
+    paraview.RegisterField(field.name, field.out.get());
+  }
+}
+
+void FieldWriter::CreateDirectories(int step)
+{
+  // Create the output directories for the given step on the calling thread, using the same
+  // paths as mfem::ParaViewDataCollection::Save. This is collective on the communicator.
+  if (Mpi::Root(comm))
+  {
+    for (const auto *dc : {&paraview, &paraview_bdr})
+    {
+      const std::filesystem::path path = dc->GetPrefixPath() + dc->GetCollectionName() +
+                                         "/Cycle" +
+                                         mfem::to_padded_string(step, pad_digits_cycle);
+      if (!std::filesystem::exists(path))
+      {
+        std::filesystem::create_directories(path);
+      }
+    }
+  }
+  Mpi::Barrier(comm);
+}
+
+void FieldWriter::Wait()
+{
+  std::unique_lock<std::mutex> lock(mtx);
+  cv.wait(lock, [this] { return queue.empty(); });
+  CheckError();
+}
+
+void FieldWriter::CheckError()
+{
+  // Rethrow any error from the background thread on the calling thread. Assumes that the
+  // lock is held.
+  if (error)
+  {
+    std::exception_ptr e = error;
+    error = nullptr;
+    std::rethrow_exception(e);
+  }
+}
+
+void FieldWriter::Run()
+{
+  while (true)
+  {
+    int k;
+    {
+      std::unique_lock<std::mutex> lock(mtx);
+      cv.wait(lock, [this] { return stop || !queue.empty(); });
+      if (queue.empty())
+      {
+        return;
+      }
+      k = queue.front();
+    }
+    try
+    {
+      WriteSnapshot(buffers[k]);
+    }
+    catch (...)
+    {
+      std::lock_guard<std::mutex> lock(mtx);
+      error = std::current_exception();
+    }
+    {
+      std::lock_guard<std::mutex> lock(mtx);
+      queue.pop_front();
+      free_buffers.push_back(k);
+    }
+    cv.notify_all();
+  }
+}
+
+void FieldWriter::WriteSnapshot(const Snapshot &snapshot)
+{
+  // Map the field values to the degrees of freedom on the local mesh, including the
+  // scaling for the redimensionalized mesh, and write.
+  for (std::size_t i = 0; i < fields.size(); i++)
+  {
+    const auto &field = fields[i];
+    const double *src = snapshot.data[i].HostRead();
+    double *dst = field.out->HostWrite();
+    for (int k = 0; k < field.map.Size(); k++)
+    {
+      dst[k] = field.weight(k) * src[field.map[k]];
+    }
+  }
+  for (auto *dc : {&paraview, &paraview_bdr})
+  {
+    dc->SetCycle(snapshot.step);
+    dc->SetTime(snapshot.time);
+    dc->Save();
+  }
+}
+
+}  // namespace palace
@@ -0,0 +1,125 @@
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef PALACE_UTILS_FIELD_WRITER_HPP
+#define PALACE_UTILS_FIELD_WRITER_HPP
+
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <mfem.hpp>
+
+namespace palace
+{
+
+//
+// A class for writing fields to disk in ParaView format, optionally on a background thread
+// so that the solver can continue with the next frequency or time step while the output
+// is written. Output is to a local copy of the mesh of each process with the coordinates
+// in the original input units, so the solver mesh is never rescaled. Each call to Write
+// copies the registered fields into one of a pool of buffers, and the remaining work
+// (redimensionalization, high-order output refinement, compression, and disk I/O) is done
+// from the buffer. The writer owns its mesh, finite element collections, and spaces, and
+// its data collections use a duplicate of the mesh communicator. The output directories are
+// created on the calling thread before a snapshot is queued, so the background thread does
+// not make any MPI calls.
+//
+class FieldWriter
+{
+private:
+  // Local copy of the mesh and finite element collections and spaces, and grid functions
+  // registered with the data collections. These are only accessed by the thread writing the
+  // output.
+  MPI_Comm comm;
+  std::unique_ptr<mfem::FiniteElementCollection> nodes_fec;
+  std::unique_ptr<mfem::FiniteElementSpace> nodes_fespace;
+  std::unique_ptr<mfem::Mesh> mesh;
+  mfem::ParaViewDataCollection paraview, paraview_bdr;
+  struct FieldData
+  {
+    std::string name;
+    const mfem::ParGridFunction &gf;
+    std::unique_ptr<mfem::FiniteElementCollection> fec;
+    std::unique_ptr<mfem::FiniteElementSpace> fespace;
+    std::unique_ptr<mfem::GridFunction> out;
+
+    // Mapping from the degrees of freedom of the output grid function to the local degrees
+    // of freedom of the registered field, with weights including the orientation signs and
+    // scaling factor.
+    mfem::Array<int> map;
+    mfem::Vector weight;
+  };
+  std::vector<FieldData> fields;
+
+  // Pool of buffers for field snapshots, and queue of snapshots waiting to be written.
+  struct Snapshot
+  {
+    int step;
+    double time;
+    std::vector<mfem::Vector> data;
+  };
+  std::vector<Snapshot> buffers;
+  std::vector<int> free_buffers;
+  std::deque<int> queue;
+  int last_step;
+  double last_time;
+
+  // Background thread for asynchronous output and synchronization.
+  std::thread worker;
+  std::mutex mtx;
+  std::condition_variable cv;
+  bool stop;
+  std::exception_ptr error;
+
+  void Run();
+  void CreateDirectories(int step);
+  void WriteSnapshot(const Snapshot &snapshot);
+  void CheckError();
+
+public:
+  // Construct a writer for data collections with the given path, and path + "_boundary",
+  // with coordinates scaled by the characteristic length L₀. When async is false, Write
+  // writes the output before returning.
+  FieldWriter(const std::string &path, mfem::ParMesh &pmesh, double L0, int refine,
+              bool async, int num_buffers = 2);
+  ~FieldWriter();
+
+  // Register a field for output. The field is multiplied by the given scaling factor when
+  // written, for example to account for the redimensionalization of the mesh in the Piola
+  // transform for H(curl) or H(div) fields.
+  void RegisterField(const std::string &name, const mfem::ParGridFunction &gf,
+                     double scale = 1.0);
+
+  // Copy the current values of the registered fields and write them to disk for the given
+  // step and time, asynchronously if enabled. Blocks only if all buffers are in use.
+  void Write(int step, double time);
+
+  // Write piecewise constant fields, given by the values for each local element, at the
+  // step following the last written one, after all pending output has completed. The
+  // registered fields are not included in this output.
+  void WriteElementFields(double time, const std::map<std::string, mfem::Vector> &data);
+
+  // Block until all pending output has been written.
+  void Wait();
+
+  // Keep the existing entries of the collection files with times earlier than the first
+  // output, for continuing the output of a restarted simulation.
+  void UseRestartMode(bool restart)
+  {
+    paraview.UseRestartMode(restart);
+    paraview_bdr.UseRestartMode(restart);
+  }
+
+  int GetLastStep() const { return last_step; }
+  double GetLastTime() const { return last_time; }
+};
+
+}  // namespace palace
+
+#endif  // PALACE_UTILS_FIELD_WRITER_HPP
@@ -232,6 +232,12 @@ void IoData::CheckConfiguration()
   if (problem.type == config::ProblemData::Type::DRIVEN)
   {
     // No unsupported domain or boundary objects for frequency domain driven simulations.
+    if (solver.driven.freq_groups > 1 && solver.driven.adaptive_tol > 0.0)
+    {
+      Mpi::Warning("Adaptive frequency sweep does not support multiple frequency groups!\n"
+                   "Reverting to a single frequency group!\n");
+      solver.driven.freq_groups = 1;
+    }
   }
   else if (problem.type == config::ProblemData::Type::EIGENMODE)
   {
@@ -428,6 +434,15 @@ void IoData::CheckConfiguration()
          problem.type == config::ProblemData::Type::TRANSIENT);
   }
 
+  if (solver.linear.mg_single_precision && solver.pa_order_threshold <= 1)
+  {
+    // Every multigrid level finer than the coarsest has order at least 1, so none is fully
+    // assembled and there are no operators to store in single precision.
+    Mpi::Warning("config[\"Solver\"][\"Linear\"][\"MGSinglePrecision\"] has no effect "
+                 "unless config[\"Solver\"][\"PartialAssemblyOrder\"] > 1, since only "
+                 "fully assembled multigrid levels are stored in single precision!\n");
+  }
+
   // Configure settings for quadrature rules and partial assembly.
   BilinearForm::pa_order_threshold = solver.pa_order_threshold;
   fem::DefaultIntegrationOrder::p_trial = solver.order;
@@ -547,6 +562,7 @@ void IoData::NondimensionalizeInputs(mfem::ParMesh &mesh)
 
   // For eigenmode simulations:
   solver.eigenmode.target *= 2.0 * M_PI * tc;
+  solver.eigenmode.target_upper *= 2.0 * M_PI * tc;
 
   // For driven simulations:
   solver.driven.min_f *= 2.0 * M_PI * tc;
@@ -0,0 +1,107 @@
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+// SPDX-License-Identifier: Apache-2.0
+
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <mfem.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include "utils/checkpoint.hpp"
+
+namespace palace
+{
+
+namespace
+{
+
+mfem::Vector RandomVector(int n, int seed)
+{
+  mfem::Vector x(n);
+  x.Randomize(seed);
+  return x;
+}
+
+void CheckEqual(const mfem::Vector &x, const mfem::Vector &y)
+{
+  REQUIRE(x.Size() == y.Size());
+  const double *hx = x.HostRead(), *hy = y.HostRead();
+  for (int i = 0; i < x.Size(); i++)
+  {
+    CHECK(hx[i] == hy[i]);
+  }
+}
+
+}  // namespace
+
+TEST_CASE("Transient Checkpoint Round Trip", "[Checkpoint]")
+{
+  // The B-field has a different size than the E-field, as for Nédélec and Raviart-Thomas
+  // spaces on the same mesh.
+  const int n = 17, n_b = 11, n_elem = 5, n_state = 3;
+  checkpoint::TransientHeader header = {};
+  header.magic = 0x1234;
+  header.version = 3;
+  header.local_size = n;
+  header.b_size = n_b;
+  header.num_elem = n_elem;
+  header.step = 42;
+  header.num_state = n_state;
+  header.indicator_samples = 7;
+  header.num_outputs = 2;
+  header.delta_t = 0.1;
+  header.t = 4.2;
+  header.dt = 0.05;
+  header.E_max = 2.5;
+
+  mfem::Vector E = RandomVector(n, 1), dE = RandomVector(n, 2), B = RandomVector(n_b, 3);
+  std::vector<mfem::Vector> state;
+  std::vector<const mfem::Vector *> state_ptr;
+  for (int i = 0; i < n_state; i++)
+  {
+    state.push_back(RandomVector(n, 4 + i));
+  }
+  for (const auto &x : state)
+  {
+    state_ptr.push_back(&x);
+  }
+  mfem::Vector indicator = RandomVector(n_elem, 10);
+  std::map<std::string, std::int64_t> outputs = {{"domain-E.csv", 1024},
+                                                 {"probe-B.csv", 0}};
+
+  std::stringstream ss(std::ios::in | std::ios::out | std::ios::binary);
+  checkpoint::WriteTransient(ss, header, E, dE, B, state_ptr, indicator, outputs);
+
+  checkpoint::TransientHeader header_in = {};
+  checkpoint::ReadBinary(ss, &header_in, 1);
+  REQUIRE(ss.good());
+  CHECK(header_in.magic == header.magic);
+  CHECK(header_in.local_size == n);
+  CHECK(header_in.b_size == n_b);
+  CHECK(header_in.step == header.step);
+  CHECK(header_in.t == header.t);
+  CHECK(header_in.dt == header.dt);
+  CHECK(header_in.E_max == header.E_max);
+
+  checkpoint::TransientData data;
+  REQUIRE(checkpoint::ReadTransient(ss, header_in, data));
+  CheckEqual(data.E, E);
+  CheckEqual(data.dE, dE);
+  CheckEqual(data.B, B);
+  REQUIRE(data.state.size() == state.size());
+  for (int i = 0; i < n_state; i++)
+  {
+    CheckEqual(data.state[i], state[i]);
+  }
+  CheckEqual(data.indicator, indicator);
+  CHECK(data.outputs == outputs);
+
+  // A truncated checkpoint is detected by the missing trailing magic number.
+  const std::string bytes = ss.str();
+  std::stringstream truncated(bytes.substr(0, bytes.size() - sizeof(std::uint64_t)),
+                              std::ios::in | std::ios::binary);
+  checkpoint::ReadBinary(truncated, &header_in, 1);
+  CHECK_FALSE(checkpoint::ReadTransient(truncated, header_in, data));
+}
+
+}  // namespace palace
@@ -0,0 +1,275 @@
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+// SPDX-License-Identifier: Apache-2.0
+
+#include <algorithm>
+#include <cmath>
+#include <initializer_list>
+#include <memory>
+#include <vector>
+#include <mfem.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include "linalg/iterative.hpp"
+#include "linalg/jacobi.hpp"
+#include "linalg/vector.hpp"
+
+namespace palace
+{
+
+namespace
+{
+
+// Upwind finite difference discretization of -u'' + c u' on a uniform grid of the unit
+// interval with homogeneous Dirichlet boundary conditions, scaled by h², plus a shift s I.
+// The matrix is nonsymmetric for c ≠ 0.
+std::unique_ptr<mfem::SparseMatrix> ConvectionDiffusionMatrix(int n, double c, double s)
+{
+  const double h = 1.0 / (n + 1);
+  auto A = std::make_unique<mfem::SparseMatrix>(n, n);
+  for (int i = 0; i < n; i++)
+  {
+    A->Add(i, i, 2.0 + h * c + h * h * s);
+    if (i > 0)
+    {
+      A->Add(i, i - 1, -1.0 - h * c);
+    }
+    if (i < n - 1)
+    {
+      A->Add(i, i + 1, -1.0);
+    }
+  }
+  A->Finalize();
+  return A;
+}
+
+// Standard finite difference discretization of -u'' on a uniform grid of the unit square
+// with homogeneous Dirichlet boundary conditions, which is SPD.
+std::unique_ptr<mfem::SparseMatrix> LaplacianMatrix(int n)
+{
+  auto A = std::make_unique<mfem::SparseMatrix>(n * n, n * n);
+  for (int j = 0; j < n; j++)
+  {
+    for (int i = 0; i < n; i++)
+    {
+      const int k = j * n + i;
+      A->Add(k, k, 4.0);
+      if (i > 0)
+      {
+        A->Add(k, k - 1, -1.0);
+      }
+      if (i < n - 1)
+      {
+        A->Add(k, k + 1, -1.0);
+      }
+      if (j > 0)
+      {
+        A->Add(k, k - n, -1.0);
+      }
+      if (j < n - 1)
+      {
+        A->Add(k, k + n, -1.0);
+      }
+    }
+  }
+  A->Finalize();
+  return A;
+}
+
+double RelativeResidual(const mfem::SparseMatrix &A, const Vector &b, const Vector &x)
+{
+  Vector r(b.Size());
+  A.Mult(x, r);
+  r -= b;
+  return linalg::Norml2(MPI_COMM_SELF, r) / linalg::Norml2(MPI_COMM_SELF, b);
+}
+
+// GMRES solver with access to the Krylov basis of the last Arnoldi cycle.
+class TestGmresSolver : public GmresSolver<Operator>
+{
+public:
+  using GmresSolver<Operator>::GmresSolver;
+  using GmresSolver<Operator>::V;
+};
+
+}  // namespace
+
+TEST_CASE("GMRES Solver DCGS2 Orthogonalization", "[IterativeSolver]")
+{
+  // With DCGS2 orthogonalization, the Arnoldi basis is orthonormal to near machine
+  // precision, and the solver converges in the same number of iterations as with modified
+  // Gram-Schmidt. The restart dimension is large enough that there is a single cycle, whose
+  // basis V[0], ..., V[it] is checked after the solve. Modified Gram-Schmidt is not
+  // checked, since its loss of orthogonality grows as the residual decreases.
+  constexpr int n = 100;
+  constexpr double tol = 1.0e-10;
+  const auto A = ConvectionDiffusionMatrix(n, 10.0, 0.0);
+  Vector b(n);
+  b.Randomize(1);
+  std::vector<int> its;
+  for (auto type : {GmresSolverBase::OrthogType::MGS, GmresSolverBase::OrthogType::DCGS2})
+  {
+    TestGmresSolver gmres(MPI_COMM_SELF, 0);
+    gmres.SetRelTol(tol);
+    gmres.SetMaxIter(2 * n);
+    gmres.SetRestartDim(2 * n);
+    gmres.SetOrthogonalization(type);
+    gmres.SetOperator(*A);
+    Vector x(n);
+    x = 0.0;
+    gmres.Mult(b, x);
+    CHECK(gmres.GetConverged());
+    CHECK(RelativeResidual(*A, b, x) < 10.0 * tol);
+    its.push_back(gmres.GetNumIterations());
+    if (type != GmresSolverBase::OrthogType::DCGS2)
+    {
+      continue;
+    }
+
+    const int m = gmres.GetNumIterations() + 1;
+    double err = 0.0;
+    for (int i = 0; i < m; i++)
+    {
+      for (int k = 0; k < m; k++)
+      {
+        const double dot = linalg::Dot(MPI_COMM_SELF, gmres.V[i], gmres.V[k]);
+        err = std::max(err, std::abs(dot - ((i == k) ? 1.0 : 0.0)));
+      }
+    }
+    CHECK(err < 1.0e-12);
+  }
+  CHECK(std::abs(its[1] - its[0]) <= 1);
+}
+
+TEST_CASE("GCRO-DR Solver", "[IterativeSolver]")
+{
+  // Solve a sequence of slowly varying nonsymmetric systems with different right-hand
+  // sides, with and without a recycled subspace. Each solve converges, and recycling the
+  // subspace from the previous solves reduces the number of iterations for the later
+  // systems.
+  constexpr int n = 100, n_sys = 4, restart = 20, recycle = 8;
+  constexpr double tol = 1.0e-8;
+  std::vector<std::unique_ptr<mfem::SparseMatrix>> A;
+  for (int k = 0; k < n_sys; k++)
+  {
+    A.push_back(ConvectionDiffusionMatrix(n, 10.0, 0.5 * k));
+  }
+  auto SolveSequence = [&](int recycle_dim)
+  {
+    GcroDrSolver<Operator> ksp(MPI_COMM_SELF, 0);
+    ksp.SetRelTol(tol);
+    ksp.SetMaxIter(10000);
+    ksp.SetRestartDim(restart);
+    ksp.SetRecycleDim(recycle_dim);
+    std::vector<int> its;
+    for (int k = 0; k < n_sys; k++)
+    {
+      Vector b(n), x(n);
+      b.Randomize(k + 1);
+      x = 0.0;
+      ksp.SetOperator(*A[k]);
+      ksp.Mult(b, x);
+      CHECK(ksp.GetConverged());
+      CHECK(RelativeResidual(*A[k], b, x) < 10.0 * tol);
+      its.push_back(ksp.GetNumIterations());
+    }
+    return its;
+  };
+  const auto its_ref = SolveSequence(0);
+  const auto its = SolveSequence(recycle);
+  for (int k = 1; k < n_sys; k++)
+  {
+    CHECK(its[k] < its_ref[k]);
+  }
+}
+
+TEST_CASE("Pipelined CG Solver", "[IterativeSolver]")
+{
+  // The pipelined CG method is mathematically equivalent to standard CG, so for an SPD
+  // system both converge in nearly the same number of iterations to the same solution, up
+  // to the effect of rounding errors on the recurrences. Both are tested with and without
+  // a (Jacobi) preconditioner.
+  constexpr int n = 32;
+  constexpr double tol = 1.0e-8;
+  const auto A = LaplacianMatrix(n);
+  JacobiSmoother<Operator> jacobi(MPI_COMM_SELF);
+  jacobi.SetOperator(*A);
+  Vector b(A->Height());
+  b.Randomize(1);
+  for (bool precond : {false, true})
+  {
+    CgSolver<Operator> cg(MPI_COMM_SELF, 0);
+    PipelinedCgSolver<Operator> pcg(MPI_COMM_SELF, 0);
+    Vector x_cg(A->Width()), x_pcg(A->Width());
+    x_cg = 0.0;
+    x_pcg = 0.0;
+    for (auto *ksp : std::initializer_list<IterativeSolver<Operator> *>{&cg, &pcg})
+    {
+      ksp->SetRelTol(tol);
+      ksp->SetMaxIter(1000);
+      ksp->SetOperator(*A);
+      if (precond)
+      {
+        ksp->SetPreconditioner(jacobi);
+      }
+    }
+    cg.Mult(b, x_cg);
+    pcg.Mult(b, x_pcg);
+    CHECK(cg.GetConverged());
+    CHECK(pcg.GetConverged());
+    CHECK(RelativeResidual(*A, b, x_pcg) < 10.0 * tol);
+    CHECK(std::abs(pcg.GetNumIterations() - cg.GetNumIterations()) <= 2);
+
+    x_pcg -= x_cg;
+    CHECK(linalg::Norml2(MPI_COMM_SELF, x_pcg) <
+          1.0e-5 * linalg::Norml2(MPI_COMM_SELF, x_cg));
+  }
+}
+
+TEST_CASE("Block CG Solver", "[IterativeSolver]")
+{
+  // Solving for several right-hand sides at once with block CG gives the same solutions as
+  // separate single right-hand side solves, with the true residual of each meeting the
+  // tolerance. The block includes a right-hand side which is a linear combination of the
+  // others, for which the search directions become linearly dependent.
+  constexpr int n = 32, m = 4;
+  constexpr double tol = 1.0e-8;
+  const auto A = LaplacianMatrix(n);
+  JacobiSmoother<Operator> jacobi(MPI_COMM_SELF);
+  jacobi.SetOperator(*A);
+  std::vector<Vector> b(m), x(m), x_ref(m);
+  for (int j = 0; j < m; j++)
+  {
+    b[j].SetSize(A->Height());
+    x[j].SetSize(A->Width());
+    x_ref[j].SetSize(A->Width());
+    if (j < m - 1)
+    {
+      b[j].Randomize(j + 1);
+    }
+  }
+  b[m - 1] = b[0];
+  b[m - 1].Add(2.0, b[1]);
+  CgSolver<Operator> cg(MPI_COMM_SELF, 0);
+  cg.SetRelTol(tol);
+  cg.SetMaxIter(1000);
+  cg.SetOperator(*A);
+  cg.SetPreconditioner(jacobi);
+  int max_it = 0;
+  for (int j = 0; j < m; j++)
+  {
+    x_ref[j] = 0.0;
+    cg.Mult(b[j], x_ref[j]);
+    max_it = std::max(max_it, cg.GetNumIterations());
+  }
+  cg.Mult(b, x);
+  CHECK(cg.GetConverged());
+  CHECK(cg.GetNumIterations() <= max_it);
+  for (int j = 0; j < m; j++)
+  {
+    CHECK(RelativeResidual(*A, b[j], x[j]) < 10.0 * tol);
+    x[j] -= x_ref[j];
+    CHECK(linalg::Norml2(MPI_COMM_SELF, x[j]) <
+          1.0e-5 * linalg::Norml2(MPI_COMM_SELF, x_ref[j]));
+  }
+}
+
+}  // namespace palace
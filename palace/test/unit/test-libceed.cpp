@@ -1,6 +1,7 @@
 // Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
 // SPDX-License-Identifier: Apache-2.0
 
+#include <algorithm>
 #include <memory>
 #include <sstream>
 #include <string>
@@ -11,6 +12,8 @@
 #include "fem/bilinearform.hpp"
 #include "fem/fespace.hpp"
 #include "fem/integrator.hpp"
+#include "fem/libceed/basis.hpp"
+#include "fem/libceed/ceed.hpp"
 #include "fem/mesh.hpp"
 #include "linalg/hypre.hpp"
 #include "models/materialoperator.hpp"
@@ -1188,6 +1191,84 @@ void RunCeedInterpolatorTests(MPI_Comm comm, const std::string &input, int ref_l
   }
 }
 
+void RunCeedTensorVectorBasisTests(const mfem::FiniteElement &fe, int ne)
+{
+  // Compare the basis constructed by ceed::InitBasis, which applies H(curl) and H(div)
+  // bases on hexahedra with sum factorization for CPU backends, against the dense libCEED
+  // basis built from the same element matrices.
+  Ceed ceed = ceed::internal::GetCeedObjects()[0];
+  const mfem::IntegrationRule &ir =
+      mfem::IntRules.Get(mfem::Geometry::CUBE, 2 * fe.GetOrder() + 1);
+  const mfem::DofToQuad &maps = fe.GetDofToQuad(ir, mfem::DofToQuad::FULL);
+  const bool curl = (fe.GetMapType() == mfem::FiniteElement::H_CURL);
+  const int P = maps.ndof, Q = maps.nqpt;
+  CeedBasis basis_test, basis_ref;
+  ceed::InitBasis(fe, ir, 1, ceed, &basis_test);
+  {
+    mfem::DenseMatrix qX(3, Q);
+    mfem::Vector qW(Q);
+    for (int i = 0; i < Q; i++)
+    {
+      const mfem::IntegrationPoint &ip = ir.IntPoint(i);
+      qX(0, i) = ip.x;
+      qX(1, i) = ip.y;
+      qX(2, i) = ip.z;
+      qW(i) = ip.weight;
+    }
+    if (curl)
+    {
+      PalaceCeedCall(ceed, CeedBasisCreateHcurl(ceed, CEED_TOPOLOGY_HEX, 1, P, Q,
+                                                maps.Bt.GetData(), maps.Gt.GetData(),
+                                                qX.GetData(), qW.GetData(), &basis_ref));
+    }
+    else
+    {
+      PalaceCeedCall(ceed, CeedBasisCreateHdiv(ceed, CEED_TOPOLOGY_HEX, 1, P, Q,
+                                               maps.Bt.GetData(), maps.Gt.GetData(),
+                                               qX.GetData(), qW.GetData(), &basis_ref));
+    }
+  }
+
+  auto Apply = [&](CeedBasis basis, CeedTransposeMode t_mode, CeedEvalMode eval_mode,
+                   const mfem::Vector &x, int y_size)
+  {
+    CeedVector u, v;
+    PalaceCeedCall(ceed, CeedVectorCreate(ceed, x.Size(), &u));
+    PalaceCeedCall(ceed, CeedVectorCreate(ceed, y_size, &v));
+    PalaceCeedCall(ceed, CeedVectorSetArray(u, CEED_MEM_HOST, CEED_COPY_VALUES,
+                                            const_cast<double *>(x.HostRead())));
+    PalaceCeedCall(ceed, CeedBasisApply(basis, ne, t_mode, eval_mode, u, v));
+    mfem::Vector y(y_size);
+    const CeedScalar *v_array;
+    PalaceCeedCall(ceed, CeedVectorGetArrayRead(v, CEED_MEM_HOST, &v_array));
+    std::copy(v_array, v_array + y_size, y.HostWrite());
+    PalaceCeedCall(ceed, CeedVectorRestoreArrayRead(v, &v_array));
+    PalaceCeedCall(ceed, CeedVectorDestroy(&u));
+    PalaceCeedCall(ceed, CeedVectorDestroy(&v));
+    return y;
+  };
+  for (const auto eval_mode : {CEED_EVAL_INTERP, curl ? CEED_EVAL_CURL : CEED_EVAL_DIV})
+  {
+    const int q_size = ((eval_mode == CEED_EVAL_DIV) ? 1 : 3) * Q * ne;
+    for (const auto t_mode : {CEED_NOTRANSPOSE, CEED_TRANSPOSE})
+    {
+      const bool transpose = (t_mode == CEED_TRANSPOSE);
+      mfem::Vector x(transpose ? q_size : P * ne);
+      x.Randomize(1);
+      const mfem::Vector y_ref =
+          Apply(basis_ref, t_mode, eval_mode, x, transpose ? P * ne : q_size);
+      mfem::Vector y_test = Apply(basis_test, t_mode, eval_mode, x, y_ref.Size());
+      y_test -= y_ref;
+
+      REQUIRE(y_ref * y_ref > 0.0);
+      REQUIRE(y_test * y_test < 1.0e-12 * std::max(y_ref * y_ref, 1.0));
+    }
+  }
+
+  PalaceCeedCall(ceed, CeedBasisDestroy(&basis_test));
+  PalaceCeedCall(ceed, CeedBasisDestroy(&basis_ref));
+}
+
 void RunCeedBenchmarks(MPI_Comm comm, const std::string &input, int ref_levels, bool amr,
                        int order)
 {
@@ -1442,6 +1523,14 @@ TEST_CASE("3D libCEED Interpolators", "[libCEED][Interpolator]")
                            amr, order);
 }
 
+TEST_CASE("3D libCEED Tensor Vector Bases", "[libCEED][Basis]")
+{
+  auto order = GENERATE(1, 2, 3);
+  auto ne = GENERATE(1, 5);
+  RunCeedTensorVectorBasisTests(mfem::ND_HexahedronElement(order), ne);
+  RunCeedTensorVectorBasisTests(mfem::RT_HexahedronElement(order - 1), ne);
+}
+
 TEST_CASE("3D libCEED Benchmarks", "[libCEED][Benchmark]")
 {
   auto mesh = GENERATE("fichera-hex.mesh", "fichera-tet.mesh");
@@ -0,0 +1,68 @@
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+// SPDX-License-Identifier: Apache-2.0
+
+#include <cmath>
+#include <memory>
+#include <string>
+#include <mfem.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include "linalg/hypre.hpp"
+#include "utils/communication.hpp"
+
+namespace palace
+{
+
+namespace
+{
+
+double LumpedEnergyError(MPI_Comm comm, const std::string &input)
+{
+  // Relative error in the energy xᵀ D x of a constant field with the lumped mass matrix D
+  // compared to the energy xᵀ M x with the consistent mass matrix M, for the lowest order
+  // Nédélec space.
+  mfem::Mesh smesh(input, 1, 1);
+  REQUIRE(Mpi::Size(comm) <= smesh.GetNE());
+  mfem::ParMesh mesh(comm, smesh);
+  mfem::ND_FECollection fec(1, mesh.Dimension());
+  mfem::ParFiniteElementSpace fespace(&mesh, &fec);
+  mfem::ParBilinearForm m(&fespace);
+  m.AddDomainIntegrator(new mfem::VectorFEMassIntegrator);
+  m.Assemble();
+  m.Finalize();
+  std::unique_ptr<mfem::HypreParMatrix> M(m.ParallelAssemble());
+  const Vector d = hypre::GetAbsRowSums(*M);
+
+  mfem::Vector E0(mesh.SpaceDimension());
+  for (int i = 0; i < E0.Size(); i++)
+  {
+    E0(i) = 1.0 + i;
+  }
+  mfem::VectorConstantCoefficient coeff(E0);
+  mfem::ParGridFunction gf(&fespace);
+  gf.ProjectCoefficient(coeff);
+  Vector x(fespace.GetTrueVSize()), Mx(fespace.GetTrueVSize()), Dx;
+  gf.GetTrueDofs(x);
+  M->Mult(x, Mx);
+  Dx = x;
+  Dx *= d;
+  const double energy_M = mfem::InnerProduct(comm, x, Mx);
+  const double energy_D = mfem::InnerProduct(comm, x, Dx);
+  REQUIRE(energy_M > 0.0);
+  return (energy_D - energy_M) / energy_M;
+}
+
+}  // namespace
+
+TEST_CASE("Mass Lumping Consistency", "[Lumping]")
+{
+  // The lumped mass matrix reproduces the energy of a constant field exactly for lowest
+  // order elements on a hexahedral mesh, but not on a tetrahedral mesh, where it
+  // overestimates the energy.
+  const std::string mesh_dir(PALACE_TEST_MESH_DIR "/");
+  const double err_hex = LumpedEnergyError(MPI_COMM_WORLD, mesh_dir + "fichera-hex.mesh");
+  const double err_tet = LumpedEnergyError(MPI_COMM_WORLD, mesh_dir + "fichera-tet.mesh");
+  CHECK(std::abs(err_hex) < 1.0e-12);
+  CHECK(err_tet > 1.0e-2);
+}
+
+}  // namespace palace
@@ -0,0 +1,114 @@
+// Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+// SPDX-License-Identifier: Apache-2.0
+
+#include <cmath>
+#include <complex>
+#include <vector>
+#include <mfem.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include "linalg/vector.hpp"
+#include "models/waveportoperator.hpp"
+
+namespace palace
+{
+
+using namespace std::complex_literals;
+
+namespace
+{
+
+// Synthetic boundary mode with kₙ² linear in ω², as for a homogeneously filled port, and a
+// fixed mode shape with a frequency-dependent phase. Interpolation of this mode in ω² is
+// exact up to the phase, which is removed by the cache.
+struct TestMode
+{
+  ComplexVector e_ref;
+
+  TestMode(int n)
+  {
+    mfem::Vector er(n), ei(n);
+    er.Randomize(1);
+    ei.Randomize(2);
+    e_ref = ComplexVector(er, ei);
+    linalg::Normalize(MPI_COMM_SELF, e_ref);
+  }
+
+  std::complex<double> kn(double omega) const { return std::sqrt(omega * omega - 1.0); }
+
+  ComplexVector e(double omega) const
+  {
+    ComplexVector x(e_ref);
+    x *= std::exp(3.0i * omega);
+    return x;
+  }
+};
+
+// Compute the mode at the given frequency the same way as WavePortData, returning the
+// number of eigenvalue problem solves.
+int Solve(WavePortModeCache &cache, const TestMode &mode, double omega,
+          std::vector<double> &solves)
+{
+  int num_solve = 0;
+  double omega_solve = 0.0;
+  while (omega != omega_solve)
+  {
+    omega_solve = cache.GetSolveFrequency(omega);
+    if (omega_solve == 0.0)
+    {
+      break;
+    }
+    cache.Insert(omega_solve, mode.kn(omega_solve), mode.e(omega_solve));
+    solves.push_back(omega_solve);
+    num_solve++;
+  }
+  return num_solve;
+}
+
+}  // namespace
+
+TEST_CASE("Wave Port Mode Cache Interpolation", "[WavePort]")
+{
+  const TestMode mode(24);
+  WavePortModeCache cache(MPI_COMM_SELF, 1.0e-6);
+  cache.SetFrequencyRange(2.0, 4.0);
+
+  // The first request seeds the anchors at the ends of the range and verifies the
+  // interpolation error at the midpoint, without solving at the requested frequency.
+  std::vector<double> solves;
+  const double omega = 2.7;
+  CHECK(Solve(cache, mode, omega, solves) == 3);
+  CHECK(solves == std::vector<double>{2.0, 4.0, 3.0});
+  CHECK(cache.GetSolveFrequency(omega) == 0.0);
+
+  ComplexVector e(mode.e_ref.Size());
+  const auto kn = cache.GetMode(omega, e);
+  CHECK(std::abs(kn - mode.kn(omega)) < 1.0e-12 * std::abs(mode.kn(omega)));
+  CHECK(std::abs(std::abs(linalg::Dot(MPI_COMM_SELF, e, mode.e_ref)) - 1.0) < 1.0e-12);
+
+  // An ascending sweep over the range requires no more solves.
+  for (int i = 0; i <= 20; i++)
+  {
+    CHECK(Solve(cache, mode, 2.0 + 0.1 * i, solves) == 0);
+  }
+  CHECK(cache.Size() == 3);
+}
+
+TEST_CASE("Wave Port Mode Cache Size Limit", "[WavePort]")
+{
+  // With a tolerance which is never met, every request bisects down to the minimum
+  // interval width. The number of anchors stays bounded and the ends of the range are
+  // kept.
+  const TestMode mode(8);
+  WavePortModeCache cache(MPI_COMM_SELF, 1.0e-300);
+  cache.SetFrequencyRange(2.0, 4.0);
+  std::vector<double> solves;
+  for (int i = 0; i <= 40; i++)
+  {
+    Solve(cache, mode, 2.0 + 0.05 * i, solves);
+    CHECK(cache.Size() <= WavePortModeCache::max_size);
+    CHECK(cache.GetSolveFrequency(2.0) == 0.0);
+    CHECK(cache.GetSolveFrequency(4.0) == 0.0);
+  }
+}
+
+}  // namespace palace